@@ -67,18 +67,18 @@ PYBIND11_MODULE(chronograph, m) {
 
     // --- Algorithms (free functions) ---
     auto alg = m.def_submodule("algorithms", "Graph algorithms");
-    alg.def("is_reachable", &graph::algorithms::isReachable,
+    alg.def("is_reachable", &graph::algorithms::isReachable<Graph>,
           py::arg("g"), py::arg("start"), py::arg("target"));
-    alg.def("shortest_path", &graph::algorithms::shortestPath,
+    alg.def("shortest_path", &graph::algorithms::shortestPath<Graph>,
           py::arg("g"), py::arg("start"), py::arg("target"));
     alg.def("is_reachable_at", &graph::algorithms::isReachableAt,
           py::arg("g"), py::arg("start"), py::arg("target"), py::arg("timestamp"));
-    alg.def("is_time_respecting_reachable", &graph::algorithms::isTimeRespectingReachable,
+    alg.def("is_time_respecting_reachable", &graph::algorithms::isTimeRespectingReachable<Graph>,
           py::arg("g"), py::arg("start"), py::arg("target"));
-    alg.def("weakly_connected_components", &graph::algorithms::weaklyConnectedComponents);
-    alg.def("strongly_connected_components", &graph::algorithms::stronglyConnectedComponents);
-    alg.def("has_cycle", &graph::algorithms::hasCycle);
-    alg.def("topological_sort", &graph::algorithms::topologicalSort);
+    alg.def("weakly_connected_components", &graph::algorithms::weaklyConnectedComponents<Graph>);
+    alg.def("strongly_connected_components", &graph::algorithms::stronglyConnectedComponents<Graph>);
+    alg.def("has_cycle", &graph::algorithms::hasCycle<Graph>);
+    alg.def("topological_sort", &graph::algorithms::topologicalSort<Graph>);
 
     // --- Repository ---
 
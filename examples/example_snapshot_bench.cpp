@@ -0,0 +1,88 @@
+// examples/example_snapshot_bench.cpp
+//
+// Times Snapshot(graph, t) against Snapshot(graph, t, threads) on a
+// synthetic log without checkpoints, so every snapshot replays all of it.
+//
+//   example_snapshot_bench [events (default 2000000)] [max threads (default: cores)]
+
+#include <chronograph/graph/Graph.h>
+#include <chronograph/graph/Snapshot.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace chronograph;
+
+namespace {
+// node adds and updates, edge adds and updates over fresh edge IDs, and
+// node deletes whose cascades are left to the snapshot
+std::vector<Event> makeLog(std::size_t count) {
+    std::mt19937 rng(42);
+    const std::size_t nodes = std::max<std::size_t>(count / 20, 1);
+    auto node = [&] { return "n" + std::to_string(rng() % nodes); };
+    std::vector<Event> log;
+    log.reserve(count);
+    std::size_t edges = 0;
+    for (std::int64_t ts = 0; log.size() < count; ++ts) {
+        const auto op = rng() % 100;
+        Event e{"ev" + std::to_string(ts), ts, EventType::ADD_NODE, node(),
+                {{"v", std::to_string(rng() % 100)}}, "", ""};
+        if (op < 30) {
+            // ADD_NODE
+        } else if (op < 65) {
+            e.type = EventType::ADD_EDGE;
+            e.entityId = "e" + std::to_string(edges++);
+            e.from = node();
+            e.to = node();
+        } else if (op < 70) {
+            e.type = EventType::DEL_NODE;
+            e.payload.clear();
+        } else if (op < 90) {
+            e.type = EventType::UPDATE_NODE;
+        } else if (edges > 0) {
+            e.type = EventType::UPDATE_EDGE;
+            e.entityId = "e" + std::to_string(rng() % edges);
+        }
+        log.push_back(std::move(e));
+    }
+    return log;
+}
+
+template <typename F>
+double bestSeconds(F&& build) {
+    double best = 1e300;
+    for (int run = 0; run < 3; ++run) {
+        const auto t0 = std::chrono::steady_clock::now();
+        build();
+        const std::chrono::duration<double> d = std::chrono::steady_clock::now() - t0;
+        best = std::min(best, d.count());
+    }
+    return best;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t events = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+    const std::size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t maxThreads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : cores;
+
+    Graph g;
+    g.replayEvents(EventChunk(makeLog(events)));
+    const std::int64_t t = g.getEventLog().back().timestamp;
+    std::printf("%zu events, %zu cores\n", g.getEventLog().size(), cores);
+
+    std::size_t edges = 0;
+    const double sequential = bestSeconds([&] { edges = Snapshot(g, t).getEdges().size(); });
+    std::printf("sequential   %8.3f s  (%zu edges)\n", sequential, edges);
+    for (std::size_t threads = 1; threads <= maxThreads; threads *= 2) {
+        const double s = bestSeconds([&] { edges = Snapshot(g, t, threads).getEdges().size(); });
+        std::printf("%2zu threads   %8.3f s  x%.2f  (%zu edges)\n",
+                    threads, s, sequential / s, edges);
+    }
+    return 0;
+}
@@ -0,0 +1,32 @@
+// include/chronograph/graph/Compression.h
+#pragma once
+
+#include <chronograph/graph/Event.h>
+#include <chronograph/graph/EventLog.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace chronograph {
+
+/// Fast LZ77 block compressor
+// * LZ4-style sequences: a token byte (literal length | match length - 4),
+//   the literals, a u16 match offset; lengths >= 15 continue in 255-bytes
+// * 64 KiB window, one hash probe per position, no entropy stage: it trades
+//   ratio for speed, decompression is a copy loop
+// * output starts with the uncompressed size as a varint
+// * lzDecompress throws std::runtime_error on malformed input, including a
+//   declared size above 255 bytes per input byte (checked before allocating)
+std::string lzCompress(const char* data, std::size_t len);
+std::string lzDecompress(const char* data, std::size_t len);
+
+/// Compact encoding of a run of events for storage
+// * every distinct string (IDs, keys, values, endpoints) goes into a sorted,
+//   front-coded dictionary and events refer to it by number; timestamps
+//   and entity numbers are stored as deltas from the previous event
+// * the result is then compressed with lzCompress
+// * decompressEvents throws std::runtime_error on malformed input
+std::string compressEvents(const EventChunk& events);
+std::vector<Event> decompressEvents(const char* data, std::size_t len);
+
+}  // namespace chronograph
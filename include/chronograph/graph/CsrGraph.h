@@ -0,0 +1,112 @@
+// include/chronograph/graph/CsrGraph.h
+#pragma once
+
+#include <chronograph/graph/GraphView.h>
+#include <chronograph/graph/Node.h>
+#include <chronograph/graph/Edge.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace chronograph {
+
+/// Frozen, compressed-sparse-row copy of a graph state
+// * built once from a Graph or Snapshot, never mutated afterwards
+// * adjacency is stored as contiguous edge-index ranges per node row
+// * dangling edge endpoints (IDs with no node) get a row but no Node
+class CsrGraph {
+public:
+    static constexpr std::uint32_t npos = static_cast<std::uint32_t>(-1);
+
+    /// Freeze the current state of `g` (explicitly instantiated for Graph and Snapshot)
+    template <typename G>
+    explicit CsrGraph(const G& g);
+
+    // Row lookup
+    std::uint32_t rowOf(const std::string& id) const {
+        auto it = rowIndex_.find(id);
+        return it == rowIndex_.end() ? npos : it->second;
+    }
+    std::size_t rowCount() const { return rowIds_.size(); }
+    const std::string& rowId(std::uint32_t row) const { return rowIds_[row]; }
+    const Node* rowNode(std::uint32_t row) const {
+        return rowNode_[row] == npos ? nullptr : &nodes_[rowNode_[row]];
+    }
+
+    // Node / edge access
+    const Node* findNode(const std::string& id) const {
+        std::uint32_t row = rowOf(id);
+        return row == npos ? nullptr : rowNode(row);
+    }
+    const Edge* findEdge(const std::string& id) const {
+        auto it = edgeIndex_.find(id);
+        return it == edgeIndex_.end() ? nullptr : &edges_[it->second];
+    }
+    const std::vector<Node>& nodes() const { return nodes_; }
+    const std::vector<Edge>& edges() const { return edges_; }
+
+    // Adjacency by row: f(const Edge&)
+    template <typename F>
+    void forEachOutEdge(std::uint32_t row, F&& f) const {
+        for (std::uint32_t i = outOffsets_[row]; i < outOffsets_[row + 1]; ++i) {
+            f(edges_[outEdges_[i]]);
+        }
+    }
+    template <typename F>
+    void forEachInEdge(std::uint32_t row, F&& f) const {
+        for (std::uint32_t i = inOffsets_[row]; i < inOffsets_[row + 1]; ++i) {
+            f(edges_[inEdges_[i]]);
+        }
+    }
+
+private:
+    std::vector<Node> nodes_;
+    std::vector<Edge> edges_;
+    std::unordered_map<std::string, std::uint32_t> edgeIndex_;
+
+    // One row per node ID (and per dangling endpoint), in source node order
+    std::vector<std::string> rowIds_;
+    std::vector<std::uint32_t> rowNode_;     // row -> index in nodes_, or npos
+    std::unordered_map<std::string, std::uint32_t> rowIndex_;
+
+    // CSR arrays: edges of row r are [offsets[r], offsets[r+1])
+    std::vector<std::uint32_t> outOffsets_, outEdges_;
+    std::vector<std::uint32_t> inOffsets_,  inEdges_;
+
+    std::uint32_t addRow(const std::string& id);
+};
+
+template <>
+struct GraphViewTraits<CsrGraph> {
+    static const Node* findNode(const CsrGraph& g, const std::string& id) {
+        return g.findNode(id);
+    }
+    static const Edge* findEdge(const CsrGraph& g, const std::string& id) {
+        return g.findEdge(id);
+    }
+    static std::size_t nodeCount(const CsrGraph& g) {
+        return g.nodes().size();
+    }
+    template <typename F>
+    static void forEachNode(const CsrGraph& g, F&& f) {
+        for (const auto& node : g.nodes()) f(node);
+    }
+    template <typename F>
+    static void forEachEdge(const CsrGraph& g, F&& f) {
+        for (const auto& edge : g.edges()) f(edge);
+    }
+    template <typename F>
+    static void forEachOutEdge(const CsrGraph& g, const std::string& u, F&& f) {
+        std::uint32_t row = g.rowOf(u);
+        if (row != CsrGraph::npos) g.forEachOutEdge(row, f);
+    }
+    template <typename F>
+    static void forEachInEdge(const CsrGraph& g, const std::string& u, F&& f) {
+        std::uint32_t row = g.rowOf(u);
+        if (row != CsrGraph::npos) g.forEachInEdge(row, f);
+    }
+};
+
+}  // namespace chronograph
@@ -0,0 +1,39 @@
+// include/chronograph/graph/EventCodec.h
+#pragma once
+
+#include <chronograph/graph/Event.h>
+#include <cstdint>
+#include <string>
+
+namespace chronograph {
+
+/// Canonical binary encoding of events
+// * little-endian fixed-width integers; strings as a u32 length + bytes;
+//   payload entries in key order (as std::map keeps them)
+// * equal events always encode to equal bytes on every platform, so the
+//   encoding can be hashed or written to disk
+// * encoders append to `out`; decoders read from [pos, end), advance `pos`
+//   and throw std::runtime_error on truncated or malformed input
+
+void putU32(std::string& out, std::uint32_t v);
+void putU64(std::string& out, std::uint64_t v);
+void putString(std::string& out, const std::string& s);
+/// LEB128: 7 bits per byte, low bits first
+void putVarint(std::string& out, std::uint64_t v);
+void encodeEvent(const Event& e, std::string& out);
+
+std::uint32_t getU32(const char*& pos, const char* end);
+std::uint64_t getU64(const char*& pos, const char* end);
+std::string getString(const char*& pos, const char* end);
+std::uint64_t getVarint(const char*& pos, const char* end);
+Event decodeEvent(const char*& pos, const char* end);
+
+/// Map signed to unsigned so small magnitudes stay small varints
+inline std::uint64_t zigzagEncode(std::int64_t v) {
+    return (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63);
+}
+inline std::int64_t zigzagDecode(std::uint64_t v) {
+    return static_cast<std::int64_t>(v >> 1) ^ -static_cast<std::int64_t>(v & 1);
+}
+
+}  // namespace chronograph
@@ -0,0 +1,159 @@
+// include/chronograph/graph/EventLog.h
+#pragma once
+
+#include <chronograph/graph/Event.h>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace chronograph {
+
+/// Immutable, reference-counted run of events
+// * copies share the same storage; slice() views part of it without copying
+// * commits and the working log hold chunks, so each event is stored once
+class EventChunk {
+public:
+    using value_type     = Event;
+    using size_type      = std::size_t;
+    using const_iterator = const Event*;
+    using iterator       = const_iterator;
+
+    EventChunk() = default;
+    /// Take ownership of `events`
+    EventChunk(std::vector<Event> events)
+        : storage_(std::make_shared<const std::vector<Event>>(std::move(events))),
+          begin_(storage_->data()),
+          end_(storage_->data() + storage_->size()) {}
+
+    /// Events [from, to) of this chunk, sharing its storage
+    EventChunk slice(size_type from, size_type to) const {
+        EventChunk out;
+        if (from >= to) return out;
+        out.storage_ = storage_;
+        out.begin_ = begin_ + from;
+        out.end_ = begin_ + to;
+        return out;
+    }
+
+    size_type size() const { return static_cast<size_type>(end_ - begin_); }
+    bool empty() const { return begin_ == end_; }
+    const_iterator begin() const { return begin_; }
+    const_iterator end() const { return end_; }
+    const Event& operator[](size_type i) const { return begin_[i]; }
+    const Event& front() const { return *begin_; }
+    const Event& back() const { return *(end_ - 1); }
+
+    /// True if both chunks view the same underlying storage
+    bool sharesStorageWith(const EventChunk& other) const {
+        return storage_ && storage_ == other.storage_;
+    }
+    /// True if no other chunk views this one's storage
+    bool ownsStorage() const { return storage_ && storage_.use_count() == 1; }
+
+private:
+    std::shared_ptr<const std::vector<Event>> storage_;
+    const Event* begin_ = nullptr;
+    const Event* end_ = nullptr;
+};
+
+/// Append-only event history of a Graph
+// * a sequence of sealed EventChunks followed by a mutable tail
+// * push_back() appends to the tail; append() shares an existing chunk;
+//   seal() turns the tail into a chunk so it can be shared in turn
+// * indexing locates the chunk by binary search, iteration walks chunk by chunk
+class EventLog {
+public:
+    class const_iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = Event;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const Event*;
+        using reference         = const Event&;
+
+        const_iterator() = default;
+
+        reference operator*() const { return *cur_; }
+        pointer operator->() const { return cur_; }
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        const_iterator& operator++() {
+            ++index_;
+            if (++cur_ == segmentEnd_) seek();
+            return *this;
+        }
+        const_iterator operator++(int) { auto old = *this; ++*this; return old; }
+        const_iterator& operator--() { --index_; seek(); return *this; }
+        const_iterator operator--(int) { auto old = *this; --*this; return old; }
+        const_iterator& operator+=(difference_type n) { index_ += n; seek(); return *this; }
+        const_iterator& operator-=(difference_type n) { index_ -= n; seek(); return *this; }
+        friend const_iterator operator+(const_iterator it, difference_type n) { return it += n; }
+        friend const_iterator operator+(difference_type n, const_iterator it) { return it += n; }
+        friend const_iterator operator-(const_iterator it, difference_type n) { return it -= n; }
+        friend difference_type operator-(const const_iterator& a, const const_iterator& b) {
+            return static_cast<difference_type>(a.index_) - static_cast<difference_type>(b.index_);
+        }
+
+        friend bool operator==(const const_iterator& a, const const_iterator& b) { return a.index_ == b.index_; }
+        friend bool operator!=(const const_iterator& a, const const_iterator& b) { return a.index_ != b.index_; }
+        friend bool operator<(const const_iterator& a, const const_iterator& b) { return a.index_ < b.index_; }
+        friend bool operator>(const const_iterator& a, const const_iterator& b) { return a.index_ > b.index_; }
+        friend bool operator<=(const const_iterator& a, const const_iterator& b) { return a.index_ <= b.index_; }
+        friend bool operator>=(const const_iterator& a, const const_iterator& b) { return a.index_ >= b.index_; }
+
+    private:
+        friend class EventLog;
+        const_iterator(const EventLog* log, std::size_t index) : log_(log), index_(index) { seek(); }
+        // point cur_/segmentEnd_ at index_ (both null past the end)
+        void seek();
+
+        const EventLog* log_ = nullptr;
+        std::size_t index_ = 0;
+        const Event* cur_ = nullptr;
+        const Event* segmentEnd_ = nullptr;
+    };
+    using iterator = const_iterator;
+    using value_type = Event;
+    using size_type = std::size_t;
+
+    size_type size() const { return sealedSize_ + tail_.size(); }
+    bool empty() const { return size() == 0; }
+    const Event& operator[](size_type i) const;
+    const Event& front() const { return (*this)[0]; }
+    const Event& back() const { return (*this)[size() - 1]; }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+
+    /// Copy one event onto the tail
+    void push_back(const Event& e) { tail_.push_back(e); }
+    /// Append the events of `chunk` without copying them
+    void append(const EventChunk& chunk);
+    /// Seal the tail, then return events [from, size()) as one chunk shared
+    /// with the log. A range spanning several chunks (rare: everything since
+    /// the last commit is usually one tail) is merged into a new chunk first.
+    EventChunk share(size_type from);
+    /// Sealed events [from, sealedSize()) as chunks sharing the log's storage
+    std::vector<EventChunk> sealedChunks(size_type from) const;
+    /// Drop every event from index `n` on
+    void truncate(size_type n);
+    /// Drop the first `n` events; indexes shift down by `n`
+    void dropFront(size_type n);
+    void clear();
+
+    /// Number of events held in sealed (shareable) chunks; the rest is the tail
+    size_type sealedSize() const { return sealedSize_; }
+    size_type chunkCount() const { return chunks_.size(); }
+
+private:
+    std::vector<EventChunk> chunks_;
+    std::vector<size_type> starts_;   // starts_[k]: log index of chunks_[k].front()
+    size_type sealedSize_ = 0;
+    std::vector<Event> tail_;
+
+    void seal();
+    // chunk containing sealed index `i`
+    size_type chunkOf(size_type i) const;
+};
+
+}  // namespace chronograph
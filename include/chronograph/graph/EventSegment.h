@@ -0,0 +1,146 @@
+// include/chronograph/graph/EventSegment.h
+#pragma once
+
+#include <chronograph/graph/Event.h>
+#include <chronograph/graph/EventLog.h>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace chronograph {
+
+class EventSegment;
+
+/// Attribute pairs of an EventView, decoded on iteration
+class PayloadView {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type        = std::pair<std::string_view, std::string_view>;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const value_type*;
+        using reference         = const value_type&;
+
+        reference operator*() const { return current_; }
+        pointer operator->() const { return &current_; }
+        iterator& operator++() { --left_; load(); return *this; }
+        friend bool operator==(const iterator& a, const iterator& b) { return a.left_ == b.left_; }
+        friend bool operator!=(const iterator& a, const iterator& b) { return a.left_ != b.left_; }
+
+    private:
+        friend class PayloadView;
+        iterator(const EventSegment* seg, const char* pos, std::size_t left)
+            : seg_(seg), pos_(pos), left_(left) { load(); }
+        void load();
+
+        const EventSegment* seg_;
+        const char* pos_;
+        std::size_t left_;
+        value_type current_;
+    };
+
+    std::size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    iterator begin() const { return iterator(seg_, pos_, count_); }
+    iterator end() const { return iterator(seg_, nullptr, 0); }
+
+private:
+    friend class EventSegment;
+    const EventSegment* seg_ = nullptr;
+    const char* pos_ = nullptr;   // first encoded pair
+    std::size_t count_ = 0;
+};
+
+/// One event read in place from a mapped segment; valid while the segment is open
+struct EventView {
+    EventType type;
+    std::int64_t timestamp;
+    std::string_view id;
+    std::string_view entityId;
+    PayloadView payload;
+    std::string_view from;
+    std::string_view to;
+};
+
+/// Read-only, memory-mapped event log segment
+// * layout (integers little-endian):
+//     64-byte header: magic, event count, string count, offsets of the
+//       string table, records and block index, min/max timestamp
+//     string table:   (count + 1) u64 offsets, then the string bytes; every
+//                     ID, attribute key/value and endpoint is stored once
+//     records:        u8 type, zigzag-varint timestamp delta, then varint
+//                     string numbers (id, entity, #attrs, key/value pairs,
+//                     endpoints for edge events)
+//     block index:    u64 record offset + i64 timestamp every kBlockEvents
+//                     events; deltas restart at each block
+// * opening maps the file and checks the header; pages are read lazily as
+//   records are visited, and nothing is deserialized into Event objects
+class EventSegment {
+public:
+    static constexpr std::size_t kBlockEvents = 4096;
+
+    /// Write `events` as a segment at `path` (atomically and durably, via
+    /// replaceFile and a sync of the directory).
+    /// Throws std::runtime_error on I/O errors.
+    static void write(const std::string& path, const EventLog& events);
+
+    /// Map the segment at `path`. Throws std::runtime_error if it cannot be
+    /// mapped or is not a valid segment.
+    explicit EventSegment(const std::string& path);
+    ~EventSegment();
+    EventSegment(EventSegment&& other) noexcept;
+    EventSegment& operator=(EventSegment&& other) noexcept;
+    EventSegment(const EventSegment&) = delete;
+    EventSegment& operator=(const EventSegment&) = delete;
+
+    std::size_t size() const { return eventCount_; }
+    std::size_t stringCount() const { return stringCount_; }
+    std::size_t fileBytes() const { return size_; }
+    std::int64_t minTimestamp() const { return minTimestamp_; }
+    std::int64_t maxTimestamp() const { return maxTimestamp_; }
+    std::string_view string(std::uint32_t index) const;
+
+    /// Sequential reader; cursor(index) starts it at any event index
+    class Cursor {
+    public:
+        /// Read the next event into `out`; false at the end
+        bool next(EventView& out);
+        std::size_t position() const { return index_; }
+
+    private:
+        friend class EventSegment;
+        explicit Cursor(const EventSegment* seg, std::size_t index);
+        const EventSegment* seg_;
+        std::size_t index_;
+        const char* pos_;
+        std::int64_t prevTimestamp_;
+    };
+    Cursor cursor(std::size_t index = 0) const { return Cursor(this, index); }
+
+    /// Copy one view into an owning Event
+    static Event toEvent(const EventView& view);
+
+private:
+    friend class PayloadView::iterator;
+    const char* base_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t eventCount_ = 0;
+    std::size_t stringCount_ = 0;
+    const char* offsets_ = nullptr;   // string offsets
+    const char* blob_ = nullptr;      // string bytes
+    const char* records_ = nullptr;
+    const char* recordsEnd_ = nullptr;
+    const char* blocks_ = nullptr;
+    std::int64_t minTimestamp_ = 0;
+    std::int64_t maxTimestamp_ = 0;
+
+    std::uint64_t readVarint(const char*& pos) const;
+    std::string_view readString(const char*& pos) const;
+    void unmap();
+};
+
+}  // namespace chronograph
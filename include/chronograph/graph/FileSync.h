@@ -0,0 +1,23 @@
+// include/chronograph/graph/FileSync.h
+#pragma once
+
+#include <initializer_list>
+#include <string>
+#include <string_view>
+
+namespace chronograph {
+
+/// Durable file replacement
+// * replaceFile writes `pieces` back to back to `path` + ".tmp", fsyncs it
+//   and renames it over `path`; a crash leaves either the old or the new
+//   file, never a torn one, and the temporary file is removed on failure
+// * the rename itself is durable only once the directory is synced: call
+//   syncDirectory (or syncParentDirectory) after one or more replaceFile
+// * all three throw std::runtime_error on I/O errors
+
+void replaceFile(const std::string& path, std::initializer_list<std::string_view> pieces);
+void syncDirectory(const std::string& dir);
+/// syncDirectory on the directory holding `path` ("." for a bare name)
+void syncParentDirectory(const std::string& path);
+
+}  // namespace chronograph
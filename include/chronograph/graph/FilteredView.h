@@ -0,0 +1,206 @@
+// include/chronograph/graph/FilteredView.h
+#pragma once
+
+#include <chronograph/graph/GraphView.h>
+#include <chronograph/graph/CsrGraph.h>
+#include <chronograph/graph/Node.h>
+#include <chronograph/graph/Edge.h>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace chronograph {
+
+/// Zero-copy subgraph of another GraphView, selected by predicates
+// * a node is visible when `nodePredicate(node)` holds (or no predicate is set)
+// * an edge is visible when `edgePredicate(edge)` holds and neither endpoint
+//   is a hidden node; dangling endpoints (IDs with no Node) never hide an edge
+// * lazy by default: predicates are evaluated during iteration
+// * precompute() evaluates them once and keeps the answers; over a CsrGraph
+//   they are stored as bitmasks indexed by node/edge position, over map-backed
+//   views (Graph, Snapshot) as sets of visible entity pointers
+//
+// The view keeps a reference to `base`, which must outlive it. Precomputed
+// answers describe `base` at the time of the call; call precompute() again
+// after mutating a Graph base.
+template <typename Base>
+class FilteredView {
+public:
+    using NodePredicate = std::function<bool(const Node&)>;
+    using EdgePredicate = std::function<bool(const Edge&)>;
+
+    explicit FilteredView(const Base& base,
+                          NodePredicate nodePredicate = {},
+                          EdgePredicate edgePredicate = {})
+        : base_(base),
+          nodePredicate_(std::move(nodePredicate)),
+          edgePredicate_(std::move(edgePredicate)) {}
+
+    const Base& base() const { return base_; }
+
+    /// Evaluate the predicates over the whole base view once
+    void precompute();
+    bool isPrecomputed() const { return precomputed_; }
+
+    /// Visibility checks used by the GraphViewTraits specialization
+    bool admitsNode(const Node& n) const;
+    bool admitsEdge(const Edge& e) const;
+    std::size_t visibleNodeCount() const;
+
+private:
+    using BaseView = GraphViewTraits<Base>;
+    static constexpr bool kDense = std::is_same<Base, CsrGraph>::value;
+
+    const Base& base_;
+    NodePredicate nodePredicate_;
+    EdgePredicate edgePredicate_;
+
+    bool precomputed_ = false;
+    std::size_t visibleNodes_ = 0;
+    // dense bases: one bit per position in base.nodes() / base.edges()
+    std::vector<bool> nodeMask_, edgeMask_;
+    // map-backed bases: pointers of visible entities
+    std::unordered_set<const Node*> nodeSet_;
+    std::unordered_set<const Edge*> edgeSet_;
+
+    bool evalNode(const Node& n) const {
+        return !nodePredicate_ || nodePredicate_(n);
+    }
+    bool evalEndpoint(const std::string& id) const {
+        const Node* n = BaseView::findNode(base_, id);
+        return !n || admitsNode(*n);
+    }
+    bool evalEdge(const Edge& e) const {
+        return (!edgePredicate_ || edgePredicate_(e)) &&
+               evalEndpoint(e.from) && evalEndpoint(e.to);
+    }
+};
+
+template <typename Base>
+void FilteredView<Base>::precompute() {
+    precomputed_ = false;
+    visibleNodes_ = 0;
+    nodeMask_.clear(); edgeMask_.clear();
+    nodeSet_.clear();  edgeSet_.clear();
+
+    if constexpr (kDense) {
+        const auto& nodes = base_.nodes();
+        nodeMask_.resize(nodes.size());
+        for (std::size_t i = 0; i < nodes.size(); ++i) {
+            nodeMask_[i] = evalNode(nodes[i]);
+            visibleNodes_ += nodeMask_[i];
+        }
+    } else {
+        BaseView::forEachNode(base_, [&](const Node& n) {
+            if (evalNode(n)) nodeSet_.insert(&n);
+        });
+        visibleNodes_ = nodeSet_.size();
+    }
+    // node answers are final; edges consult them through admitsNode
+    precomputed_ = true;
+
+    if constexpr (kDense) {
+        const auto& edges = base_.edges();
+        edgeMask_.resize(edges.size());
+        for (std::size_t i = 0; i < edges.size(); ++i) {
+            edgeMask_[i] = evalEdge(edges[i]);
+        }
+    } else {
+        BaseView::forEachEdge(base_, [&](const Edge& e) {
+            if (evalEdge(e)) edgeSet_.insert(&e);
+        });
+    }
+}
+
+template <typename Base>
+bool FilteredView<Base>::admitsNode(const Node& n) const {
+    if (!precomputed_) return evalNode(n);
+    if constexpr (kDense) {
+        return nodeMask_[&n - base_.nodes().data()];
+    } else {
+        return nodeSet_.count(&n) > 0;
+    }
+}
+
+template <typename Base>
+bool FilteredView<Base>::admitsEdge(const Edge& e) const {
+    if (!precomputed_) return evalEdge(e);
+    if constexpr (kDense) {
+        return edgeMask_[&e - base_.edges().data()];
+    } else {
+        return edgeSet_.count(&e) > 0;
+    }
+}
+
+template <typename Base>
+std::size_t FilteredView<Base>::visibleNodeCount() const {
+    if (precomputed_) return visibleNodes_;
+    std::size_t count = 0;
+    BaseView::forEachNode(base_, [&](const Node& n) { count += evalNode(n); });
+    return count;
+}
+
+template <typename Base>
+struct GraphViewTraits<FilteredView<Base>> {
+    using View = FilteredView<Base>;
+    using BaseView = GraphViewTraits<Base>;
+
+    static const Node* findNode(const View& g, const std::string& id) {
+        const Node* n = BaseView::findNode(g.base(), id);
+        return n && g.admitsNode(*n) ? n : nullptr;
+    }
+    static const Edge* findEdge(const View& g, const std::string& id) {
+        const Edge* e = BaseView::findEdge(g.base(), id);
+        return e && g.admitsEdge(*e) ? e : nullptr;
+    }
+    static std::size_t nodeCount(const View& g) {
+        return g.visibleNodeCount();
+    }
+    template <typename F>
+    static void forEachNode(const View& g, F&& f) {
+        BaseView::forEachNode(g.base(), [&](const Node& n) {
+            if (g.admitsNode(n)) f(n);
+        });
+    }
+    template <typename F>
+    static void forEachEdge(const View& g, F&& f) {
+        BaseView::forEachEdge(g.base(), [&](const Edge& e) {
+            if (g.admitsEdge(e)) f(e);
+        });
+    }
+    template <typename F>
+    static void forEachOutEdge(const View& g, const std::string& u, F&& f) {
+        if (hidden(g, u)) return;
+        BaseView::forEachOutEdge(g.base(), u, [&](const Edge& e) {
+            if (g.admitsEdge(e)) f(e);
+        });
+    }
+    template <typename F>
+    static void forEachInEdge(const View& g, const std::string& u, F&& f) {
+        if (hidden(g, u)) return;
+        BaseView::forEachInEdge(g.base(), u, [&](const Edge& e) {
+            if (g.admitsEdge(e)) f(e);
+        });
+    }
+
+private:
+    static bool hidden(const View& g, const std::string& id) {
+        const Node* n = BaseView::findNode(g.base(), id);
+        return n && !g.admitsNode(*n);
+    }
+};
+
+/// Predicate matching nodes or edges whose attribute `key` equals `value`
+// * usable as either a NodePredicate or an EdgePredicate
+inline auto attributeEquals(std::string key, std::string value) {
+    return [key = std::move(key), value = std::move(value)](const auto& entity) {
+        auto it = entity.attributes.find(key);
+        return it != entity.attributes.end() && it->second == value;
+    };
+}
+
+}  // namespace chronograph
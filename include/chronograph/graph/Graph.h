@@ -2,15 +2,23 @@
 #pragma once
 
 #include <chronograph/graph/Event.h>
+#include <chronograph/graph/EventLog.h>
 #include <chronograph/graph/Node.h>
 #include <chronograph/graph/Edge.h>
 #include <chronograph/graph/Snapshot.h>
+#include <cstdint>
+#include <memory>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <map>
+#include <optional>
+#include <string>
 
 namespace chronograph {
 
+class WriteAheadLog;
+
 /// Contains the core functionality for Graphs in ChronoGraph
 // * Handles nodes, edges, and events
 class Graph {
@@ -38,8 +46,21 @@ public:
                     const std::map<std::string, std::string>& attrs,
                     std::int64_t timestamp);
 
+    // ——— Durability ———
+    /// Append every event passed to addEvent (so every mutator) to `wal`;
+    /// nullptr detaches. Copies of the graph do not inherit the WAL.
+    void attachWal(std::shared_ptr<WriteAheadLog> wal);
+    const std::shared_ptr<WriteAheadLog>& wal() const { return wal_.ptr; }
+    /// Rebuild a graph from the event records of the WAL at `walPath`
+    // * one sequential pass; events are decoded into a single shared chunk
+    // * checkpoints are recreated every kCheckpointInterval events
+    // * the WAL is not attached; attach a WriteAheadLog on the same path to continue
+    static Graph recover(const std::string& walPath);
+
     // Access event log
-    const std::vector<Event>& getEventLog() const;
+    const EventLog& getEventLog() const;
+    /// Events from index `from` to the end, as a chunk sharing storage with the log
+    EventChunk shareEvents(size_t from);
     // expose checkpoints so Snapshot can use them
     struct Checkpoint {
         std::int64_t timestamp;
@@ -51,6 +72,34 @@ public:
     };
     const std::vector<Checkpoint>& getCheckpoints() const;
 
+    // ——— Compaction ———
+    // * folds the oldest events into a base state: checkpoint 0, at event
+    //   index 0, from which Snapshot and the Temporal sweeps then start
+    // * later checkpoints are kept (indexes shifted), older ones dropped;
+    //   the undo journal keeps the records of the events that remain
+    // * the state before the horizon is gone: Snapshot, diff and the
+    //   Temporal sweeps throw std::runtime_error for earlier timestamps
+
+    /// Fold the longest prefix of the log whose timestamps are < `horizonTs`.
+    /// If `archivePath` is given, the folded events are first written there
+    /// as an EventSegment. Returns the number of events folded.
+    size_t compact(std::int64_t horizonTs, const std::string& archivePath = "");
+    /// Fold the first `eventCount` events.
+    /// Throws std::invalid_argument if the log is shorter.
+    void compactEvents(size_t eventCount);
+    /// Events folded so far (0: never compacted)
+    size_t compactedEventCount() const { return compactedEvents_; }
+    /// Earliest timestamp the history still answers for (min if never compacted)
+    std::int64_t compactionHorizon() const;
+    /// A graph holding only the base state (empty log, no checkpoints)
+    Graph baseState() const;
+    /// Append the base state, horizon and folded-event count (EventCodec
+    /// primitives, entries sorted by ID); the log is not included
+    void encodeBase(std::string& out) const;
+    /// A graph compacted into a base read by encodeBase(), with an empty
+    /// log. Throws std::runtime_error on truncated or malformed input.
+    static Graph decodeBase(const char*& pos, const char* end);
+
     struct DiffResult {
         // Nodes
         std::vector<Node> nodesAdded;
@@ -72,14 +121,85 @@ public:
 
     // Apply a recorded Event to this graph’s state (no logging, no checkpoints)
     void applyEvent(const Event& event);
+    /// Append recorded events to the log without copying them, then apply each
+    // * equivalent to addEvent + applyEvent per event
+    void replayEvents(const EventChunk& events);
     // Clear all in-memory state (nodes, edges, adjacency) but keep eventLog_ intact
     void clearStateKeepLog();
     // Clear both in memory graph and branch-local events
     void clearGraph();
 
+    // ——— Undo journal ———
+    // * when enabled, every applied event also records before-images of the
+    //   entities it changes and the positions of the adjacency entries it
+    //   adds or removes, so the newest events can be rolled back in time
+    //   proportional to what they touched
+    void enableUndoJournal();
+    bool undoJournalEnabled() const;
+    /// Forget all recorded before-images; rollback can then only reach the current log size
+    void resetUndoJournal();
+    /// Forget the records of the first `eventCount` events; rollback can then
+    /// reach back to `eventCount` events at the earliest
+    void trimUndoJournal(size_t eventCount);
+    /// Copy of the graph whose journal holds no records (as after
+    /// resetUndoJournal()), without copying the records first
+    Graph copyWithoutUndoJournal() const;
+    /// Roll the live state back to just after the first `eventCount` events and
+    /// drop the later events from the log. Returns false (changing nothing) if
+    /// the journal does not reach back that far.
+    bool rollbackTo(size_t eventCount);
+
+    /// Version of the current state
+    // * bumped by every mutator, applyEvent and the clear functions
+    // * drawn from a process-wide counter, so two graphs only share a version
+    //   when one is an unmodified copy of the other
+    std::uint64_t version() const;
+
+    // ——— Secondary attribute indexes (nodes) ———
+    // * declared per attribute key; maintained by every mutator and applyEvent
+    // * HASH answers equality lookups, ORDERED also answers numeric ranges
+    // * each index also keeps the value history of every node, so lookups
+    //   can be answered as of a past timestamp (events assumed time-ordered)
+    enum class IndexKind { HASH, ORDERED };
+
+    /// Declare an index on node attribute `key`; history is built from the event log
+    void createNodeIndex(const std::string& key, IndexKind kind = IndexKind::HASH);
+    void dropNodeIndex(const std::string& key);
+    bool hasNodeIndex(const std::string& key) const;
+
+    /// IDs of live nodes whose attribute `key` equals `value` (sorted).
+    /// Uses the index on `key` if declared, otherwise scans all nodes.
+    std::vector<std::string> findNodes(const std::string& key,
+                                       const std::string& value) const;
+    /// IDs of live nodes whose attribute `key` parses as a number in [lo, hi] (sorted).
+    /// O(log n + k) with an ORDERED index, otherwise scans all nodes.
+    std::vector<std::string> findNodesInRange(const std::string& key,
+                                              double lo, double hi) const;
+    /// IDs of nodes whose attribute `key` equalled `value` as of `timestamp` (sorted).
+    /// Requires an index on `key`; throws std::runtime_error otherwise.
+    std::vector<std::string> findNodesAt(const std::string& key,
+                                         const std::string& value,
+                                         std::int64_t timestamp) const;
+
 private:
+    friend class VersionedGraph;   // catches up recycled versions
+    std::uint64_t version_ = nextVersion();
+    static std::uint64_t nextVersion();
+    void bumpVersion() { version_ = nextVersion(); }
+
     // Append-only event history
-    std::vector<Event> eventLog_;
+    EventLog eventLog_;
+
+    // WAL link: copies start without one, moves carry it along
+    struct WalLink {
+        std::shared_ptr<WriteAheadLog> ptr;
+        WalLink() = default;
+        WalLink(const WalLink&) {}
+        WalLink(WalLink&&) = default;
+        WalLink& operator=(const WalLink&) { return *this; }
+        WalLink& operator=(WalLink&&) = default;
+    };
+    WalLink wal_;
 
     // Graph state containers
     std::unordered_map<std::string, Node> nodes_;
@@ -88,10 +208,68 @@ private:
     std::unordered_map<std::string, std::vector<std::string>> outgoing_;
     std::unordered_map<std::string, std::vector<std::string>> incoming_;
 
+    // Secondary indexes: attribute key -> index
+    struct AttributeIndex {
+        IndexKind kind;
+        // current state: value -> node IDs (+ numeric values for ORDERED)
+        std::unordered_map<std::string, std::unordered_set<std::string>> byValue;
+        std::map<double, std::unordered_set<std::string>> byNumber;
+        // history: value -> intervals [from, to) during which a node held it
+        struct Interval { std::string nodeId; std::int64_t from; std::int64_t to; };
+        std::unordered_map<std::string, std::vector<Interval>> history;
+        // node ID -> position of its open interval in history[current value]
+        std::unordered_map<std::string, size_t> open;
+    };
+    std::map<std::string, AttributeIndex> nodeIndexes_;
+    using IndexedValues = std::vector<std::optional<std::string>>;
+    IndexedValues indexedValues(const std::string& nodeId) const;
+    void reindexNode(const std::string& nodeId, const IndexedValues& before,
+                     std::int64_t timestamp);
+    static void indexTransition(AttributeIndex& idx, const std::string& nodeId,
+                                const std::optional<std::string>& oldValue,
+                                const std::optional<std::string>& newValue,
+                                std::int64_t timestamp);
+    void resetIndexes();
+
+    // Undo journal: before-images of the entities one event changed, and
+    // its adjacency changes in the order they were made
+    struct UndoRecord {
+        size_t logSize;  // eventLog_.size() when the event was applied
+        std::vector<std::pair<std::string, std::optional<Node>>> nodes;
+        std::vector<std::pair<std::string, std::optional<Edge>>> edges;
+        struct AdjChange {
+            enum Kind : std::uint8_t { CREATE, APPEND, REMOVE, ERASE } kind;
+            bool outgoing;
+            std::string node;
+            std::string edge;               // APPEND, REMOVE
+            size_t index = 0;               // REMOVE: position it was removed from
+            std::vector<std::string> list;  // ERASE: the erased list
+        };
+        std::vector<AdjChange> adjacency;
+    };
+    bool journalEnabled_ = false;
+    size_t journalStart_ = 0;  // oldest log size the journal can roll back to
+    std::vector<UndoRecord> undoLog_;
+    // `logSize`: log size once `e` is in it; returns the record adjacency
+    // changes go to (nullptr while the journal is disabled)
+    UndoRecord* recordUndo(const Event& e, size_t logSize);
+    void applyEventAt(const Event& e, size_t logSize);
+    void undo(UndoRecord& r);
+
+    // Adjacency changes, journaled into `r` unless it is nullptr
+    using AdjacencyMap = std::unordered_map<std::string, std::vector<std::string>>;
+    AdjacencyMap& adjacency(bool outgoing) { return outgoing ? outgoing_ : incoming_; }
+    std::vector<std::string>& adjList(UndoRecord* r, bool outgoing, const std::string& node);
+    void adjAppend(UndoRecord* r, bool outgoing, const std::string& node, const std::string& edge);
+    void adjRemove(UndoRecord* r, bool outgoing, const std::string& node, const std::string& edge);
+    void adjErase(UndoRecord* r, bool outgoing, const std::string& node);
+
     // Checkpoint storage & parameters
     std::vector<Checkpoint> checkpoints_;
     static constexpr size_t kCheckpointInterval = 5000;
+    size_t compactedEvents_ = 0;  // when non-zero, checkpoints_[0] is the base
     void maybeCreateCheckpoint(const Event& e);
+    void createCheckpoint(std::int64_t timestamp, size_t eventIndex);
 };
 
 }  // namespace chronograph
\ No newline at end of file
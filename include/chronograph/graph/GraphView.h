@@ -0,0 +1,95 @@
+// include/chronograph/graph/GraphView.h
+#pragma once
+
+#include <chronograph/graph/Node.h>
+#include <chronograph/graph/Edge.h>
+#include <cstddef>
+#include <string>
+
+namespace chronograph {
+
+class Graph;
+class Snapshot;
+class CsrGraph;
+template <typename Base> class FilteredView;
+
+/**
+ * GraphView is the read-only interface every algorithm in
+ * `graph/algorithms/` is written against. A type `G` models GraphView when
+ * `GraphViewTraits<G>` provides:
+ *
+ *   static const Node* findNode(const G&, const std::string& id);  // nullptr if absent
+ *   static const Edge* findEdge(const G&, const std::string& id);  // nullptr if absent
+ *   static std::size_t nodeCount(const G&);
+ *   static void forEachNode(const G&, F f);                        // f(const Node&)
+ *   static void forEachEdge(const G&, F f);                        // f(const Edge&)
+ *   static void forEachOutEdge(const G&, const std::string& u, F f);
+ *   static void forEachInEdge(const G&, const std::string& u, F f);
+ *
+ * The primary template adapts any type exposing the map-based accessors of
+ * `Graph` and `Snapshot` (getNodes / getEdges / getOutgoing / getIncoming).
+ * Other views (CsrGraph, FilteredView) specialize it.
+ */
+template <typename G>
+struct GraphViewTraits {
+    static const Node* findNode(const G& g, const std::string& id) {
+        const auto& nodes = g.getNodes();
+        auto it = nodes.find(id);
+        return it == nodes.end() ? nullptr : &it->second;
+    }
+
+    static const Edge* findEdge(const G& g, const std::string& id) {
+        const auto& edges = g.getEdges();
+        auto it = edges.find(id);
+        return it == edges.end() ? nullptr : &it->second;
+    }
+
+    static std::size_t nodeCount(const G& g) {
+        return g.getNodes().size();
+    }
+
+    template <typename F>
+    static void forEachNode(const G& g, F&& f) {
+        for (const auto& [nid, node] : g.getNodes()) f(node);
+    }
+
+    template <typename F>
+    static void forEachEdge(const G& g, F&& f) {
+        for (const auto& [eid, edge] : g.getEdges()) f(edge);
+    }
+
+    template <typename F>
+    static void forEachOutEdge(const G& g, const std::string& u, F&& f) {
+        forEachAdjacent(g, g.getOutgoing(), u, f);
+    }
+
+    template <typename F>
+    static void forEachInEdge(const G& g, const std::string& u, F&& f) {
+        forEachAdjacent(g, g.getIncoming(), u, f);
+    }
+
+private:
+    template <typename Adj, typename F>
+    static void forEachAdjacent(const G& g, const Adj& adj,
+                                const std::string& u, F& f) {
+        auto ait = adj.find(u);
+        if (ait == adj.end()) return;
+        const auto& edges = g.getEdges();
+        for (const auto& eid : ait->second) {
+            auto eit = edges.find(eid);
+            if (eit != edges.end()) f(eit->second);
+        }
+    }
+};
+
+/// Every view type the algorithms are explicitly instantiated for.
+// * used as CHRONOGRAPH_GRAPH_VIEW_TYPES(MACRO) in the algorithm sources
+#define CHRONOGRAPH_GRAPH_VIEW_TYPES(X)                         \
+    X(::chronograph::Graph)                                     \
+    X(::chronograph::Snapshot)                                  \
+    X(::chronograph::CsrGraph)                                  \
+    X(::chronograph::FilteredView<::chronograph::Graph>)        \
+    X(::chronograph::FilteredView<::chronograph::Snapshot>)     \
+    X(::chronograph::FilteredView<::chronograph::CsrGraph>)
+
+}  // namespace chronograph
@@ -0,0 +1,36 @@
+// include/chronograph/graph/Hash.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace chronograph {
+
+/// 128-bit content hash
+struct Hash128 {
+    std::uint64_t hi = 0;
+    std::uint64_t lo = 0;
+
+    bool operator==(const Hash128& o) const { return hi == o.hi && lo == o.lo; }
+    bool operator!=(const Hash128& o) const { return !(*this == o); }
+
+    /// 32 lowercase hex digits, `hi` first
+    std::string toHex() const;
+};
+
+/// MurmurHash3 (x64, 128-bit) of `len` bytes at `data`
+// * fast and stable across platforms and processes: the same bytes always
+//   give the same hash, so it can name content persistently
+// * not cryptographic; do not rely on it against adversarial input
+Hash128 hash128(const void* data, std::size_t len, std::uint64_t seed = 0);
+
+inline Hash128 hash128(const std::string& bytes, std::uint64_t seed = 0) {
+    return hash128(bytes.data(), bytes.size(), seed);
+}
+
+/// CRC-32 (IEEE 802.3) of `len` bytes at `data`; pass a previous result as
+/// `crc` to continue over more bytes
+std::uint32_t crc32(const void* data, std::size_t len, std::uint32_t crc = 0);
+
+}  // namespace chronograph
@@ -0,0 +1,83 @@
+// include/chronograph/graph/ShardedGraph.h
+#pragma once
+
+#include <chronograph/graph/Event.h>
+#include <chronograph/graph/Graph.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace chronograph {
+
+class Snapshot;
+
+/// A graph partitioned by ID hash across shards, for ingest from many threads
+// * every shard has its own lock, event log and state (a Graph); a node
+//   lives in shardOf(node ID)
+// * an edge is owned by the shard of its source node, so a node's outgoing
+//   edges are local to it; incoming edges may live in any shard
+// * every event also gets a number from one global sequence, taken while its
+//   shard is locked; merging the shard logs by sequence gives one global order
+// * mutators are thread-safe; producers touching different shards only
+//   share the sequence counter
+class ShardedGraph {
+public:
+    /// `shards` partitions (0: std::thread::hardware_concurrency())
+    explicit ShardedGraph(std::size_t shards = 0);
+    ShardedGraph(const ShardedGraph&) = delete;
+    ShardedGraph& operator=(const ShardedGraph&) = delete;
+
+    std::size_t shardCount() const { return shards_.size(); }
+    /// Shard owning node `id` (stable across processes: a MurmurHash3 of the ID)
+    std::size_t shardOf(const std::string& id) const;
+
+    // ——— Mutators (thread-safe) ———
+    void addNode(const std::string& id,
+                 const std::map<std::string, std::string>& attrs,
+                 std::int64_t timestamp);
+    /// Also deletes the node's incoming edges owned by other shards
+    void delNode(const std::string& id, std::int64_t timestamp);
+    void addEdge(const std::string& id,
+                 const std::string& from,
+                 const std::string& to,
+                 const std::map<std::string, std::string>& attrs,
+                 std::int64_t timestamp);
+    /// The owner of an edge is not known from its ID: shards are probed in turn
+    void delEdge(const std::string& id, std::int64_t timestamp);
+    void updateNode(const std::string& id,
+                    const std::map<std::string, std::string>& attrs,
+                    std::int64_t timestamp);
+    /// The owner of an edge is not known from its ID: shards are probed in turn
+    void updateEdge(const std::string& id,
+                    const std::map<std::string, std::string>& attrs,
+                    std::int64_t timestamp);
+
+    // ——— Reading ———
+    std::size_t eventCount() const;
+    /// Events of all shards in global sequence order
+    std::vector<Event> events() const;
+    /// One Graph holding every event in global order, with the combined state
+    Graph merged() const;
+    /// Snapshot of one shard's events up to and including `timestamp`;
+    /// Snapshot(shardedGraph, timestamp) combines all shards in parallel
+    Snapshot snapshotShard(std::size_t shard, std::int64_t timestamp) const;
+
+private:
+    struct Shard {
+        mutable std::mutex mutex;
+        Graph graph;
+        std::vector<std::uint64_t> sequence;   // global number of each logged event
+    };
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::atomic<std::uint64_t> nextSequence_{0};
+
+    // run `op` on shard `s` under its lock, then number the events it logged
+    template <class Op> void mutate(Shard& s, Op&& op);
+};
+
+}  // namespace chronograph
@@ -1,6 +1,7 @@
 // include/chronograph/Snapshot.h
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <unordered_map>
@@ -11,14 +12,36 @@
 
 namespace chronograph {
 
-// forward declaration
+// forward declarations
 class Graph;
+class EventSegment;
+class ShardedGraph;
 
 class Snapshot {
 public:
     // Build snapshot by replaying events up to and including `timestamp`
     Snapshot(const Graph& graph, std::int64_t timestamp);
 
+    // Same result, replayed on `threads` threads (0: hardware_concurrency())
+    // * events are partitioned by entity ID and each partition replayed on
+    //   its own; DEL_NODE cascades into edges are applied afterwards
+    // * ranges shorter than kParallelMinEvents replay on one thread
+    // * adjacency lists hold the same edges in the same order, except for
+    //   the empty lists the sequential replay leaves for deleted IDs
+    // * falls back to one thread if an edge ID is added again without being
+    //   deleted, or deleted with other endpoints (stale list entries would
+    //   take part in later cascades)
+    Snapshot(const Graph& graph, std::int64_t timestamp, std::size_t threads);
+    static constexpr std::size_t kParallelMinEvents = 1 << 15;
+
+    // Build snapshot by replaying a mapped segment in place, up to and
+    // including `timestamp`
+    Snapshot(const EventSegment& segment, std::int64_t timestamp);
+
+    // Build snapshot of every shard, replaying up to `threads` shards at once
+    // (0: std::thread::hardware_concurrency()), and combine them
+    Snapshot(const ShardedGraph& graph, std::int64_t timestamp, std::size_t threads = 0);
+
     // Accessors for nodes and edges at this point in time
     const std::unordered_map<std::string, Node>& getNodes() const { return nodes_; }
     const std::unordered_map<std::string, Edge>& getEdges() const { return edges_; }
@@ -30,6 +53,9 @@ public:
         getIncoming() const { return incoming_; }
 
 private:
+    // Apply one event; E is Event or EventView
+    template <class E> void apply(const E& e);
+
     std::unordered_map<std::string, Node> nodes_;
     std::unordered_map<std::string, Edge> edges_;
     std::unordered_map<std::string, std::vector<std::string>> outgoing_;
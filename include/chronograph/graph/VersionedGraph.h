@@ -0,0 +1,117 @@
+// include/chronograph/graph/VersionedGraph.h
+#pragma once
+
+#include <chronograph/graph/Graph.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace chronograph {
+
+/// A Graph for one writer thread and any number of reader threads (MVCC)
+// * the writer mutates a private graph; publish() makes it the current
+//   immutable version, and new events then go to another private graph
+// * readers take the current version without waiting for the writer and
+//   run any algorithm on it; a version stays alive while a reader holds it
+// * when the last holder of an old version lets go, the version is handed
+//   back (up to kMaxRetired are kept, the rest are freed). The next private
+//   graph is the most recent one handed back, caught up by replaying the
+//   events published since (shared with the published log, not copied);
+//   if none is available, the current version is copied
+// * memory: the private graph, the current version, the retired versions
+//   and any older versions still held by readers
+// * a WAL attached to the initial graph (Graph::attachWal) moves with the
+//   writer's private graph: every mutator logs there, published versions
+//   hold none
+class VersionedGraph {
+public:
+    static constexpr std::size_t kMaxRetired = 2;
+
+    /// Start with `initial` as the published version
+    explicit VersionedGraph(Graph initial = Graph());
+    VersionedGraph(const VersionedGraph&) = delete;
+    VersionedGraph& operator=(const VersionedGraph&) = delete;
+
+    // ——— Writer (one thread) ———
+    void addNode(const std::string& id,
+                 const std::map<std::string, std::string>& attrs,
+                 std::int64_t timestamp);
+    void delNode(const std::string& id, std::int64_t timestamp);
+    void addEdge(const std::string& id,
+                 const std::string& from,
+                 const std::string& to,
+                 const std::map<std::string, std::string>& attrs,
+                 std::int64_t timestamp);
+    void delEdge(const std::string& id, std::int64_t timestamp);
+    void updateNode(const std::string& id,
+                    const std::map<std::string, std::string>& attrs,
+                    std::int64_t timestamp);
+    void updateEdge(const std::string& id,
+                    const std::map<std::string, std::string>& attrs,
+                    std::int64_t timestamp);
+
+    /// Publish the writer's graph as the current version (no-op without new events)
+    void publish();
+    /// Publish automatically once `events` events are pending (0: only publish())
+    void setPublishInterval(std::size_t events) { publishEvery_ = events; }
+    /// Events applied by the writer but not published yet
+    std::size_t pendingEvents() const;
+    /// The writer's private graph, including unpublished events
+    const Graph& writerGraph() const { return *head_; }
+
+    // ——— Readers (any thread) ———
+    /// The current version; it stays valid for as long as it is held
+    std::shared_ptr<const Graph> current() const;
+    /// Number of publish() calls that made a new version
+    std::uint64_t publishCount() const { return sequence_.load(std::memory_order_acquire); }
+    /// Copies made because no old version had been handed back
+    std::size_t copyCount() const { return copies_; }
+
+    /// Per-thread handle that reloads the current version only when a newer
+    /// one was published
+    // * current() of the graph takes a shared reference on every call; a
+    //   Reader checks an atomic counter instead, so readers on many cores
+    //   do not contend on the version's reference count
+    class Reader {
+    public:
+        explicit Reader(const VersionedGraph& graph) : graph_(&graph) {}
+        /// The latest version (refreshed if a newer one exists)
+        const Graph& get();
+        /// Drop the held version so it can be reclaimed
+        void release() { held_.reset(); }
+
+    private:
+        const VersionedGraph* graph_;
+        std::shared_ptr<const Graph> held_;
+        std::uint64_t seen_ = 0;
+    };
+
+private:
+    // old versions handed back by their last holder, on whichever thread
+    struct Retired {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<Graph>> graphs;
+    };
+    // deleter of published versions: retires them instead of freeing them
+    struct Retire {
+        std::shared_ptr<Retired> retired;
+        void operator()(const Graph* g) const;
+    };
+
+    std::shared_ptr<Retired> retired_ = std::make_shared<Retired>();
+    std::unique_ptr<Graph> head_;          // the writer's private graph
+    std::shared_ptr<const Graph> current_; // only accessed through std::atomic_load/store
+    std::size_t publishedSize_ = 0;        // log size of current_
+    std::size_t publishEvery_ = 0;
+    std::size_t copies_ = 0;
+    std::atomic<std::uint64_t> sequence_{0};
+
+    void afterWrite();
+};
+
+}  // namespace chronograph
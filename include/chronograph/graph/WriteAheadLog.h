@@ -0,0 +1,108 @@
+// include/chronograph/graph/WriteAheadLog.h
+#pragma once
+
+#include <chronograph/graph/Event.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace chronograph {
+
+/// Group-commit settings of a WriteAheadLog
+// * records become durable at the next sync; a sync happens once
+//   `syncEveryRecords` records are pending, or once `syncInterval` has
+//   passed since the last one with records pending (whichever comes first)
+// * the interval is kept by a background flusher thread, so records are
+//   durable after at most about `syncInterval` even if no append follows
+// * 0 disables either trigger; sync() and the destructor always sync
+struct WalOptions {
+    std::size_t syncEveryRecords = 1;
+    std::chrono::milliseconds syncInterval{0};
+};
+
+/// Durable, append-only log of records in a single file
+// * file: 8-byte magic, then records of
+//     u32 payload length | u32 CRC-32 of type+payload | u8 type | payload
+// * records are buffered in memory and written + fsync'ed in groups
+// * a torn or corrupt tail (crash mid-write) ends the valid log; opening a
+//   log cuts it off before appending
+// * appends are thread-safe
+class WriteAheadLog {
+public:
+    enum class RecordType : std::uint8_t {
+        EVENT  = 1,  // payload: encodeEvent()
+        COMMIT = 2,  // payloads of the repository records are defined by Repository
+        BRANCH = 3,
+        HEAD   = 4,
+        BASE   = 5,
+    };
+    struct Record {
+        RecordType type;
+        std::string payload;
+    };
+
+    /// Open `path` for appending, creating it if needed.
+    /// Throws std::runtime_error if it cannot be opened or is not a WAL file.
+    explicit WriteAheadLog(const std::string& path, WalOptions options = {});
+    /// Same, for a log whose valid prefix is already known from read()
+    /// (ReadResult::validBytes): skips the scan of the file
+    WriteAheadLog(const std::string& path, WalOptions options, std::size_t validBytes);
+    ~WriteAheadLog();
+    WriteAheadLog(const WriteAheadLog&) = delete;
+    WriteAheadLog& operator=(const WriteAheadLog&) = delete;
+
+    void appendEvent(const Event& e);
+    void append(RecordType type, const std::string& payload);
+    /// Write all buffered records and fsync the file
+    void sync();
+    /// Atomically replace the whole log by `records` (written to a temporary
+    /// file, fsync'ed and renamed over it); buffered records are dropped.
+    /// Throws std::runtime_error on I/O errors, leaving the old log in place.
+    void rewrite(const std::vector<Record>& records);
+
+    const std::string& path() const { return path_; }
+    std::size_t recordCount() const;   // appended through this object
+    std::size_t syncCount() const;
+
+    struct ReadResult {
+        std::vector<Record> records;
+        std::size_t validBytes = 0;  // file prefix holding the header and `records`
+        bool tornTail = false;       // bytes after validBytes were discarded
+    };
+    /// Read every valid record of the log at `path` in one sequential pass.
+    /// A missing file reads as empty. Throws std::runtime_error if the file
+    /// is not a WAL file.
+    static ReadResult read(const std::string& path);
+
+private:
+    std::string path_;
+    WalOptions options_;
+    int fd_ = -1;
+    mutable std::mutex mutex_;
+    std::string buffer_;          // encoded records not yet written
+    std::size_t pending_ = 0;     // records appended since the last sync
+    std::size_t records_ = 0;
+    std::size_t syncs_ = 0;
+    std::chrono::steady_clock::time_point lastSync_;
+    std::string scratch_;         // reused encoding buffer for events
+
+    // interval syncs: runs only if options_.syncInterval is set
+    std::thread flusher_;
+    std::condition_variable flusherWake_;
+    bool stopping_ = false;
+    void flushLoop();
+
+    // length of the valid prefix of the log at `path` (0 if missing)
+    static std::size_t scanValidBytes(const std::string& path);
+    void appendLocked(RecordType type, const char* data, std::size_t len);
+    void openForAppend();
+    void writeBuffer();
+    void syncLocked();
+};
+
+}  // namespace chronograph
@@ -0,0 +1,98 @@
+// include/chronograph/graph/algorithms/Cache.h
+#pragma once
+
+#include <any>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace chronograph {
+
+class Graph;
+
+namespace graph {
+namespace algorithms {
+
+/**
+ * Opt-in memoization of algorithm results.
+ *
+ * Entries are keyed by (algorithm, params, Graph::version()). Any mutation
+ * of the graph changes its version, so stale results are never returned;
+ * they simply stop being hit and age out. Eviction is LRU, bounded by the
+ * number of entries. All methods are thread-safe; a result is computed
+ * outside the lock, so concurrent misses on one key may both compute it.
+ */
+class AlgorithmCache {
+public:
+    explicit AlgorithmCache(std::size_t capacity = 256);
+
+    /**
+     * Return the cached result for the key, or call `compute()` (which must
+     * return an R), store its result and return it.
+     */
+    template <typename R, typename F>
+    R getOrCompute(const std::string& algorithm,
+                   const std::string& params,
+                   std::uint64_t version,
+                   F&& compute)
+    {
+        std::string key = makeKey(algorithm, params, version);
+        if (auto hit = lookup(key)) {
+            return std::any_cast<R>(*hit);
+        }
+        R result = compute();
+        insert(std::move(key), std::any(result));
+        return result;
+    }
+
+    std::size_t size() const;
+    std::size_t capacity() const { return capacity_; }
+    std::size_t hits() const;
+    std::size_t misses() const;
+    void clear();
+
+private:
+    static std::string makeKey(const std::string& algorithm,
+                               const std::string& params,
+                               std::uint64_t version);
+    std::optional<std::any> lookup(const std::string& key);
+    void insert(std::string key, std::any value);
+
+    using Entry = std::pair<std::string, std::any>;
+    std::size_t capacity_;
+    std::list<Entry> lru_;  // most recently used first
+    std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+    std::size_t hits_ = 0, misses_ = 0;
+    mutable std::mutex mutex_;
+};
+
+// Cached variants of the Graph algorithms; each returns exactly what the
+// uncached function returns for the current state of `g`.
+
+std::vector<std::vector<std::string>>
+cachedStronglyConnectedComponents(AlgorithmCache& cache, const Graph& g);
+
+std::vector<std::vector<std::string>>
+cachedWeaklyConnectedComponents(AlgorithmCache& cache, const Graph& g);
+
+std::optional<std::vector<std::string>>
+cachedTopologicalSort(AlgorithmCache& cache, const Graph& g);
+
+std::vector<std::string>
+cachedShortestPath(AlgorithmCache& cache, const Graph& g,
+                   const std::string& start, const std::string& target);
+
+std::vector<std::string>
+cachedDijkstra(AlgorithmCache& cache, const Graph& g,
+               const std::string& start, const std::string& target,
+               const std::string& weightKey);
+
+}  // namespace algorithms
+}  // namespace graph
+}  // namespace chronograph
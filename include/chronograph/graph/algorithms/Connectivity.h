@@ -1,41 +1,48 @@
 #pragma once
 
+#include <chronograph/graph/GraphView.h>
 #include <vector>
 #include <string>
 #include <cstdint>
 #include <optional>
 
 namespace chronograph {
-class Graph;
 
 namespace graph {
 namespace algorithms {
 
+// Templates over any GraphView (see GraphView.h), explicitly instantiated
+// for every type in CHRONOGRAPH_GRAPH_VIEW_TYPES.
+
 /// Compute the weakly-connected components of a directed graph.
 /// Treats edges as undirected. Returns a vector of components,
 /// each component is a list of node-IDs.
+template <typename G>
 std::vector<std::vector<std::string>>
-weaklyConnectedComponents(const Graph& g);
+weaklyConnectedComponents(const G& g);
 
 /**
  * Compute the strongly‐connected components of a directed graph.
  * Returns a vector of components, each a list of node‐IDs.
  */
+template <typename G>
 std::vector<std::vector<std::string>>
-stronglyConnectedComponents(const Graph& g);
+stronglyConnectedComponents(const G& g);
 
 /**
  * Return true if the directed graph contains any cycle.
  */
-bool hasCycle(const Graph& g);
+template <typename G>
+bool hasCycle(const G& g);
 
 /**
  * Perform a topological sort of the directed graph.
  * If the graph is acyclic, returns a vector of node‐IDs in topological order.
  * If there is a cycle, returns std::nullopt.
  */
+template <typename G>
 std::optional<std::vector<std::string>>
-topologicalSort(const Graph& g);
+topologicalSort(const G& g);
 
 
 }  // namespace algorithms
@@ -1,21 +1,26 @@
 // include/chronograph/graph/algorithms/Paths.h
 #pragma once
 
+#include <chronograph/graph/GraphView.h>
 #include <string>
 #include <vector>
 #include <cstdint>
 
 namespace chronograph {
 
-class Graph;
-
 namespace graph {
 namespace algorithms {
 
+// The algorithms below are templates over any GraphView (see GraphView.h).
+// They are explicitly instantiated for every type in
+// CHRONOGRAPH_GRAPH_VIEW_TYPES: Graph, Snapshot, CsrGraph and FilteredView
+// over each of those.
+
 /**
  * Returns true if `target` is reachable from `start` in the given graph.
  */
-bool isReachable(const Graph& g,
+template <typename G>
+bool isReachable(const G& g,
                  const std::string& start,
                  const std::string& target);
 
@@ -24,13 +29,14 @@ bool isReachable(const Graph& g,
  * Returns the sequence of node IDs [start, ..., target].
  * Empty vector if no path exists (or if either node is missing).
  */
-std::vector<std::string> shortestPath(const Graph& g,
+template <typename G>
+std::vector<std::string> shortestPath(const G& g,
     const std::string& start,
     const std::string& target);
 
 /**
 * Returns true if `target` is reachable from `start` in `g` *as of* `timestamp`.
-* Internally takes a Snapshot at time T and runs reachability on that snapshot.
+* Internally takes a Snapshot at time T and runs isReachable on that snapshot.
 */
 bool isReachableAt(const Graph& g,
     const std::string& start,
@@ -41,7 +47,8 @@ bool isReachableAt(const Graph& g,
  * Returns true if `target` is reachable from `start` in the given graph,
  * considering only paths whose edge‐creation timestamps never decrease.
  */
-bool isTimeRespectingReachable(const Graph& g,
+template <typename G>
+bool isTimeRespectingReachable(const G& g,
     const std::string& start,
     const std::string& target);
 
@@ -55,8 +62,9 @@ bool isTimeRespectingReachable(const Graph& g,
  * Returns the sequence of node IDs [start, ..., target].
  * Returns an empty vector if no path exists (or if start/target missing).
  */
+template <typename G>
 std::vector<std::string> dijkstra(
-    const Graph& g,
+    const G& g,
     const std::string& start,
     const std::string& target,
     const std::string& weightKey);
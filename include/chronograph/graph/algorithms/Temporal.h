@@ -0,0 +1,84 @@
+// include/chronograph/graph/algorithms/Temporal.h
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <optional>
+#include <functional>
+
+namespace chronograph {
+
+class Graph;
+
+namespace graph {
+namespace algorithms {
+
+/**
+ * Batched time-travel queries.
+ *
+ * Every function below takes a list of timestamps sorted in non-decreasing
+ * order (duplicates allowed) and performs a single forward sweep over the
+ * event log of `g`. State is updated incrementally between consecutive
+ * timestamps, and the query is evaluated at each cut point. The result for
+ * timestamp T matches what a `Snapshot(g, T)` would give.
+ *
+ * Throws std::invalid_argument if `timestamps` is not sorted.
+ */
+
+/**
+ * Callback invoked once per timestamp with the replayed graph state as of
+ * that timestamp. The state only holds nodes, edges and adjacency; its event
+ * log is empty. The reference is only valid for the duration of the call.
+ */
+using SweepVisitor = std::function<void(std::int64_t timestamp, const Graph& state)>;
+
+/**
+ * Replay the event log of `g` once and call `visit` at every timestamp.
+ */
+void sweepTimestamps(const Graph& g,
+    const std::vector<std::int64_t>& timestamps,
+    const SweepVisitor& visit);
+
+/**
+ * Batched `isReachableAt`: result[i] is true if `target` is reachable from
+ * `start` as of timestamps[i].
+ */
+std::vector<bool> isReachableAtTimes(const Graph& g,
+    const std::string& start,
+    const std::string& target,
+    const std::vector<std::int64_t>& timestamps);
+
+/**
+ * Return the first timestamp in `timestamps` at which `target` is reachable
+ * from `start`, or std::nullopt if it never is. Stops replaying as soon as
+ * the answer is known.
+ */
+std::optional<std::int64_t> firstReachableTime(const Graph& g,
+    const std::string& start,
+    const std::string& target,
+    const std::vector<std::int64_t>& timestamps);
+
+/**
+ * Number of weakly-connected components as of each timestamp.
+ * Additions are folded in with union-find; deletions trigger a full
+ * recount at the next cut point only.
+ */
+std::vector<std::size_t> componentCountAtTimes(const Graph& g,
+    const std::vector<std::int64_t>& timestamps);
+
+/**
+ * Number of outgoing / incoming edges of `nodeId` as of each timestamp.
+ * A node that does not exist at a given time has degree 0.
+ */
+std::vector<std::size_t> outDegreeAtTimes(const Graph& g,
+    const std::string& nodeId,
+    const std::vector<std::int64_t>& timestamps);
+std::vector<std::size_t> inDegreeAtTimes(const Graph& g,
+    const std::string& nodeId,
+    const std::vector<std::int64_t>& timestamps);
+
+}  // namespace algorithms
+}  // namespace graph
+}  // namespace chronograph
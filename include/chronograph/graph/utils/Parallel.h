@@ -0,0 +1,44 @@
+// include/chronograph/graph/utils/Parallel.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace chronograph {
+
+/// Run fn(0..n-1), one call per thread; the calling thread runs fn(0)
+// * n == 1 calls fn(0) without starting a thread
+// * returns once every call has returned
+template <typename F>
+void onWorkers(std::size_t n, F&& fn) {
+    if (n <= 1) {
+        fn(0);
+        return;
+    }
+    std::vector<std::thread> workers;
+    workers.reserve(n - 1);
+    for (std::size_t w = 1; w < n; ++w) workers.emplace_back(fn, w);
+    fn(0);
+    for (auto& t : workers) t.join();
+}
+
+/// Positions 0..n-1 grouped by partition, each group in ascending order
+// * `part[i]` is the partition of position i (below `parts`)
+// * a counting sort: O(n + parts), so workers can each visit only their own
+//   positions instead of scanning and skipping all of them
+struct PartitionBuckets {
+    std::vector<std::size_t> start;  // partition p: order[start[p], start[p + 1])
+    std::vector<std::size_t> order;
+
+    PartitionBuckets(const std::vector<std::uint16_t>& part, std::size_t parts)
+        : start(parts + 1, 0), order(part.size()) {
+        for (auto p : part) ++start[p + 1];
+        for (std::size_t p = 0; p < parts; ++p) start[p + 1] += start[p];
+        std::vector<std::size_t> fill(start.begin(), start.end() - 1);
+        for (std::size_t i = 0; i < part.size(); ++i) order[fill[part[i]]++] = i;
+    }
+};
+
+}  // namespace chronograph
@@ -0,0 +1,101 @@
+// include/chronograph/repo/Merge.h
+#pragma once
+
+#include <chronograph/graph/Event.h>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace chronograph {
+
+// -- Merging and Conflict Types ---
+enum class MergePolicy { OURS, THEIRS, ATTRIBUTE_UNION, INTERACTIVE };
+struct Conflict {
+  enum Kind { ADD_ADD, DEL_UPDATE, UPDATE_UPDATE } kind;
+  Event ours, theirs;
+};
+struct MergeResult {
+    std::string         mergeCommitId;
+    std::vector<Conflict> conflicts;  // empty if no conflicts or non-interactive
+  };
+
+/// Entities one side of a merge changed since the common ancestor
+// * filled from that side's commit deltas in O(delta); lookups are O(1), so
+//   classifying the other side's events is a hash join
+// * holds pointers into the events added, which must outlive the index
+class TouchedIndex {
+public:
+    /// Record one event of this side (in log order)
+    void add(const Event& e);
+
+    /// The index holding this side's events of a node (see conflictWith)
+    using NodeLookup = std::function<const TouchedIndex&(std::string_view nodeId)>;
+
+    /// How `theirs` (an event of the other side) collides with this side, if at all
+    // * ADD_ADD: both added the entity, with different attributes or endpoints
+    // * DEL_UPDATE: one side deleted the entity, the other changed it; or
+    //   `theirs` adds or updates an edge whose endpoint this side deleted
+    // * UPDATE_UPDATE: both set an attribute key to different values
+    // * endpoints are looked up in `nodes(id)`, or in this index if empty
+    std::optional<Conflict> conflictWith(const Event& theirs,
+                                         const NodeLookup& nodes = {}) const;
+
+    /// This side's deletion of node `id`, if that is its latest change
+    const Event* deletedNode(std::string_view id) const;
+
+    /// True if this side already added `theirs`'s entity exactly as `theirs` does
+    bool sameAdd(const Event& theirs) const;
+
+    /// `theirs` without the attribute keys this side set on the same entity
+    Event withoutOurKeys(const Event& theirs) const;
+
+    std::size_t size() const { return nodes_.size() + edges_.size(); }
+
+private:
+    struct Entity {
+        const Event* added = nullptr;    // latest ADD_* (cleared by a delete)
+        const Event* deleted = nullptr;  // latest DEL_* (cleared by a re-add)
+        const Event* updated = nullptr;  // latest UPDATE_*
+        // attribute key -> latest event of this side that set it
+        std::unordered_map<std::string_view, const Event*> keys;
+    };
+    std::unordered_map<std::string_view, Entity> nodes_, edges_;
+
+    const Entity* find(const Event& e) const;
+    std::optional<Conflict> entityConflict(const Event& theirs) const;
+};
+
+/// The events to apply for a conflicting event of the other side under
+/// `policy`, in order; none to leave it out.
+// * THEIRS: the other side's event as is; an edge both sides added becomes
+//   an UPDATE_EDGE if the endpoints agree, else a DEL_EDGE of our edge
+//   (with our endpoints) followed by their ADD_EDGE
+// * OURS / INTERACTIVE: only its attribute keys this side did not set
+//   (UPDATE_UPDATE); adds and deletes that conflict are left out
+// * an edge event whose endpoint this side deleted is left out under
+//   every policy
+// * ATTRIBUTE_UNION: like OURS, but a conflicting add contributes the
+//   attribute keys this side lacks (edges only if the endpoints agree)
+std::vector<Event> resolveConflict(const Conflict& conflict,
+                                   MergePolicy policy,
+                                   const TouchedIndex& ours);
+
+/// Merge the other side's delta into ours: classify every event of `theirs`
+/// against `ours`, resolve conflicts under `policy`, and pass each event to
+/// apply to `apply`, in `theirs` order. Returns the conflicts, in `theirs` order.
+// * both deltas are partitioned by entity-ID hash and bucketed per partition
+//   (counting sort, log order kept), and each partition is classified and resolved on its own thread (up to `threads`); applying
+//   stays sequential. Edge endpoints are checked against the partitions of
+//   the nodes, so all indexes are built before classification starts
+// * all events of one entity fall into one partition, so the result is the
+//   same for any thread count
+std::vector<Conflict> mergeDeltas(const std::vector<const Event*>& ours,
+                                  const std::vector<const Event*>& theirs,
+                                  MergePolicy policy, std::size_t threads,
+                                  const std::function<void(const Event&)>& apply);
+
+}  // namespace chronograph
@@ -0,0 +1,117 @@
+// include/chronograph/repo/PackFile.h
+#pragma once
+
+#include <chronograph/repo/Repository.h>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace chronograph {
+
+/// Commits, branches and HEAD of a repository, stored in a directory
+// * files (integers little-endian, strings length-prefixed as in EventCodec):
+//     refs:    text; "PACK <n>" naming the generation of the other two files,
+//              "HEAD <branch>", then one "<commit ID> <branch>" per line
+//     index.n: magic, u64 commit count, then per commit (parents first) its
+//              ID, parents, message, event count, first/last timestamp and
+//              the offset + length of its block in pack.n; then the ID of
+//              the compaction base ("" if none) followed by its
+//              Graph::encodeBase(); u32 CRC-32 at the end
+//     pack.n:  magic, then one block per commit:
+//              u32 CRC-32 of the rest | compressEvents() of its events
+// * opening reads refs and the whole index, so it takes time and memory
+//   proportional to the number of commits (their metadata, not their
+//   events); a commit's events are read from the pack when asked for and
+//   kept in an LRU cache bounded by an estimate of their in-memory size
+// * batches of commits (ancestor chains) are read in pack order, with
+//   adjacent blocks coalesced into one read
+// * a write creates generation n + 1 next to the current one; every file is
+//   fsynced before its rename, and the rename of refs switches over. A crash
+//   before it leaves the old generation in use; older files are removed after
+class PackFile {
+public:
+    /// Write a pack to `dir` (created if needed). `commits` must list every
+    /// commit after its parents, each with its events (none for commits
+    /// folded into `baseState`, the compacted state at `baseCommitId`).
+    /// Throws std::runtime_error on I/O errors.
+    static void write(const std::string& dir,
+                      const std::vector<std::pair<const Commit*, EventChunk>>& commits,
+                      const std::unordered_map<std::string, std::string>& branches,
+                      const std::string& head,
+                      const std::string& baseCommitId = "",
+                      const Graph* baseState = nullptr);
+
+    /// Open the pack in `dir`. Throws std::runtime_error if it is missing
+    /// or inconsistent.
+    explicit PackFile(const std::string& dir);
+    ~PackFile();
+    PackFile(const PackFile&) = delete;
+    PackFile& operator=(const PackFile&) = delete;
+
+    /// Commit metadata in index order (parents first); events left empty
+    const std::vector<Commit>& commits() const { return commits_; }
+    const std::unordered_map<std::string, std::string>& branches() const { return branches_; }
+    const std::string& head() const { return head_; }
+    /// Compaction base ("" and null if the history was never compacted)
+    const std::string& baseCommitId() const { return baseCommitId_; }
+    const std::shared_ptr<const Graph>& baseState() const { return baseState_; }
+
+    static constexpr std::size_t kDefaultCacheBytes = std::size_t(64) << 20;
+    static constexpr std::size_t kMaxReadBytes = std::size_t(8) << 20;  // per coalesced read
+
+    /// Events of `commitId`, from the cache or the pack. Thread-safe.
+    /// Throws std::runtime_error for unknown commits or a corrupt block.
+    EventChunk events(const std::string& commitId) const;
+    /// Events of each of `commitIds`, in order; the ones not cached are read
+    /// in one pass over the pack
+    std::vector<EventChunk> events(const std::vector<std::string>& commitIds) const;
+
+    /// Change the cache budget, evicting least recently used chunks if needed
+    // * a chunk still referenced elsewhere (e.g. by a working log) stays
+    //   alive after eviction; the budget bounds what the cache alone keeps
+    void setCacheLimit(std::size_t maxBytes);
+    std::size_t cacheLimit() const;
+    std::size_t cacheBytes() const;
+    std::size_t cachedCount() const;
+    std::size_t readCount() const;   // pread calls so far
+
+private:
+    struct Block {
+        std::uint64_t offset;
+        std::uint64_t bytes;
+    };
+    struct Entry {
+        std::string commitId;
+        EventChunk events;
+        std::size_t bytes;
+    };
+    std::string packPath_;
+    int fd_ = -1;   // pack
+    std::vector<Commit> commits_;
+    std::unordered_map<std::string, std::string> branches_;
+    std::string head_;
+    std::string baseCommitId_;
+    std::shared_ptr<const Graph> baseState_;
+    std::unordered_map<std::string, Block> blocks_;
+
+    mutable std::mutex mutex_;
+    std::size_t maxBytes_ = kDefaultCacheBytes;
+    mutable std::size_t bytes_ = 0;
+    mutable std::size_t reads_ = 0;
+    mutable std::list<Entry> lru_;  // most recently used first
+    mutable std::unordered_map<std::string, std::list<Entry>::iterator> cached_;
+
+    const Block& blockFor(const std::string& commitId) const;
+    void readBlocks(const std::vector<const std::string*>& ids,
+                    std::unordered_map<std::string, EventChunk>& out) const;
+    void cacheLocked(const std::string& commitId, const EventChunk& events) const;
+    void evictToFit(std::size_t budget) const;
+};
+
+}  // namespace chronograph
@@ -0,0 +1,38 @@
+// include/chronograph/repo/ReachabilityBitmap.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace chronograph {
+
+/// Set of commits reachable from one commit, as a bitset over dense commit indexes
+// * bit i is set when the commit with index i is an ancestor (or the commit itself)
+// * plain 64-bit words; grows on demand, unset high bits are implicit zeros
+class ReachabilityBitmap {
+public:
+    void set(std::size_t i) {
+        const std::size_t w = i / 64;
+        if (w >= words_.size()) words_.resize(w + 1, 0);
+        words_[w] |= std::uint64_t{1} << (i % 64);
+    }
+
+    bool test(std::size_t i) const {
+        const std::size_t w = i / 64;
+        return w < words_.size() && (words_[w] >> (i % 64) & 1u);
+    }
+
+    /// Union with `other` (in place)
+    void merge(const ReachabilityBitmap& other) {
+        if (other.words_.size() > words_.size()) words_.resize(other.words_.size(), 0);
+        for (std::size_t w = 0; w < other.words_.size(); ++w) words_[w] |= other.words_[w];
+    }
+
+    std::size_t sizeInBytes() const { return words_.size() * sizeof(std::uint64_t); }
+
+private:
+    std::vector<std::uint64_t> words_;
+};
+
+}  // namespace chronograph
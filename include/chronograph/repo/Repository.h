@@ -2,22 +2,119 @@
 
 #include <chronograph/graph/Graph.h>
 #include <chronograph/graph/Event.h> 
+#include <chronograph/graph/WriteAheadLog.h>
+#include <chronograph/repo/Merge.h>
+#include <chronograph/repo/ReachabilityBitmap.h>
+#include <chronograph/repo/StateCache.h>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
+#include <optional>
+#include <queue>
 
 namespace chronograph {
 
 // --- Commit Types ---
 /// Represents single Commit in the repository
 // * these form a DAG of commits in the Repository
-// * events for every commit are stored in a vector
+// * events for every commit are an immutable chunk, shared with the working
+//   log of any graph that replays the commit and with copies of the Commit
+// * in a repository opened from a pack, and for commits compressed by
+//   compressColdCommits(), `events` stays empty and the repository loads
+//   them when needed; `eventCount` is always set
 struct Commit {
-    std::string id;         // commit hash/UUID
+    std::string id;         // content address: hash of parents, message and events
     std::vector<std::string> parents;  // parent commit IDs (1 or 2 for merges)
-    std::vector<Event> events;    // the delta introduced by this commit
+    EventChunk events;            // the delta introduced by this commit
     std::string message;
+    // topological level: 1 for the root, else 1 + max(parent generations)
+    // * an ancestor always has a strictly smaller generation
+    std::size_t generation = 0;
+    // earliest and latest event timestamp in `events` (both 0 if empty)
+    std::int64_t firstTimestamp = 0;
+    std::int64_t lastTimestamp = 0;
+    std::size_t eventCount = 0;
+};
+
+/// Read-only view of one commit's metadata, for log-style listings
+// * refers into the repository; nothing is copied
+class CommitInfo {
+public:
+    explicit CommitInfo(const Commit& c) : commit_(&c) {}
+
+    const std::string& id() const { return commit_->id; }
+    const std::vector<std::string>& parents() const { return commit_->parents; }
+    const std::string& message() const { return commit_->message; }
+    std::size_t eventCount() const { return commit_->eventCount; }
+    std::size_t generation() const { return commit_->generation; }
+    std::int64_t firstTimestamp() const { return commit_->firstTimestamp; }
+    std::int64_t lastTimestamp() const { return commit_->lastTimestamp; }
+    /// The full commit (events may not be loaded yet, see Commit)
+    const Commit& commit() const { return *commit_; }
+
+private:
+    const Commit* commit_;
+};
+
+class Repository;
+class PackFile;
+
+/// Lazy walk over the ancestors of a commit, newest first
+// * commits come out in decreasing generation order (ties: newest first),
+//   so every commit precedes its parents, like `git log --topo-order`
+// * each step costs O(log frontier); commits past the limit are never visited
+// * the repository must outlive the walk and not gain commits during it
+class CommitWalk {
+public:
+    /// Next commit, or nullopt once history (or the limit) is exhausted
+    std::optional<CommitInfo> next();
+
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type        = CommitInfo;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const CommitInfo*;
+        using reference         = const CommitInfo&;
+
+        reference operator*() const { return *current_; }
+        pointer operator->() const { return &*current_; }
+        iterator& operator++() { current_ = walk_->next(); return *this; }
+        friend bool operator==(const iterator& a, const iterator& b) {
+            if (!a.current_ || !b.current_) return !a.current_ && !b.current_;
+            return &a.current_->commit() == &b.current_->commit();
+        }
+        friend bool operator!=(const iterator& a, const iterator& b) { return !(a == b); }
+
+    private:
+        friend class CommitWalk;
+        iterator(CommitWalk* walk, std::optional<CommitInfo> current)
+            : walk_(walk), current_(std::move(current)) {}
+        CommitWalk* walk_;
+        std::optional<CommitInfo> current_;
+    };
+    /// Range-for support; begin() advances the walk
+    iterator begin() { return iterator(this, next()); }
+    iterator end() { return iterator(this, std::nullopt); }
+
+private:
+    friend class Repository;
+    CommitWalk(const Repository& repo, const Commit& tip, std::size_t limit);
+    void push(const Commit& c);
+
+    const Repository* repo_;
+    // max-heap of (generation, insertion index) -> commit
+    using Entry = std::pair<std::pair<std::size_t, std::size_t>, const Commit*>;
+    std::priority_queue<Entry> frontier_;
+    std::unordered_set<const Commit*> seen_;
+    std::size_t remaining_;  // commits still allowed by the limit
 };
 
 // A simple representation of the commit DAG
@@ -31,17 +128,12 @@ struct CommitGraph {
   std::unordered_map<std::string, std::vector<std::string>> children;
 };
 
-// -- Merging and Conflict Types ---
-enum class MergePolicy { OURS, THEIRS, ATTRIBUTE_UNION, INTERACTIVE };
-struct Conflict {
-  enum Kind { ADD_ADD, DEL_UPDATE, UPDATE_UPDATE } kind;
-  Event ours, theirs;
+/// What Repository::gc() freed
+struct GcResult {
+    std::size_t commits = 0;        // unreachable commits removed
+    std::size_t cachedStates = 0;   // cached states (and their checkpoints) dropped
+    std::size_t bytes = 0;          // estimated heap bytes reclaimed
 };
-struct MergeResult {
-    std::string         mergeCommitId;
-    std::vector<Conflict> conflicts;  // empty if no conflicts or non-interactive
-  };
-
 
 // Git-style repository for a graph
 class Repository {
@@ -49,6 +141,62 @@ public:
     /// Initialize an empty repo with a single root commit on `rootBranch`
     static Repository init(const std::string& rootBranch = "main");
 
+    /// Open a durable repository backed by the write-ahead log at `walPath`
+    // * a new (or empty) log starts a repository like init()
+    // * otherwise commits, branches, HEAD and uncommitted working-tree events
+    //   are recovered from it in one sequential pass
+    // * afterwards every mutator event, commit, branch, checkout and merge is
+    //   appended to the log, made durable per `options` (group commit)
+    // * throws std::runtime_error if the file is not a consistent log
+    static Repository open(const std::string& walPath,
+                           WalOptions options = {},
+                           const std::string& rootBranch = "main");
+
+    /// Write commits, branches and HEAD as a pack in directory `dir`
+    // * uncommitted working-tree events are not saved
+    // * replaces a pack already in `dir`; see PackFile for the format
+    // * after compact() the pack holds the base state instead of the events
+    //   folded into it
+    void writePack(const std::string& dir) const;
+
+    /// Open the repository stored as a pack in `dir`
+    // * reads the refs and the commit index only, so startup does not depend
+    //   on the size of the history; the working graph is rebuilt at HEAD on
+    //   first use
+    // * commits_ then holds metadata only: events are read from the pack on
+    //   demand into a bounded cache (setEventCacheLimit). checkout, merge,
+    //   graphAt and listCommits read the commits of an ancestor chain in one
+    //   pass, in pack order
+    // * throws std::runtime_error if `dir` holds no consistent pack
+    static Repository openPack(const std::string& dir);
+
+    /// Budget of the cache of event chunks read from the pack, in estimated
+    /// bytes (default PackFile::kDefaultCacheBytes; no effect without a pack)
+    void setEventCacheLimit(std::size_t maxBytes);
+
+    /// Compress the events of cold commits in memory; returns the estimated
+    /// bytes saved
+    // * a commit is cold when nothing but the commit refers to its events:
+    //   not the working log, a cached state or a graph handed out by graphAt
+    // * its events are kept as a compressEvents() block and decompressed
+    //   whenever they are needed again
+    std::size_t compressColdCommits();
+
+    /// Fold the history before `horizonTs` into a base state; returns the
+    /// base commit (empty if nothing could be folded yet)
+    // * the base is the newest commit on HEAD's first-parent chain that is
+    //   on the first-parent chain of every branch tip, and whose chain from
+    //   the root holds only events before the horizon
+    // * the working graph and every state built later start from the base
+    //   state (Graph::compactEvents); the events of the base and its
+    //   ancestors are dropped, and listCommits() returns them empty
+    // * graphAt() of a commit below the base, and snapshots before the
+    //   horizon, throw std::runtime_error
+    // * writePack() and openPack() keep the base; with a write-ahead log the
+    //   log is rewritten to the base, the remaining commits' events and the
+    //   uncommitted events, so open() no longer replays the folded history
+    std::string compact(std::int64_t horizonTs);
+
     // ——— Working-tree mutators (for staging) ———
     void addNode(const std::string& id,
                  const std::map<std::string, std::string>& attrs,
@@ -73,6 +221,18 @@ public:
     /// Create a new branch at the current HEAD commit
     void branch(const std::string& branchName);
 
+    /// Delete the branch `branchName`; its commits stay until gc().
+    /// Throws std::runtime_error if it does not exist or is checked out.
+    void deleteBranch(const std::string& branchName);
+
+    /// Remove every commit no branch reaches (mark and sweep from the branch tips)
+    // * drops their events, compressed blocks and cached states
+    // * events still shared with a live graph (e.g. one returned by graphAt)
+    //   stay alive and are not counted
+    // * not recorded in the write-ahead log: open() recovers the commits,
+    //   and the next gc() removes them again
+    GcResult gc();
+
     /// Switch HEAD to the tip of `branchName`, rebuilding the working graph
     void checkout(const std::string& branchName);
 
@@ -81,6 +241,11 @@ public:
 
     /// List all commits on the named branch (from root → tip)
     std::vector<Commit> listCommits(const std::string& branchName) const;
+
+    /// Walk the history of `ref` (a branch name or commit ID) lazily, newest
+    /// first, yielding at most `limit` commits (0: no limit).
+    /// Throws std::runtime_error if `ref` is neither.
+    CommitWalk walkCommits(const std::string& ref, std::size_t limit = 0) const;
     
     /// Return a snapshot of the entire commit DAG: nodes + parent/child edges
     CommitGraph getCommitGraph() const;
@@ -93,11 +258,65 @@ public:
     MergeResult merge(const std::string& branchName,
                     MergePolicy policy = MergePolicy::OURS);
 
+    /// Threads used to classify the deltas of large three-way merges
+    // * 0 (the default) uses std::thread::hardware_concurrency()
+    // * merges with fewer than kParallelMergeMinEvents events run on one thread
+    void setMergeThreads(std::size_t threads) { mergeThreads_ = threads; }
+    static constexpr std::size_t kParallelMergeMinEvents = 1 << 14;
+
+    /// True if `ancestor` is reachable from `descendant` through parent links
+    // * a commit counts as its own ancestor
+    // * the walk never visits commits with a lower generation than `ancestor`
+    bool isAncestor(const std::string& ancestor,
+                    const std::string& descendant) const;
+
+    /**
+     * Best common ancestor of commits `a` and `b` (nullopt if they share none).
+     * Two-coloured walk from both commits in decreasing generation order; the
+     * first commit reached from both sides is returned, so no other common
+     * ancestor is a descendant of it.
+     */
+    std::optional<std::string> mergeBase(const std::string& a,
+                                         const std::string& b) const;
+
+    /// Keep a reachability bitmap for every branch tip
+    // * isAncestor(x, tip) and the fast-forward checks of mergeBase become O(1)
+    // * bitmaps are maintained by commit() and merge(); memory is about
+    //   (#commits / 8) bytes per branch tip
+    void enableReachabilityBitmaps();
+    bool reachabilityBitmapsEnabled() const { return bitmapsEnabled_; }
+
+    /// Keep materialized commit states, up to about `maxBytes` (0 disables, the default)
+    // * the state being left by checkout/merge is cached; switching to a
+    //   cached commit, or to a descendant of one, restores it instead of replaying
+    void setStateCacheLimit(std::size_t maxBytes);
+    const StateCache& stateCache() const { return stateCache_; }
+
+    // ——— Read-only access to any commit ———
+    // * safe to call from any number of threads while one other thread keeps
+    //   using the working tree (mutators, commit, branch, checkout, merge)
+    // * results are immutable and may be shared freely
+
+    /// Full graph state at `commitId`: the nearest cached state on its
+    /// first-parent chain plus the commits after it. The result is cached
+    /// (see setStateCacheLimit). Throws std::runtime_error for unknown commits.
+    std::shared_ptr<const Graph> graphAt(const std::string& commitId) const;
+
+    /// Snapshot of the tip of `branchName` as of `timestamp`.
+    /// Throws std::runtime_error if the branch does not exist.
+    std::shared_ptr<const Snapshot> snapshotAt(const std::string& branchName,
+                                               std::int64_t timestamp) const;
+
     /// Access the current working‐tree graph
-    const Graph& graph() const { return workingGraph_; }
+    const Graph& graph() const;
 
 private:
-    Graph workingGraph_;
+    friend class CommitWalk;
+    // mutable: a repository opened from a pack builds it on first use, so
+    // graph() may have to (see loadWorkingGraph)
+    mutable Graph workingGraph_;
+    mutable bool workingGraphPending_ = false;
+    void loadWorkingGraph() const;
 
     // commit storage: commitId -> Commit
     std::unordered_map<std::string, Commit> commits_;
@@ -109,12 +328,90 @@ private:
     std::string HEAD_commitId_;  
 
     // how many events have been committed into parents already
-    size_t lastCommittedEventIndex_;
+    mutable size_t lastCommittedEventIndex_;
 
-    // helper to gather ancestors in topological order
+    std::size_t mergeThreads_ = 0;
+
+    // events of commits not loaded yet: null unless opened with openPack()
+    std::shared_ptr<PackFile> pack_;
+    EventChunk eventsOf(const Commit& c) const;
+    // events of each of `cids`, reading the missing ones in one pass
+    std::vector<EventChunk> eventsOf(const std::vector<std::string>& cids) const;
+    // commitId -> compressed events of commits made cold by compressColdCommits()
+    std::unordered_map<std::string, std::string> coldEvents_;
+
+    // history compaction: the state at the base commit, and the commits
+    // whose events were folded into it
+    std::string baseCommitId_;
+    std::shared_ptr<const Graph> baseState_;
+    std::unordered_set<std::string> compacted_;
+    // adopt the base read from a pack or a log: `cid` and its ancestors
+    // become compacted
+    void restoreBase(const std::string& cid, std::shared_ptr<const Graph> state);
+    // the first-parent chain of `cid` down to the base (or the root), oldest
+    // first; throws std::runtime_error if it passes below the base
+    std::vector<std::string> chainToBase(const std::string& cid) const;
+
+    // durability: null unless opened with open()
+    std::shared_ptr<WriteAheadLog> wal_;
+    void logCommit(const Commit& c);
+    void logBranch(const std::string& name, const std::string& cid);
+    void logHead(const std::string& name);
+    // replace the log by the records open() needs after a compaction
+    void rewriteWal();
+
+    // dense index per commit (insertion order), used by the bitmaps
+    std::unordered_map<std::string, size_t> commitIndex_;
+    // materialized states of recently visited commits
+    mutable StateCache stateCache_;
+
+    // synchronisation with concurrent graphAt/snapshotAt readers
+    struct Locks {
+        std::shared_mutex history;  // commits_, branches_ and what derives from them
+        std::mutex cache;           // stateCache_
+    };
+    std::unique_ptr<Locks> locks_ = std::make_unique<Locks>();
+    std::shared_ptr<const Graph> cachedState(const std::string& cid) const;
+    void cacheState(const std::string& cid, std::shared_ptr<const Graph> state) const;
+    std::shared_ptr<const Graph> materialize(const std::string& commitId) const;
+
+    // reachability bitmaps of branch tips, when enabled
+    bool bitmapsEnabled_ = false;
+    std::unordered_map<std::string, ReachabilityBitmap> tipBitmaps_;
+    const ReachabilityBitmap& bitmapFor(const std::string& cid);
+    void dropUnreferencedBitmaps();
+
+    // store `c`, assigning its generation from its parents
+    void addCommit(Commit c);
+
+    // helper to gather ancestors in topological order (iterative)
     void buildAncestors(const std::string& cid,
                         std::vector<std::string>& out,
                         std::unordered_set<std::string>& seen) const;
+
+    // first-parent chain (from, to], oldest first; nullopt if `from` is not on it
+    std::optional<std::vector<std::string>>
+    firstParentPath(const std::string& from, const std::string& to) const;
+
+    // nearest commit on the first-parent chain of `b` that is an ancestor of `a`
+    std::string firstParentForkPoint(const std::string& a, const std::string& b) const;
+
+    // nearest commit on both first-parent chains
+    std::string firstParentMeet(const std::string& a, const std::string& b) const;
+
+    // move the working graph from the state at `from` (HEAD) to the state at `to`
+    void moveWorkingGraph(const std::string& from, const std::string& to);
+    // replace the working graph with the state at `cid`
+    void rebuildWorkingGraph(const std::string& cid) const;
+    // replace the working graph with a copy of a cached state
+    void restoreWorkingGraph(const Graph& state);
+    // append and apply the events of `cids` to the working graph
+    void replayCommits(const std::vector<std::string>& cids) const;
+    // the working graph's undo journal covers the newest kUndoCommits commits
+    // on HEAD's first-parent chain; checkouts reaching further back rebuild
+    static constexpr std::size_t kUndoCommits = 64;
+    // drop older undo records; the working log must end at `tip`
+    void trimUndoJournal(const std::string& tip) const;
 };
 
 }  // namespace chronograph
@@ -0,0 +1,57 @@
+// include/chronograph/repo/StateCache.h
+#pragma once
+
+#include <chronograph/graph/Graph.h>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace chronograph {
+
+/// LRU cache of materialized graph states keyed by commit ID
+// * bounded by an estimate of the bytes the cached graphs occupy
+// * entries are immutable and shared: handing one out never copies it
+// * a limit of 0 disables the cache
+class StateCache {
+public:
+    explicit StateCache(std::size_t maxBytes = 0);
+
+    /// Change the byte budget, evicting least recently used entries if needed
+    void setLimit(std::size_t maxBytes);
+    std::size_t limit() const { return maxBytes_; }
+
+    /// Cached state of `commitId` (marks it most recently used), or nullptr
+    std::shared_ptr<const Graph> get(const std::string& commitId);
+    bool contains(const std::string& commitId) const;
+
+    /// Store `state` for `commitId`; states larger than the limit are not kept
+    void put(const std::string& commitId, std::shared_ptr<const Graph> state);
+
+    std::size_t bytes() const { return bytes_; }
+    std::size_t size() const { return lru_.size(); }
+    void clear();
+    /// Drop the state of `commitId`; returns its estimated bytes (0 if absent)
+    std::size_t erase(const std::string& commitId);
+
+    /// Rough heap footprint of a graph: state, unshared events and checkpoints
+    static std::size_t estimateBytes(const Graph& g);
+    /// Rough heap footprint of the events in a chunk
+    static std::size_t estimateBytes(const EventChunk& events);
+
+private:
+    struct Entry {
+        std::string commitId;
+        std::shared_ptr<const Graph> state;
+        std::size_t bytes;
+    };
+    std::size_t maxBytes_;
+    std::size_t bytes_ = 0;
+    std::list<Entry> lru_;  // most recently used first
+    std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+
+    void evictToFit(std::size_t budget);
+};
+
+}  // namespace chronograph
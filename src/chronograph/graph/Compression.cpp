@@ -0,0 +1,259 @@
+// src/Compression.cpp
+#include <chronograph/graph/Compression.h>
+#include <chronograph/graph/EventCodec.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+namespace chronograph {
+
+namespace {
+    constexpr std::size_t kMinMatch = 4;
+    constexpr std::size_t kLastLiterals = 5;   // a block always ends in literals
+    constexpr std::size_t kMaxOffset = 65535;
+    constexpr int kHashBits = 14;
+
+    std::uint32_t read32(const char* p) {
+        std::uint32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    std::uint32_t hashOf(std::uint32_t v) {
+        return (v * 2654435761u) >> (32 - kHashBits);
+    }
+
+    void putLength(std::string& out, std::size_t len) {
+        for (; len >= 255; len -= 255) out.push_back(static_cast<char>(255));
+        out.push_back(static_cast<char>(len));
+    }
+
+    void putSequence(std::string& out, const char* literals, std::size_t litLen,
+                     std::size_t offset, std::size_t matchLen) {
+        const std::size_t m = matchLen ? matchLen - kMinMatch : 0;
+        out.push_back(static_cast<char>((std::min<std::size_t>(litLen, 15) << 4) |
+                                        std::min<std::size_t>(m, 15)));
+        if (litLen >= 15) putLength(out, litLen - 15);
+        out.append(literals, litLen);
+        if (!matchLen) return;
+        out.push_back(static_cast<char>(offset & 0xff));
+        out.push_back(static_cast<char>(offset >> 8));
+        if (m >= 15) putLength(out, m - 15);
+    }
+
+    std::runtime_error malformed(const char* what) {
+        return std::runtime_error(std::string("Compression: malformed input (") + what + ")");
+    }
+
+    std::size_t getLength(const char*& pos, const char* end, std::size_t len) {
+        if (len != 15) return len;
+        for (;;) {
+            if (pos >= end) throw malformed("length");
+            auto byte = static_cast<unsigned char>(*pos++);
+            len += byte;
+            if (byte != 255) return len;
+        }
+    }
+} // anonymous
+
+// ---- LZ ----
+
+std::string lzCompress(const char* data, std::size_t len) {
+    std::string out;
+    out.reserve(len / 2 + 16);
+    putVarint(out, len);
+
+    std::vector<std::uint32_t> table(std::size_t(1) << kHashBits, 0);  // position + 1
+    std::size_t anchor = 0;
+    if (len > kMinMatch + kLastLiterals) {
+        const std::size_t matchEnd = len - kLastLiterals;
+        std::size_t i = 0;
+        while (i + kMinMatch <= matchEnd) {
+            const std::uint32_t seq = read32(data + i);
+            std::uint32_t& slot = table[hashOf(seq)];
+            const std::size_t cand = slot;
+            slot = static_cast<std::uint32_t>(i + 1);
+            if (cand == 0 || i - (cand - 1) > kMaxOffset || read32(data + cand - 1) != seq) {
+                // step faster through incompressible runs
+                i += 1 + ((i - anchor) >> 6);
+                continue;
+            }
+            const std::size_t from = cand - 1;
+            std::size_t m = kMinMatch;
+            while (i + m < matchEnd && data[from + m] == data[i + m]) ++m;
+            putSequence(out, data + anchor, i - anchor, i - from, m);
+            i += m;
+            anchor = i;
+            if (i >= 2 && i - 2 + kMinMatch <= len) {
+                table[hashOf(read32(data + i - 2))] = static_cast<std::uint32_t>(i - 1);
+            }
+        }
+    }
+    putSequence(out, data + anchor, len - anchor, 0, 0);
+    return out;
+}
+
+std::string lzDecompress(const char* data, std::size_t len) {
+    const char* pos = data;
+    const char* end = data + len;
+    const std::uint64_t size = getVarint(pos, end);
+    // no input byte expands to more than 255 output bytes (a 255 length
+    // byte; a minimal match is 3 bytes for 19), so a larger size is a lie
+    if (size > static_cast<std::uint64_t>(end - pos) * 255) throw malformed("size");
+    std::string out(static_cast<std::size_t>(size), '\0');
+    char* dst = out.data();
+    char* const dstEnd = dst + out.size();
+
+    while (pos < end) {
+        const auto token = static_cast<unsigned char>(*pos++);
+        const std::size_t litLen = getLength(pos, end, token >> 4);
+        if (static_cast<std::size_t>(end - pos) < litLen ||
+            static_cast<std::size_t>(dstEnd - dst) < litLen) {
+            throw malformed("literals");
+        }
+        std::memcpy(dst, pos, litLen);
+        dst += litLen;
+        pos += litLen;
+        if (pos == end) break;   // the last sequence has no match
+
+        if (end - pos < 2) throw malformed("offset");
+        const std::size_t offset = static_cast<unsigned char>(pos[0]) |
+                                   (static_cast<std::size_t>(static_cast<unsigned char>(pos[1])) << 8);
+        pos += 2;
+        const std::size_t m = getLength(pos, end, token & 15) + kMinMatch;
+        if (offset == 0 || offset > static_cast<std::size_t>(dst - out.data()) ||
+            static_cast<std::size_t>(dstEnd - dst) < m) {
+            throw malformed("match");
+        }
+        const char* src = dst - offset;
+        if (offset >= m) {
+            std::memcpy(dst, src, m);
+            dst += m;
+        } else {
+            for (std::size_t k = 0; k < m; ++k) *dst++ = src[k];   // overlapping run
+        }
+    }
+    if (dst != dstEnd) throw malformed("size mismatch");
+    return out;
+}
+
+// ---- Events ----
+
+std::string compressEvents(const EventChunk& events) {
+    // 1) number the distinct strings in order of appearance, remembering
+    //    each occurrence, then sort them; rank maps old numbers to sorted ones
+    std::unordered_map<std::string_view, std::uint32_t> seen;
+    seen.reserve(events.size() * 2);
+    std::vector<std::string_view> dict;
+    std::vector<std::uint32_t> refs;
+    refs.reserve(events.size() * 6);
+    auto add = [&](std::string_view s) {
+        auto [it, inserted] = seen.try_emplace(s, static_cast<std::uint32_t>(dict.size()));
+        if (inserted) dict.push_back(s);
+        refs.push_back(it->second);
+    };
+    for (const auto& e : events) {
+        add(e.id);
+        add(e.entityId);
+        for (const auto& [k, v] : e.payload) {
+            add(k);
+            add(v);
+        }
+        add(e.from);
+        add(e.to);
+    }
+    std::vector<std::uint32_t> order(dict.size());
+    for (std::uint32_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::sort(order.begin(), order.end(),
+              [&](std::uint32_t a, std::uint32_t b) { return dict[a] < dict[b]; });
+    std::vector<std::uint64_t> rank(dict.size());
+    for (std::size_t i = 0; i < order.size(); ++i) rank[order[i]] = i;
+
+    // 2) front-coded dictionary, then the events
+    std::string raw;
+    putVarint(raw, events.size());
+    putVarint(raw, dict.size());
+    std::string_view prev;
+    for (auto i : order) {
+        std::string_view s = dict[i];
+        std::size_t shared = 0;
+        while (shared < prev.size() && shared < s.size() && prev[shared] == s[shared]) ++shared;
+        putVarint(raw, shared);
+        putVarint(raw, s.size() - shared);
+        raw.append(s.data() + shared, s.size() - shared);
+        prev = s;
+    }
+    const std::uint32_t* ref = refs.data();   // same order as collected above
+    std::int64_t prevTs = 0, prevEntity = 0;
+    for (const auto& e : events) {
+        raw.push_back(static_cast<char>(e.type));
+        putVarint(raw, zigzagEncode(e.timestamp - prevTs));
+        prevTs = e.timestamp;
+        putVarint(raw, rank[*ref++]);
+        const auto entity = static_cast<std::int64_t>(rank[*ref++]);
+        putVarint(raw, zigzagEncode(entity - prevEntity));
+        prevEntity = entity;
+        putVarint(raw, e.payload.size());
+        for (std::size_t k = 0; k < e.payload.size(); ++k) {
+            putVarint(raw, rank[*ref++]);
+            putVarint(raw, rank[*ref++]);
+        }
+        putVarint(raw, rank[*ref++]);   // from/to: "" for node events, one byte each
+        putVarint(raw, rank[*ref++]);
+    }
+    return lzCompress(raw.data(), raw.size());
+}
+
+std::vector<Event> decompressEvents(const char* data, std::size_t len) {
+    const std::string raw = lzDecompress(data, len);
+    const char* pos = raw.data();
+    const char* end = pos + raw.size();
+
+    const std::uint64_t count = getVarint(pos, end);
+    const std::uint64_t dictSize = getVarint(pos, end);
+    if (count > raw.size() || dictSize > raw.size()) throw malformed("counts");
+    std::vector<std::string> dict(static_cast<std::size_t>(dictSize));
+    for (std::size_t i = 0; i < dict.size(); ++i) {
+        const std::uint64_t shared = getVarint(pos, end);
+        const std::uint64_t rest = getVarint(pos, end);
+        if (i == 0 ? shared != 0 : shared > dict[i - 1].size()) throw malformed("dictionary");
+        if (rest > static_cast<std::uint64_t>(end - pos)) throw malformed("dictionary");
+        dict[i].reserve(shared + rest);
+        if (i > 0) dict[i].assign(dict[i - 1], 0, shared);
+        dict[i].append(pos, rest);
+        pos += rest;
+    }
+    auto word = [&](std::uint64_t n) -> const std::string& {
+        if (n >= dict.size()) throw malformed("string number");
+        return dict[n];
+    };
+
+    std::vector<Event> events(static_cast<std::size_t>(count));
+    std::int64_t prevTs = 0, prevEntity = 0;
+    for (auto& e : events) {
+        if (pos >= end) throw malformed("truncated");
+        const auto type = static_cast<unsigned char>(*pos++);
+        if (type > static_cast<unsigned char>(EventType::UPDATE_EDGE)) throw malformed("event type");
+        e.type = static_cast<EventType>(type);
+        e.timestamp = prevTs + zigzagDecode(getVarint(pos, end));
+        prevTs = e.timestamp;
+        e.id = word(getVarint(pos, end));
+        prevEntity += zigzagDecode(getVarint(pos, end));
+        e.entityId = word(static_cast<std::uint64_t>(prevEntity));
+        const std::uint64_t pairs = getVarint(pos, end);
+        for (std::uint64_t k = 0; k < pairs; ++k) {
+            const std::string& key = word(getVarint(pos, end));
+            e.payload.emplace_hint(e.payload.end(), key, word(getVarint(pos, end)));
+        }
+        e.from = word(getVarint(pos, end));
+        e.to = word(getVarint(pos, end));
+    }
+    if (pos != end) throw malformed("trailing bytes");
+    return events;
+}
+
+}  // namespace chronograph
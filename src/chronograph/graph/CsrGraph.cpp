@@ -0,0 +1,61 @@
+// src/CsrGraph.cpp
+#include <chronograph/graph/CsrGraph.h>
+#include <chronograph/graph/Graph.h>
+#include <chronograph/graph/Snapshot.h>
+
+namespace chronograph {
+
+std::uint32_t CsrGraph::addRow(const std::string& id) {
+    auto [it, inserted] = rowIndex_.emplace(id, static_cast<std::uint32_t>(rowIds_.size()));
+    if (inserted) {
+        rowIds_.push_back(id);
+        rowNode_.push_back(npos);
+    }
+    return it->second;
+}
+
+template <typename G>
+CsrGraph::CsrGraph(const G& g) {
+    using Traits = GraphViewTraits<G>;
+
+    // 1) Rows for every node, in the source's iteration order
+    nodes_.reserve(Traits::nodeCount(g));
+    Traits::forEachNode(g, [&](const Node& n) {
+        std::uint32_t row = addRow(n.id);
+        rowNode_[row] = static_cast<std::uint32_t>(nodes_.size());
+        nodes_.push_back(n);
+    });
+
+    // 2) Edge table; dangling endpoints still get a row so traversals
+    //    through them behave like on the source view
+    Traits::forEachEdge(g, [&](const Edge& e) {
+        edgeIndex_.emplace(e.id, static_cast<std::uint32_t>(edges_.size()));
+        edges_.push_back(e);
+        addRow(e.from);
+        addRow(e.to);
+    });
+
+    // 3) CSR adjacency, preserving each row's source adjacency order
+    auto buildRows = [&](bool outgoing,
+                         std::vector<std::uint32_t>& offsets,
+                         std::vector<std::uint32_t>& targets) {
+        offsets.reserve(rowIds_.size() + 1);
+        targets.reserve(edges_.size());
+        offsets.push_back(0);
+        for (const auto& id : rowIds_) {
+            auto push = [&](const Edge& e) {
+                targets.push_back(edgeIndex_.at(e.id));
+            };
+            if (outgoing) Traits::forEachOutEdge(g, id, push);
+            else          Traits::forEachInEdge(g, id, push);
+            offsets.push_back(static_cast<std::uint32_t>(targets.size()));
+        }
+    };
+    buildRows(true,  outOffsets_, outEdges_);
+    buildRows(false, inOffsets_,  inEdges_);
+}
+
+template CsrGraph::CsrGraph(const Graph&);
+template CsrGraph::CsrGraph(const Snapshot&);
+
+}  // namespace chronograph
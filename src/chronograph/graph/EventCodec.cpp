@@ -0,0 +1,105 @@
+// src/EventCodec.cpp
+#include <chronograph/graph/EventCodec.h>
+#include <stdexcept>
+
+namespace chronograph {
+namespace {
+    void need(const char* pos, const char* end, std::size_t n) {
+        if (static_cast<std::size_t>(end - pos) < n) {
+            throw std::runtime_error("EventCodec: truncated input");
+        }
+    }
+} // anonymous
+
+void putU32(std::string& out, std::uint32_t v) {
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<char>((v >> (8 * i)) & 0xff));
+}
+
+void putU64(std::string& out, std::uint64_t v) {
+    for (int i = 0; i < 8; ++i) out.push_back(static_cast<char>((v >> (8 * i)) & 0xff));
+}
+
+void putString(std::string& out, const std::string& s) {
+    putU32(out, static_cast<std::uint32_t>(s.size()));
+    out.append(s);
+}
+
+void putVarint(std::string& out, std::uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<char>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<char>(v));
+}
+
+void encodeEvent(const Event& e, std::string& out) {
+    putString(out, e.id);
+    putU64(out, static_cast<std::uint64_t>(e.timestamp));
+    out.push_back(static_cast<char>(e.type));
+    putString(out, e.entityId);
+    putU32(out, static_cast<std::uint32_t>(e.payload.size()));
+    for (const auto& [k, v] : e.payload) {
+        putString(out, k);
+        putString(out, v);
+    }
+    putString(out, e.from);
+    putString(out, e.to);
+}
+
+std::uint32_t getU32(const char*& pos, const char* end) {
+    need(pos, end, 4);
+    std::uint32_t v = 0;
+    for (int i = 3; i >= 0; --i) v = (v << 8) | static_cast<unsigned char>(pos[i]);
+    pos += 4;
+    return v;
+}
+
+std::uint64_t getU64(const char*& pos, const char* end) {
+    need(pos, end, 8);
+    std::uint64_t v = 0;
+    for (int i = 7; i >= 0; --i) v = (v << 8) | static_cast<unsigned char>(pos[i]);
+    pos += 8;
+    return v;
+}
+
+std::uint64_t getVarint(const char*& pos, const char* end) {
+    std::uint64_t v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        need(pos, end, 1);
+        auto byte = static_cast<unsigned char>(*pos++);
+        v |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) return v;
+    }
+    throw std::runtime_error("EventCodec: malformed varint");
+}
+
+std::string getString(const char*& pos, const char* end) {
+    std::uint32_t n = getU32(pos, end);
+    need(pos, end, n);
+    std::string s(pos, n);
+    pos += n;
+    return s;
+}
+
+Event decodeEvent(const char*& pos, const char* end) {
+    Event e;
+    e.id = getString(pos, end);
+    e.timestamp = static_cast<std::int64_t>(getU64(pos, end));
+    need(pos, end, 1);
+    auto type = static_cast<unsigned char>(*pos++);
+    if (type > static_cast<unsigned char>(EventType::UPDATE_EDGE)) {
+        throw std::runtime_error("decodeEvent: unknown event type");
+    }
+    e.type = static_cast<EventType>(type);
+    e.entityId = getString(pos, end);
+    std::uint32_t n = getU32(pos, end);
+    for (std::uint32_t i = 0; i < n; ++i) {
+        std::string k = getString(pos, end);
+        e.payload.emplace_hint(e.payload.end(), std::move(k), getString(pos, end));
+    }
+    e.from = getString(pos, end);
+    e.to = getString(pos, end);
+    return e;
+}
+
+}  // namespace chronograph
@@ -0,0 +1,136 @@
+// src/EventLog.cpp
+#include <chronograph/graph/EventLog.h>
+#include <algorithm>
+
+namespace chronograph {
+
+void EventLog::const_iterator::seek() {
+    if (!log_ || index_ >= log_->size()) {
+        cur_ = segmentEnd_ = nullptr;
+        return;
+    }
+    if (index_ >= log_->sealedSize_) {
+        const auto& tail = log_->tail_;
+        cur_ = tail.data() + (index_ - log_->sealedSize_);
+        segmentEnd_ = tail.data() + tail.size();
+        return;
+    }
+    size_type k = log_->chunkOf(index_);
+    const EventChunk& chunk = log_->chunks_[k];
+    cur_ = chunk.begin() + (index_ - log_->starts_[k]);
+    segmentEnd_ = chunk.end();
+}
+
+EventLog::size_type EventLog::chunkOf(size_type i) const {
+    auto it = std::upper_bound(starts_.begin(), starts_.end(), i);
+    return static_cast<size_type>(it - starts_.begin()) - 1;
+}
+
+const Event& EventLog::operator[](size_type i) const {
+    if (i >= sealedSize_) return tail_[i - sealedSize_];
+    size_type k = chunkOf(i);
+    return chunks_[k][i - starts_[k]];
+}
+
+void EventLog::seal() {
+    if (tail_.empty()) return;
+    EventChunk chunk(std::move(tail_));
+    tail_.clear();
+    starts_.push_back(sealedSize_);
+    sealedSize_ += chunk.size();
+    chunks_.push_back(std::move(chunk));
+}
+
+void EventLog::append(const EventChunk& chunk) {
+    if (chunk.empty()) return;
+    seal();
+    starts_.push_back(sealedSize_);
+    sealedSize_ += chunk.size();
+    chunks_.push_back(chunk);
+}
+
+EventChunk EventLog::share(size_type from) {
+    seal();
+    if (from >= sealedSize_) return {};
+    size_type k = chunkOf(from);
+    if (k + 1 == chunks_.size()) {
+        return chunks_[k].slice(from - starts_[k], chunks_[k].size());
+    }
+    std::vector<Event> copy;
+    copy.reserve(sealedSize_ - from);
+    for (auto it = begin() + from; it != end(); ++it) copy.push_back(*it);
+    // re-point the log at the merged chunk so the events stay stored once
+    EventChunk merged(std::move(copy));
+    truncate(from);
+    append(merged);
+    return merged;
+}
+
+void EventLog::truncate(size_type n) {
+    if (n >= size()) return;
+    if (n >= sealedSize_) {
+        tail_.erase(tail_.begin() + (n - sealedSize_), tail_.end());
+        return;
+    }
+    tail_.clear();
+    size_type k = chunkOf(n);
+    chunks_.resize(k + 1);
+    starts_.resize(k + 1);
+    if (n == starts_[k]) {
+        chunks_.pop_back();
+        starts_.pop_back();
+    } else {
+        chunks_[k] = chunks_[k].slice(0, n - starts_[k]);
+    }
+    sealedSize_ = n;
+}
+
+std::vector<EventChunk> EventLog::sealedChunks(size_type from) const {
+    std::vector<EventChunk> out;
+    if (from >= sealedSize_) return out;
+    size_type k = chunkOf(from);
+    out.push_back(chunks_[k].slice(from - starts_[k], chunks_[k].size()));
+    out.insert(out.end(), chunks_.begin() + k + 1, chunks_.end());
+    return out;
+}
+
+void EventLog::dropFront(size_type n) {
+    if (n == 0) return;
+    if (n >= size()) {
+        clear();
+        return;
+    }
+    if (n >= sealedSize_) {
+        tail_.erase(tail_.begin(), tail_.begin() + (n - sealedSize_));
+        chunks_.clear();
+        starts_.clear();
+        sealedSize_ = 0;
+        return;
+    }
+    size_type k = chunkOf(n);
+    std::vector<EventChunk> kept;
+    EventChunk first = chunks_[k].slice(n - starts_[k], chunks_[k].size());
+    if (first.size() < chunks_[k].size() / 2) {
+        // a small remainder would pin the whole chunk: copy it out
+        first = EventChunk(std::vector<Event>(first.begin(), first.end()));
+    }
+    kept.push_back(std::move(first));
+    kept.insert(kept.end(), chunks_.begin() + k + 1, chunks_.end());
+    chunks_.clear();
+    starts_.clear();
+    sealedSize_ = 0;
+    for (auto& chunk : kept) {
+        starts_.push_back(sealedSize_);
+        sealedSize_ += chunk.size();
+        chunks_.push_back(std::move(chunk));
+    }
+}
+
+void EventLog::clear() {
+    chunks_.clear();
+    starts_.clear();
+    sealedSize_ = 0;
+    tail_.clear();
+}
+
+}  // namespace chronograph
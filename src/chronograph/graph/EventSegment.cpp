@@ -0,0 +1,281 @@
+// src/EventSegment.cpp
+#include <chronograph/graph/EventSegment.h>
+#include <chronograph/graph/EventCodec.h>
+#include <chronograph/graph/FileSync.h>
+
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace chronograph {
+
+namespace {
+    constexpr char kMagic[8] = {'C','G','S','E','G','0','0','1'};
+    constexpr std::size_t kHeaderBytes = 64;
+
+    std::uint64_t load64(const char* p) {
+        std::uint64_t v = 0;
+        for (int i = 7; i >= 0; --i) v = (v << 8) | static_cast<unsigned char>(p[i]);
+        return v;
+    }
+
+    bool isEdgeEvent(EventType t) {
+        return t == EventType::ADD_EDGE || t == EventType::DEL_EDGE ||
+               t == EventType::UPDATE_EDGE;
+    }
+
+    std::runtime_error corrupt(const char* what) {
+        return std::runtime_error(std::string("EventSegment: corrupt segment (") + what + ")");
+    }
+} // anonymous
+
+// ---- Writing ----
+
+void EventSegment::write(const std::string& path, const EventLog& events) {
+    // 1) Intern every string; views point into `events`, which outlives this call
+    std::unordered_map<std::string_view, std::uint32_t> interned;
+    std::vector<std::string_view> strings;
+    auto intern = [&](std::string_view s) {
+        auto [it, inserted] = interned.emplace(s, static_cast<std::uint32_t>(strings.size()));
+        if (inserted) strings.push_back(s);
+        return it->second;
+    };
+
+    // 2) Records, restarting timestamp deltas at every block
+    std::string records, blocks;
+    std::int64_t prev = 0;
+    std::int64_t minTs = std::numeric_limits<std::int64_t>::max();
+    std::int64_t maxTs = std::numeric_limits<std::int64_t>::min();
+    std::size_t index = 0;
+    for (const auto& e : events) {
+        if (index % kBlockEvents == 0) {
+            putU64(blocks, records.size());
+            putU64(blocks, static_cast<std::uint64_t>(e.timestamp));
+            prev = 0;
+        }
+        records.push_back(static_cast<char>(e.type));
+        putVarint(records, zigzagEncode(e.timestamp - prev));
+        prev = e.timestamp;
+        putVarint(records, intern(e.id));
+        putVarint(records, intern(e.entityId));
+        putVarint(records, e.payload.size());
+        for (const auto& [k, v] : e.payload) {
+            putVarint(records, intern(k));
+            putVarint(records, intern(v));
+        }
+        if (isEdgeEvent(e.type)) {
+            putVarint(records, intern(e.from));
+            putVarint(records, intern(e.to));
+        }
+        minTs = std::min(minTs, e.timestamp);
+        maxTs = std::max(maxTs, e.timestamp);
+        ++index;
+    }
+    if (index == 0) minTs = maxTs = 0;
+
+    // 3) String table
+    std::string table;
+    std::uint64_t offset = 0;
+    for (auto s : strings) {
+        putU64(table, offset);
+        offset += s.size();
+    }
+    putU64(table, offset);
+    for (auto s : strings) table.append(s.data(), s.size());
+
+    // 4) Header
+    const std::uint64_t stringsAt = kHeaderBytes;
+    const std::uint64_t recordsAt = stringsAt + table.size();
+    const std::uint64_t blocksAt = recordsAt + records.size();
+    std::string header(kMagic, sizeof(kMagic));
+    putU64(header, index);
+    putU64(header, strings.size());
+    putU64(header, stringsAt);
+    putU64(header, recordsAt);
+    putU64(header, blocksAt);
+    putU64(header, static_cast<std::uint64_t>(minTs));
+    putU64(header, static_cast<std::uint64_t>(maxTs));
+
+    replaceFile(path, {header, table, records, blocks});
+    syncParentDirectory(path);
+}
+
+// ---- Mapping ----
+
+EventSegment::EventSegment(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("EventSegment: cannot open '" + path + "': " + std::strerror(errno));
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < kHeaderBytes) {
+        ::close(fd);
+        throw std::runtime_error("EventSegment: '" + path + "' is not a segment");
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+    void* p = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        throw std::runtime_error("EventSegment: cannot map '" + path + "': " + std::strerror(errno));
+    }
+    base_ = static_cast<const char*>(p);
+
+    if (std::memcmp(base_, kMagic, sizeof(kMagic)) != 0) {
+        unmap();
+        throw std::runtime_error("EventSegment: '" + path + "' is not a segment");
+    }
+    eventCount_ = load64(base_ + 8);
+    stringCount_ = load64(base_ + 16);
+    const std::uint64_t stringsAt = load64(base_ + 24);
+    const std::uint64_t recordsAt = load64(base_ + 32);
+    const std::uint64_t blocksAt = load64(base_ + 40);
+    minTimestamp_ = static_cast<std::int64_t>(load64(base_ + 48));
+    maxTimestamp_ = static_cast<std::int64_t>(load64(base_ + 56));
+
+    const std::uint64_t blockCount = (eventCount_ + kBlockEvents - 1) / kBlockEvents;
+    const std::uint64_t tableBytes = (stringCount_ + 1) * 8;
+    if (stringsAt != kHeaderBytes || stringsAt + tableBytes > recordsAt ||
+        recordsAt > blocksAt || blocksAt + blockCount * 16 != size_ ||
+        stringCount_ > size_ || eventCount_ > size_) {
+        unmap();
+        throw corrupt("header");
+    }
+    offsets_ = base_ + stringsAt;
+    blob_ = offsets_ + tableBytes;
+    if (load64(offsets_ + stringCount_ * 8) != recordsAt - stringsAt - tableBytes) {
+        unmap();
+        throw corrupt("string table");
+    }
+    records_ = base_ + recordsAt;
+    recordsEnd_ = base_ + blocksAt;
+    blocks_ = base_ + blocksAt;
+}
+
+EventSegment::~EventSegment() {
+    unmap();
+}
+
+EventSegment::EventSegment(EventSegment&& other) noexcept {
+    *this = std::move(other);
+}
+
+EventSegment& EventSegment::operator=(EventSegment&& other) noexcept {
+    if (this != &other) {
+        unmap();
+        base_ = std::exchange(other.base_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        eventCount_ = std::exchange(other.eventCount_, 0);
+        stringCount_ = std::exchange(other.stringCount_, 0);
+        offsets_ = other.offsets_;
+        blob_ = other.blob_;
+        records_ = other.records_;
+        recordsEnd_ = other.recordsEnd_;
+        blocks_ = other.blocks_;
+        minTimestamp_ = other.minTimestamp_;
+        maxTimestamp_ = other.maxTimestamp_;
+    }
+    return *this;
+}
+
+void EventSegment::unmap() {
+    if (base_) ::munmap(const_cast<char*>(base_), size_);
+    base_ = nullptr;
+}
+
+// ---- Reading ----
+
+std::string_view EventSegment::string(std::uint32_t index) const {
+    if (index >= stringCount_) throw corrupt("string number");
+    const std::uint64_t from = load64(offsets_ + index * 8);
+    const std::uint64_t to = load64(offsets_ + (index + 1) * 8);
+    if (from > to || blob_ + to > records_) throw corrupt("string offsets");
+    return std::string_view(blob_ + from, to - from);
+}
+
+std::uint64_t EventSegment::readVarint(const char*& pos) const {
+    std::uint64_t v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (pos >= recordsEnd_) throw corrupt("truncated record");
+        auto byte = static_cast<unsigned char>(*pos++);
+        v |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) return v;
+    }
+    throw corrupt("varint");
+}
+
+std::string_view EventSegment::readString(const char*& pos) const {
+    std::uint64_t index = readVarint(pos);
+    if (index > std::numeric_limits<std::uint32_t>::max()) throw corrupt("string number");
+    return string(static_cast<std::uint32_t>(index));
+}
+
+EventSegment::Cursor::Cursor(const EventSegment* seg, std::size_t index)
+    : seg_(seg), index_(std::min(index, seg->eventCount_)), pos_(seg->recordsEnd_), prevTimestamp_(0)
+{
+    if (index_ == seg_->eventCount_) return;
+    // jump to the block holding `index`, then skip forward within it
+    const std::size_t block = index_ / kBlockEvents;
+    const std::uint64_t offset = load64(seg_->blocks_ + block * 16);
+    if (seg_->records_ + offset >= seg_->recordsEnd_) throw corrupt("block index");
+    pos_ = seg_->records_ + offset;
+    index_ = block * kBlockEvents;
+    EventView skipped;
+    while (index_ < index) next(skipped);
+}
+
+bool EventSegment::Cursor::next(EventView& out) {
+    if (index_ >= seg_->eventCount_) return false;
+    if (index_ % kBlockEvents == 0) prevTimestamp_ = 0;
+    if (pos_ >= seg_->recordsEnd_) throw corrupt("truncated record");
+
+    auto type = static_cast<unsigned char>(*pos_++);
+    if (type > static_cast<unsigned char>(EventType::UPDATE_EDGE)) throw corrupt("event type");
+    out.type = static_cast<EventType>(type);
+    out.timestamp = prevTimestamp_ + zigzagDecode(seg_->readVarint(pos_));
+    prevTimestamp_ = out.timestamp;
+    out.id = seg_->readString(pos_);
+    out.entityId = seg_->readString(pos_);
+
+    // payload is decoded lazily; skip over it here
+    out.payload.seg_ = seg_;
+    out.payload.count_ = seg_->readVarint(pos_);
+    out.payload.pos_ = pos_;
+    for (std::size_t i = 0; i < 2 * out.payload.count_; ++i) seg_->readVarint(pos_);
+
+    if (isEdgeEvent(out.type)) {
+        out.from = seg_->readString(pos_);
+        out.to = seg_->readString(pos_);
+    } else {
+        out.from = out.to = std::string_view();
+    }
+    ++index_;
+    return true;
+}
+
+void PayloadView::iterator::load() {
+    if (left_ == 0) return;
+    current_.first = seg_->readString(pos_);
+    current_.second = seg_->readString(pos_);
+}
+
+Event EventSegment::toEvent(const EventView& view) {
+    Event e;
+    e.id = std::string(view.id);
+    e.timestamp = view.timestamp;
+    e.type = view.type;
+    e.entityId = std::string(view.entityId);
+    for (const auto& [k, v] : view.payload) e.payload.emplace(std::string(k), std::string(v));
+    e.from = std::string(view.from);
+    e.to = std::string(view.to);
+    return e;
+}
+
+}  // namespace chronograph
@@ -0,0 +1,73 @@
+// src/FileSync.cpp
+#include <chronograph/graph/FileSync.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace chronograph {
+
+namespace {
+    std::runtime_error ioError(const std::string& what, const std::string& path) {
+        return std::runtime_error("FileSync: " + what + " '" + path + "': " + std::strerror(errno));
+    }
+
+    void syncFd(int fd, const std::string& path) {
+        int rc;
+        do { rc = ::fsync(fd); } while (rc != 0 && errno == EINTR);
+        if (rc != 0) throw ioError("cannot fsync", path);
+    }
+
+    void writeAll(int fd, std::string_view bytes, const std::string& path) {
+        while (!bytes.empty()) {
+            ssize_t n = ::write(fd, bytes.data(), bytes.size());
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) throw ioError("cannot write", path);
+            bytes.remove_prefix(static_cast<std::size_t>(n));
+        }
+    }
+} // anonymous
+
+void replaceFile(const std::string& path, std::initializer_list<std::string_view> pieces) {
+    const std::string tmp = path + ".tmp";
+    int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) throw ioError("cannot create", tmp);
+    try {
+        for (auto piece : pieces) writeAll(fd, piece, tmp);
+        syncFd(fd, tmp);
+    } catch (...) {
+        ::close(fd);
+        ::unlink(tmp.c_str());
+        throw;
+    }
+    ::close(fd);
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+        const auto error = ioError("cannot rename '" + tmp + "' to", path);
+        ::unlink(tmp.c_str());
+        throw error;
+    }
+}
+
+void syncDirectory(const std::string& dir) {
+    int fd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) throw ioError("cannot open", dir);
+    try {
+        syncFd(fd, dir);
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+    ::close(fd);
+}
+
+void syncParentDirectory(const std::string& path) {
+    std::string dir = std::filesystem::path(path).parent_path().string();
+    syncDirectory(dir.empty() ? "." : dir);
+}
+
+}  // namespace chronograph
@@ -4,50 +4,306 @@
 #include <chronograph/graph/Node.h>
 #include <chronograph/graph/Edge.h>
 #include <chronograph/graph/Snapshot.h>
+#include <chronograph/graph/EventCodec.h>
+#include <chronograph/graph/EventSegment.h>
+#include <chronograph/graph/WriteAheadLog.h>
 
 #include <random>
-#include <sstream>
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 #include <string>
 
 namespace chronograph {
 
-//––– Helper to make a quick unique ID for each Event –––
-// TODO: replace this with alternative UUID library
 namespace {
+    /// Random 60-bit event ID as 15 hex digits
+    // * one generator per thread, so concurrent graphs never share state
+    // * 15 characters fit the small-string buffer: no heap allocation
     std::string generateEventId() {
-        static std::mt19937_64 rng(std::random_device{}());
-        static std::uniform_int_distribution<uint64_t> dist;
-        std::ostringstream ss;
-        ss << std::hex << dist(rng);
-        return ss.str();
+        thread_local std::mt19937_64 rng(std::random_device{}());
+        static const char digits[] = "0123456789abcdef";
+        char buf[15];
+        std::uint64_t v = rng();
+        for (char& c : buf) {
+            c = digits[v & 0xf];
+            v >>= 4;
+        }
+        return std::string(buf, sizeof(buf));
+    }
+
+    // Parse a whole attribute value as a number (for ORDERED indexes)
+    std::optional<double> parseNumber(const std::string& s) {
+        if (s.empty()) return std::nullopt;
+        char* end = nullptr;
+        double v = std::strtod(s.c_str(), &end);
+        if (end != s.c_str() + s.size() || std::isnan(v)) return std::nullopt;
+        return v;
+    }
+
+    std::vector<std::string> sortedIds(const std::unordered_set<std::string>& ids) {
+        std::vector<std::string> out(ids.begin(), ids.end());
+        std::sort(out.begin(), out.end());
+        return out;
     }
 } // anonymous
 
+std::uint64_t Graph::nextVersion() {
+    static std::atomic<std::uint64_t> counter{0};
+    return ++counter;
+}
+
+std::uint64_t Graph::version() const {
+    return version_;
+}
+
 void Graph::addEvent(const Event& event) {
+    if (wal_.ptr) wal_.ptr->appendEvent(event);
     eventLog_.push_back(event);
+    bumpVersion();
     // after state update in each mutator, call:
     // maybeCreateCheckpoint(event);
 }
-const std::vector<Event>& Graph::getEventLog() const { 
+const EventLog& Graph::getEventLog() const { 
     return eventLog_; 
 }
+EventChunk Graph::shareEvents(size_t from) {
+    return eventLog_.share(from);
+}
 const std::vector<Graph::Checkpoint>& Graph::getCheckpoints() const { 
     return checkpoints_; 
 }
 void Graph::maybeCreateCheckpoint(const Event& e) {
     if (eventLog_.size() % kCheckpointInterval == 0) {
-        checkpoints_.push_back({
-            /*timestamp=*/e.timestamp,
-            /*eventIndex=*/eventLog_.size(),
-            /*nodes=*/nodes_,
-            /*edges=*/edges_,
-            /*outgoing=*/outgoing_,
-            /*incoming=*/incoming_
-        });
+        createCheckpoint(e.timestamp, eventLog_.size());
+    }
+}
+void Graph::createCheckpoint(std::int64_t timestamp, size_t eventIndex) {
+    checkpoints_.push_back({
+        /*timestamp=*/timestamp,
+        /*eventIndex=*/eventIndex,
+        /*nodes=*/nodes_,
+        /*edges=*/edges_,
+        /*outgoing=*/outgoing_,
+        /*incoming=*/incoming_
+    });
+}
+
+// ---- Compaction ----
+
+size_t Graph::compact(std::int64_t horizonTs, const std::string& archivePath) {
+    size_t n = 0;
+    for (auto it = eventLog_.begin(); it != eventLog_.end() && it->timestamp < horizonTs; ++it) {
+        ++n;
+    }
+    if (n == 0) return 0;
+    if (!archivePath.empty()) {
+        EventLog folded = eventLog_;   // shares the chunks
+        folded.truncate(n);
+        EventSegment::write(archivePath, folded);
+    }
+    compactEvents(n);
+    return n;
+}
+
+void Graph::compactEvents(size_t eventCount) {
+    if (eventCount > eventLog_.size()) {
+        throw std::invalid_argument("compactEvents: event count beyond end of log");
+    }
+    if (eventCount == 0) return;
+
+    // 1) the state after `eventCount` events: the live state if that is the
+    //    whole log, else the nearest checkpoint before it plus the events after it
+    Checkpoint base{ compactionHorizon(), 0, {}, {}, {}, {} };
+    for (auto it = eventLog_.begin(); it != eventLog_.begin() + eventCount; ++it) {
+        base.timestamp = std::max(base.timestamp, it->timestamp);
+    }
+    if (eventCount == eventLog_.size()) {
+        base.nodes = nodes_;
+        base.edges = edges_;
+        base.outgoing = outgoing_;
+        base.incoming = incoming_;
+    } else {
+        Graph scratch;
+        size_t from = 0;
+        for (auto it = checkpoints_.rbegin(); it != checkpoints_.rend(); ++it) {
+            if (it->eventIndex <= eventCount) {
+                scratch.nodes_ = it->nodes;
+                scratch.edges_ = it->edges;
+                scratch.outgoing_ = it->outgoing;
+                scratch.incoming_ = it->incoming;
+                from = it->eventIndex;
+                break;
+            }
+        }
+        for (auto it = eventLog_.begin() + from; it != eventLog_.begin() + eventCount; ++it) {
+            scratch.applyEvent(*it);
+        }
+        base.nodes = std::move(scratch.nodes_);
+        base.edges = std::move(scratch.edges_);
+        base.outgoing = std::move(scratch.outgoing_);
+        base.incoming = std::move(scratch.incoming_);
+    }
+
+    // 2) later checkpoints stay valid once their indexes are shifted
+    std::vector<Checkpoint> kept;
+    kept.push_back(std::move(base));
+    for (auto& cp : checkpoints_) {
+        if (cp.eventIndex > eventCount) {
+            cp.eventIndex -= eventCount;
+            kept.push_back(std::move(cp));
+        }
+    }
+    checkpoints_ = std::move(kept);
+
+    // 3) the log and the undo records of the remaining events
+    eventLog_.dropFront(eventCount);
+    undoLog_.erase(
+        std::remove_if(undoLog_.begin(), undoLog_.end(),
+                       [&](const UndoRecord& r) { return r.logSize <= eventCount; }),
+        undoLog_.end());
+    for (auto& r : undoLog_) r.logSize -= eventCount;
+    journalStart_ = journalStart_ > eventCount ? journalStart_ - eventCount : 0;
+
+    compactedEvents_ += eventCount;
+    bumpVersion();
+}
+
+std::int64_t Graph::compactionHorizon() const {
+    return compactedEvents_ ? checkpoints_.front().timestamp
+                            : std::numeric_limits<std::int64_t>::min();
+}
+
+Graph Graph::baseState() const {
+    Graph g;
+    if (compactedEvents_) {
+        const Checkpoint& base = checkpoints_.front();
+        g.nodes_ = base.nodes;
+        g.edges_ = base.edges;
+        g.outgoing_ = base.outgoing;
+        g.incoming_ = base.incoming;
+    }
+    return g;
+}
+
+namespace {
+    void putAttributes(std::string& out, const std::map<std::string, std::string>& attrs) {
+        putU32(out, static_cast<std::uint32_t>(attrs.size()));
+        for (const auto& [k, v] : attrs) {
+            putString(out, k);
+            putString(out, v);
+        }
+    }
+    std::map<std::string, std::string> getAttributes(const char*& pos, const char* end) {
+        std::map<std::string, std::string> attrs;
+        for (std::uint32_t n = getU32(pos, end); n > 0; --n) {
+            std::string k = getString(pos, end);
+            attrs.emplace_hint(attrs.end(), std::move(k), getString(pos, end));
+        }
+        return attrs;
+    }
+    template <class Map>
+    std::vector<const typename Map::value_type*> byKey(const Map& map) {
+        std::vector<const typename Map::value_type*> out;
+        out.reserve(map.size());
+        for (const auto& entry : map) out.push_back(&entry);
+        std::sort(out.begin(), out.end(), [](auto* a, auto* b) { return a->first < b->first; });
+        return out;
+    }
+} // anonymous
+
+void Graph::encodeBase(std::string& out) const {
+    static const Checkpoint empty{ std::numeric_limits<std::int64_t>::min(), 0, {}, {}, {}, {} };
+    const Checkpoint& base = compactedEvents_ ? checkpoints_.front() : empty;
+    putU64(out, compactedEvents_);
+    putU64(out, static_cast<std::uint64_t>(base.timestamp));
+    putU64(out, base.nodes.size());
+    for (const auto* node : byKey(base.nodes)) {
+        putString(out, node->first);
+        putAttributes(out, node->second.attributes);
+    }
+    putU64(out, base.edges.size());
+    for (const auto* edge : byKey(base.edges)) {
+        putString(out, edge->first);
+        putString(out, edge->second.from);
+        putString(out, edge->second.to);
+        putU64(out, static_cast<std::uint64_t>(edge->second.createdTimestamp));
+        putAttributes(out, edge->second.attributes);
     }
+    for (const auto* adj : { &base.outgoing, &base.incoming }) {
+        putU64(out, adj->size());
+        for (const auto* list : byKey(*adj)) {
+            putString(out, list->first);
+            putU32(out, static_cast<std::uint32_t>(list->second.size()));
+            for (const auto& eid : list->second) putString(out, eid);
+        }
+    }
+}
+
+Graph Graph::decodeBase(const char*& pos, const char* end) {
+    Graph g;
+    g.compactedEvents_ = static_cast<size_t>(getU64(pos, end));
+    Checkpoint base{ static_cast<std::int64_t>(getU64(pos, end)), 0, {}, {}, {}, {} };
+    for (std::uint64_t n = getU64(pos, end); n > 0; --n) {
+        std::string id = getString(pos, end);
+        base.nodes.emplace(id, Node{ id, getAttributes(pos, end) });
+    }
+    for (std::uint64_t n = getU64(pos, end); n > 0; --n) {
+        Edge e;
+        e.id = getString(pos, end);
+        e.from = getString(pos, end);
+        e.to = getString(pos, end);
+        e.createdTimestamp = static_cast<std::int64_t>(getU64(pos, end));
+        e.attributes = getAttributes(pos, end);
+        std::string id = e.id;
+        base.edges.emplace(std::move(id), std::move(e));
+    }
+    for (auto* adj : { &base.outgoing, &base.incoming }) {
+        for (std::uint64_t n = getU64(pos, end); n > 0; --n) {
+            std::string id = getString(pos, end);
+            std::vector<std::string> list;
+            for (std::uint32_t k = getU32(pos, end); k > 0; --k) list.push_back(getString(pos, end));
+            adj->emplace(std::move(id), std::move(list));
+        }
+    }
+    if (!g.compactedEvents_) return g;
+    g.nodes_ = base.nodes;
+    g.edges_ = base.edges;
+    g.outgoing_ = base.outgoing;
+    g.incoming_ = base.incoming;
+    g.checkpoints_.push_back(std::move(base));
+    return g;
+}
+
+// ---- Durability ----
+
+void Graph::attachWal(std::shared_ptr<WriteAheadLog> wal) {
+    wal_.ptr = std::move(wal);
+}
+
+Graph Graph::recover(const std::string& walPath) {
+    std::vector<Event> events;
+    for (const auto& rec : WriteAheadLog::read(walPath).records) {
+        if (rec.type != WriteAheadLog::RecordType::EVENT) continue;
+        const char* pos = rec.payload.data();
+        events.push_back(decodeEvent(pos, pos + rec.payload.size()));
+    }
+
+    Graph g;
+    EventChunk chunk(std::move(events));
+    g.eventLog_.append(chunk);
+    for (size_t i = 0; i < chunk.size(); ++i) {
+        g.applyEventAt(chunk[i], i + 1);
+        if ((i + 1) % kCheckpointInterval == 0) {
+            g.createCheckpoint(chunk[i].timestamp, i + 1);
+        }
+    }
+    return g;
 }
 
 void Graph::addNode(const std::string& id,
@@ -61,13 +317,16 @@ void Graph::addNode(const std::string& id,
     e.entityId = id;
     e.payload = attrs;
     addEvent(e);
+    UndoRecord* r = recordUndo(e, eventLog_.size());
 
     // Update graph state
+    auto before = indexedValues(id);
     nodes_[id] = Node{id, attrs};
+    reindexNode(id, before, timestamp);
 
     // TODO: properly update adjacency lists
-    outgoing_.emplace(id, std::vector<std::string>{});
-    incoming_.emplace(id, std::vector<std::string>{});
+    adjList(r, true, id);
+    adjList(r, false, id);
     maybeCreateCheckpoint(e);
 }
 
@@ -78,6 +337,7 @@ void Graph::delNode(const std::string& id, std::int64_t timestamp) {
     e.type = EventType::DEL_NODE;
     e.entityId = id;
     addEvent(e);
+    recordUndo(e, eventLog_.size());
 
     // Delete all outgoing edges
     if (auto oit = outgoing_.find(id); oit != outgoing_.end()) {
@@ -101,9 +361,13 @@ void Graph::delNode(const std::string& id, std::int64_t timestamp) {
     }
 
     // Erase the node itself and its adjacency lists
+    auto before = indexedValues(id);
     nodes_.erase(id);
-    outgoing_.erase(id);
-    incoming_.erase(id);
+    reindexNode(id, before, timestamp);
+    // journaled last, so it is undone before the cascade
+    UndoRecord* r = journalEnabled_ ? &undoLog_.back() : nullptr;
+    adjErase(r, true, id);
+    adjErase(r, false, id);
 
     maybeCreateCheckpoint(e);
 }
@@ -123,11 +387,12 @@ void Graph::addEdge(const std::string& id,
     e.from = from;
     e.to = to;
     addEvent(e);
+    UndoRecord* r = recordUndo(e, eventLog_.size());
     // Store the edge
     edges_[id] = Edge{id, from, to, attrs, timestamp};
     // Update adjacency
-    outgoing_[from].push_back(id);
-    incoming_[to].push_back(id);
+    adjAppend(r, true, from, id);
+    adjAppend(r, false, to, id);
 
     maybeCreateCheckpoint(e);
 }
@@ -149,18 +414,13 @@ void Graph::delEdge(const std::string& id, std::int64_t timestamp) {
     e.to = to;
     // no payload for deletions
     addEvent(e);
+    UndoRecord* r = recordUndo(e, eventLog_.size());
 
     edges_.erase(it);
 
-    // remove from outgoing[from]
-    auto& outList = outgoing_[from];
-    outList.erase(std::remove(outList.begin(), outList.end(), id),
-                  outList.end());
-
-    // remove from incoming[to]
-    auto& inList  = incoming_[to];
-    inList.erase(std::remove(inList.begin(), inList.end(), id),
-                 inList.end());
+    // remove from outgoing[from] and incoming[to]
+    adjRemove(r, true, from, id);
+    adjRemove(r, false, to, id);
 
     maybeCreateCheckpoint(e);
 }
@@ -175,13 +435,16 @@ void Graph::updateNode(const std::string& id,
     e.entityId = id;
     e.payload = attrs;
     addEvent(e);
+    recordUndo(e, eventLog_.size());
     // Merge into live node, if it exists
     auto it = nodes_.find(id);
     if (it != nodes_.end()) {
+        auto before = indexedValues(id);
         auto& nodeAttrs = it->second.attributes;
         for (const auto& [k,v] : attrs) {
             nodeAttrs[k] = v;
         }
+        reindexNode(id, before, timestamp);
     }
 
     maybeCreateCheckpoint(e);
@@ -197,6 +460,7 @@ void Graph::updateEdge(const std::string& id,
     e.entityId = id;
     e.payload = attrs;
     addEvent(e);
+    recordUndo(e, eventLog_.size());
     // Merge into live edge, if it exists
     auto it = edges_.find(id);
     if (it != edges_.end()) {
@@ -278,11 +542,32 @@ Graph::DiffResult Graph::diff(std::int64_t t1, std::int64_t t2) const {
 
 // Apply an Event to mutate state, without appending it to eventLog_
 void Graph::applyEvent(const Event& e) {
+    applyEventAt(e, eventLog_.size());
+}
+
+void Graph::replayEvents(const EventChunk& events) {
+    size_t logSize = eventLog_.size();
+    eventLog_.append(events);
+    for (const auto& e : events) {
+        applyEventAt(e, ++logSize);
+    }
+}
+
+void Graph::applyEventAt(const Event& e, size_t logSize) {
+    bumpVersion();
+    UndoRecord* r = recordUndo(e, logSize);
+    // remember indexed attribute values of the node being touched
+    IndexedValues before;
+    if (e.type == EventType::ADD_NODE || e.type == EventType::DEL_NODE ||
+        e.type == EventType::UPDATE_NODE) {
+        before = indexedValues(e.entityId);
+    }
+
     switch (e.type) {
       case EventType::ADD_NODE:
         nodes_[e.entityId] = Node{e.entityId, e.payload};
-        outgoing_.emplace(e.entityId, std::vector<std::string>{});
-        incoming_.emplace(e.entityId, std::vector<std::string>{});
+        adjList(r, true, e.entityId);
+        adjList(r, false, e.entityId);
         break;
 
       case EventType::DEL_NODE: {
@@ -290,27 +575,21 @@ void Graph::applyEvent(const Event& e) {
         if (auto oit = outgoing_.find(e.entityId); oit != outgoing_.end()) {
           for (const auto& eid : oit->second) {
             if (auto eit = edges_.find(eid); eit != edges_.end()) {
-              incoming_[eit->second.to].erase(
-                std::remove(incoming_[eit->second.to].begin(),
-                            incoming_[eit->second.to].end(), eid),
-                incoming_[eit->second.to].end());
+              adjRemove(r, false, eit->second.to, eid);
               edges_.erase(eit);
             }
           }
-          outgoing_.erase(oit);
+          adjErase(r, true, e.entityId);
         }
         // 2) Remove all incoming edges
         if (auto iit = incoming_.find(e.entityId); iit != incoming_.end()) {
           for (const auto& eid : iit->second) {
             if (auto eit = edges_.find(eid); eit != edges_.end()) {
-              outgoing_[eit->second.from].erase(
-                std::remove(outgoing_[eit->second.from].begin(),
-                            outgoing_[eit->second.from].end(), eid),
-                outgoing_[eit->second.from].end());
+              adjRemove(r, true, eit->second.from, eid);
               edges_.erase(eit);
             }
           }
-          incoming_.erase(iit);
+          adjErase(r, false, e.entityId);
         }
         // 3) Erase the node
         nodes_.erase(e.entityId);
@@ -325,22 +604,14 @@ void Graph::applyEvent(const Event& e) {
         break;
 
       case EventType::ADD_EDGE:
-        edges_[e.entityId] = Edge{e.entityId, e.from, e.to, e.payload};
-        outgoing_[e.from].push_back(e.entityId);
-        incoming_[e.to].push_back(e.entityId);
+        edges_[e.entityId] = Edge{e.entityId, e.from, e.to, e.payload, e.timestamp};
+        adjAppend(r, true, e.from, e.entityId);
+        adjAppend(r, false, e.to, e.entityId);
         break;
 
       case EventType::DEL_EDGE:
-        outgoing_[e.from].erase(
-          std::remove(outgoing_[e.from].begin(),
-                      outgoing_[e.from].end(),
-                      e.entityId),
-          outgoing_[e.from].end());
-        incoming_[e.to].erase(
-          std::remove(incoming_[e.to].begin(),
-                      incoming_[e.to].end(),
-                      e.entityId),
-          incoming_[e.to].end());
+        adjRemove(r, true, e.from, e.entityId);
+        adjRemove(r, false, e.to, e.entityId);
         edges_.erase(e.entityId);
         break;
 
@@ -352,22 +623,435 @@ void Graph::applyEvent(const Event& e) {
         }
         break;
     }
+
+    reindexNode(e.entityId, before, e.timestamp);
 }
 
 // Clear all in-memory graph state, but leave eventLog_ intact
 void Graph::clearStateKeepLog() {
+    undoLog_.clear();
+    journalStart_ = eventLog_.size();
     nodes_.clear();
     edges_.clear();
     outgoing_.clear();
     incoming_.clear();
+    resetIndexes();
+    bumpVersion();
 }
 
 void Graph::clearGraph() {
     eventLog_.clear();
+    checkpoints_.clear();
+    compactedEvents_ = 0;
+    undoLog_.clear();
+    journalStart_ = 0;
     nodes_.clear();
     edges_.clear();
     outgoing_.clear();
     incoming_.clear();
+    resetIndexes();
+    bumpVersion();
+}
+
+// ---- Undo Journal ----
+
+void Graph::enableUndoJournal() {
+    if (journalEnabled_) return;
+    journalEnabled_ = true;
+    journalStart_ = eventLog_.size();
+}
+
+bool Graph::undoJournalEnabled() const {
+    return journalEnabled_;
+}
+
+void Graph::resetUndoJournal() {
+    undoLog_.clear();
+    journalStart_ = eventLog_.size();
+}
+
+void Graph::trimUndoJournal(size_t eventCount) {
+    eventCount = std::min(eventCount, eventLog_.size());
+    if (eventCount <= journalStart_) return;
+    auto keep = std::find_if(undoLog_.begin(), undoLog_.end(),
+                             [&](const UndoRecord& r) { return r.logSize > eventCount; });
+    undoLog_.erase(undoLog_.begin(), keep);
+    journalStart_ = eventCount;
+}
+
+Graph Graph::copyWithoutUndoJournal() const {
+    // member-wise copy of everything but undoLog_ (and the WAL, as for copies)
+    Graph g;
+    g.version_ = version_;
+    g.eventLog_ = eventLog_;
+    g.nodes_ = nodes_;
+    g.edges_ = edges_;
+    g.outgoing_ = outgoing_;
+    g.incoming_ = incoming_;
+    g.nodeIndexes_ = nodeIndexes_;
+    g.journalEnabled_ = journalEnabled_;
+    g.journalStart_ = eventLog_.size();
+    g.checkpoints_ = checkpoints_;
+    g.compactedEvents_ = compactedEvents_;
+    return g;
+}
+
+Graph::UndoRecord* Graph::recordUndo(const Event& e, size_t logSize) {
+    if (!journalEnabled_) return nullptr;
+
+    // adjacency changes are added by the adj* helpers as they are made
+    UndoRecord r;
+    r.logSize = logSize;
+    auto saveNode = [&](const std::string& id) {
+        auto it = nodes_.find(id);
+        r.nodes.emplace_back(id, it == nodes_.end() ? std::nullopt
+                                                    : std::optional<Node>(it->second));
+    };
+    auto saveEdge = [&](const std::string& id) {
+        auto it = edges_.find(id);
+        r.edges.emplace_back(id, it == edges_.end() ? std::nullopt
+                                                    : std::optional<Edge>(it->second));
+    };
+
+    switch (e.type) {
+      case EventType::ADD_NODE:
+        saveNode(e.entityId);
+        break;
+
+      case EventType::UPDATE_NODE:
+        if (nodes_.count(e.entityId)) saveNode(e.entityId);
+        break;
+
+      case EventType::DEL_NODE:
+        // the node and its incident edges
+        saveNode(e.entityId);
+        for (const auto* adj : { &outgoing_, &incoming_ }) {
+            if (auto it = adj->find(e.entityId); it != adj->end()) {
+                for (const auto& eid : it->second) {
+                    if (edges_.count(eid)) saveEdge(eid);
+                }
+            }
+        }
+        break;
+
+      case EventType::ADD_EDGE:
+      case EventType::DEL_EDGE:
+        saveEdge(e.entityId);
+        break;
+
+      case EventType::UPDATE_EDGE:
+        if (edges_.count(e.entityId)) saveEdge(e.entityId);
+        break;
+    }
+
+    undoLog_.push_back(std::move(r));
+    return &undoLog_.back();
+}
+
+std::vector<std::string>& Graph::adjList(UndoRecord* r, bool outgoing, const std::string& node) {
+    auto [it, created] = adjacency(outgoing).try_emplace(node);
+    if (created && r) {
+        r->adjacency.push_back({ UndoRecord::AdjChange::CREATE, outgoing, node, {}, 0, {} });
+    }
+    return it->second;
+}
+
+void Graph::adjAppend(UndoRecord* r, bool outgoing, const std::string& node,
+                      const std::string& edge) {
+    adjList(r, outgoing, node).push_back(edge);
+    if (r) r->adjacency.push_back({ UndoRecord::AdjChange::APPEND, outgoing, node, edge, 0, {} });
+}
+
+void Graph::adjRemove(UndoRecord* r, bool outgoing, const std::string& node,
+                      const std::string& edge) {
+    auto& list = adjList(r, outgoing, node);
+    if (r) {
+        // last occurrence first: reinserted in reverse, every index is valid again
+        for (size_t i = list.size(); i-- > 0; ) {
+            if (list[i] == edge) {
+                r->adjacency.push_back({ UndoRecord::AdjChange::REMOVE, outgoing, node, edge, i, {} });
+            }
+        }
+    }
+    list.erase(std::remove(list.begin(), list.end(), edge), list.end());
+}
+
+void Graph::adjErase(UndoRecord* r, bool outgoing, const std::string& node) {
+    auto& adj = adjacency(outgoing);
+    auto it = adj.find(node);
+    if (it == adj.end()) return;
+    if (r) {
+        r->adjacency.push_back({ UndoRecord::AdjChange::ERASE, outgoing, node, {}, 0,
+                                 std::move(it->second) });
+    }
+    adj.erase(it);
+}
+
+void Graph::undo(UndoRecord& r) {
+    // adjacency changes newest first; the records are dropped afterwards
+    for (auto it = r.adjacency.rbegin(); it != r.adjacency.rend(); ++it) {
+        auto& adj = adjacency(it->outgoing);
+        switch (it->kind) {
+          case UndoRecord::AdjChange::CREATE:
+            adj.erase(it->node);
+            break;
+          case UndoRecord::AdjChange::APPEND:
+            adj[it->node].pop_back();
+            break;
+          case UndoRecord::AdjChange::REMOVE: {
+            auto& list = adj[it->node];
+            list.insert(list.begin() + static_cast<std::ptrdiff_t>(it->index), it->edge);
+          } break;
+          case UndoRecord::AdjChange::ERASE:
+            adj[it->node] = std::move(it->list);
+            break;
+        }
+    }
+
+    // a missing before-image means the slot did not exist
+    auto restore = [](auto& map, const auto& slots) {
+        for (const auto& [id, before] : slots) {
+            if (before) map[id] = *before;
+            else map.erase(id);
+        }
+    };
+    restore(nodes_, r.nodes);
+    restore(edges_, r.edges);
+}
+
+bool Graph::rollbackTo(size_t eventCount) {
+    if (eventCount > eventLog_.size()) {
+        throw std::invalid_argument("rollbackTo: event count beyond end of log");
+    }
+    if (!journalEnabled_ || eventCount < journalStart_) {
+        return false;
+    }
+
+    while (!undoLog_.empty() && undoLog_.back().logSize > eventCount) {
+        undo(undoLog_.back());
+        undoLog_.pop_back();
+    }
+    eventLog_.truncate(eventCount);
+    checkpoints_.erase(
+        std::remove_if(checkpoints_.begin(), checkpoints_.end(),
+                       [&](const Checkpoint& cp) { return cp.eventIndex > eventCount; }),
+        checkpoints_.end());
+
+    // index histories cannot be unwound interval by interval; rebuild them
+    std::vector<std::pair<std::string, IndexKind>> declared;
+    for (const auto& [key, idx] : nodeIndexes_) declared.emplace_back(key, idx.kind);
+    for (const auto& [key, kind] : declared) createNodeIndex(key, kind);
+    bumpVersion();
+    return true;
+}
+
+// ---- Secondary Indexes ----
+
+void Graph::createNodeIndex(const std::string& key, IndexKind kind) {
+    AttributeIndex idx;
+    idx.kind = kind;
+
+    // 1) Value history, replayed from the event log (after the base state
+    //    of a compacted graph, whose values count as held since forever)
+    std::unordered_map<std::string, std::optional<std::string>> current;
+    if (compactedEvents_) {
+        for (const auto& [nid, node] : checkpoints_.front().nodes) {
+            std::optional<std::string> value;
+            if (auto ait = node.attributes.find(key); ait != node.attributes.end()) value = ait->second;
+            indexTransition(idx, nid, std::nullopt, value, std::numeric_limits<std::int64_t>::min());
+            current[nid] = value;
+        }
+    }
+    for (const auto& e : eventLog_) {
+        auto cit = current.find(e.entityId);
+        switch (e.type) {
+          case EventType::ADD_NODE: {
+            std::optional<std::string> value;
+            if (auto pit = e.payload.find(key); pit != e.payload.end()) value = pit->second;
+            std::optional<std::string> old = cit == current.end() ? std::nullopt : cit->second;
+            indexTransition(idx, e.entityId, old, value, e.timestamp);
+            current[e.entityId] = value;
+          } break;
+          case EventType::UPDATE_NODE:
+            if (cit != current.end()) {
+                if (auto pit = e.payload.find(key); pit != e.payload.end()) {
+                    indexTransition(idx, e.entityId, cit->second, pit->second, e.timestamp);
+                    cit->second = pit->second;
+                }
+            }
+            break;
+          case EventType::DEL_NODE:
+            if (cit != current.end()) {
+                indexTransition(idx, e.entityId, cit->second, std::nullopt, e.timestamp);
+                current.erase(cit);
+            }
+            break;
+          default:
+            break;
+        }
+    }
+
+    // 2) Current lookups come from the live state, which is authoritative
+    idx.byValue.clear();
+    idx.byNumber.clear();
+    for (const auto& [nid, node] : nodes_) {
+        auto ait = node.attributes.find(key);
+        if (ait == node.attributes.end()) continue;
+        idx.byValue[ait->second].insert(nid);
+        if (kind == IndexKind::ORDERED) {
+            if (auto num = parseNumber(ait->second)) idx.byNumber[*num].insert(nid);
+        }
+        // live nodes the log knows nothing about have held their value forever
+        if (!idx.open.count(nid)) {
+            auto& postings = idx.history[ait->second];
+            idx.open[nid] = postings.size();
+            postings.push_back({nid, std::numeric_limits<std::int64_t>::min(),
+                                std::numeric_limits<std::int64_t>::max()});
+        }
+    }
+
+    nodeIndexes_[key] = std::move(idx);
+}
+
+void Graph::dropNodeIndex(const std::string& key) {
+    nodeIndexes_.erase(key);
+}
+
+bool Graph::hasNodeIndex(const std::string& key) const {
+    return nodeIndexes_.count(key) > 0;
+}
+
+std::vector<std::string> Graph::findNodes(const std::string& key,
+                                          const std::string& value) const {
+    if (auto iit = nodeIndexes_.find(key); iit != nodeIndexes_.end()) {
+        auto vit = iit->second.byValue.find(value);
+        if (vit == iit->second.byValue.end()) return {};
+        return sortedIds(vit->second);
+    }
+    // no index: full scan
+    std::vector<std::string> out;
+    for (const auto& [nid, node] : nodes_) {
+        auto ait = node.attributes.find(key);
+        if (ait != node.attributes.end() && ait->second == value) out.push_back(nid);
+    }
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+std::vector<std::string> Graph::findNodesInRange(const std::string& key,
+                                                 double lo, double hi) const {
+    std::vector<std::string> out;
+    auto iit = nodeIndexes_.find(key);
+    if (iit != nodeIndexes_.end() && iit->second.kind == IndexKind::ORDERED) {
+        const auto& byNumber = iit->second.byNumber;
+        for (auto it = byNumber.lower_bound(lo);
+             it != byNumber.end() && it->first <= hi; ++it) {
+            out.insert(out.end(), it->second.begin(), it->second.end());
+        }
+    } else {
+        // no ordered index: full scan
+        for (const auto& [nid, node] : nodes_) {
+            auto ait = node.attributes.find(key);
+            if (ait == node.attributes.end()) continue;
+            auto num = parseNumber(ait->second);
+            if (num && *num >= lo && *num <= hi) out.push_back(nid);
+        }
+    }
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+std::vector<std::string> Graph::findNodesAt(const std::string& key,
+                                            const std::string& value,
+                                            std::int64_t timestamp) const {
+    auto iit = nodeIndexes_.find(key);
+    if (iit == nodeIndexes_.end()) {
+        throw std::runtime_error("No index on node attribute '" + key + "'");
+    }
+    std::vector<std::string> out;
+    const auto& history = iit->second.history;
+    if (auto hit = history.find(value); hit != history.end()) {
+        for (const auto& iv : hit->second) {
+            if (iv.from <= timestamp && timestamp < iv.to) out.push_back(iv.nodeId);
+        }
+    }
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+    return out;
+}
+
+Graph::IndexedValues Graph::indexedValues(const std::string& nodeId) const {
+    IndexedValues values;
+    if (nodeIndexes_.empty()) return values;
+    values.reserve(nodeIndexes_.size());
+    auto nit = nodes_.find(nodeId);
+    for (const auto& [key, idx] : nodeIndexes_) {
+        if (nit == nodes_.end()) {
+            values.emplace_back();
+            continue;
+        }
+        auto ait = nit->second.attributes.find(key);
+        if (ait == nit->second.attributes.end()) values.emplace_back();
+        else values.emplace_back(ait->second);
+    }
+    return values;
+}
+
+void Graph::reindexNode(const std::string& nodeId, const IndexedValues& before,
+                        std::int64_t timestamp) {
+    if (before.empty()) return;  // no indexes declared
+    IndexedValues after = indexedValues(nodeId);
+    size_t i = 0;
+    for (auto& [key, idx] : nodeIndexes_) {
+        indexTransition(idx, nodeId, before[i], after[i], timestamp);
+        ++i;
+    }
+}
+
+void Graph::indexTransition(AttributeIndex& idx, const std::string& nodeId,
+                            const std::optional<std::string>& oldValue,
+                            const std::optional<std::string>& newValue,
+                            std::int64_t timestamp) {
+    if (oldValue == newValue) return;
+
+    if (oldValue) {
+        if (auto vit = idx.byValue.find(*oldValue); vit != idx.byValue.end()) {
+            vit->second.erase(nodeId);
+            if (vit->second.empty()) idx.byValue.erase(vit);
+        }
+        if (idx.kind == IndexKind::ORDERED) {
+            if (auto num = parseNumber(*oldValue)) {
+                if (auto nit = idx.byNumber.find(*num); nit != idx.byNumber.end()) {
+                    nit->second.erase(nodeId);
+                    if (nit->second.empty()) idx.byNumber.erase(nit);
+                }
+            }
+        }
+        // close the interval during which the node held the old value
+        if (auto oit = idx.open.find(nodeId); oit != idx.open.end()) {
+            idx.history[*oldValue][oit->second].to = timestamp;
+            idx.open.erase(oit);
+        }
+    }
+
+    if (newValue) {
+        idx.byValue[*newValue].insert(nodeId);
+        if (idx.kind == IndexKind::ORDERED) {
+            if (auto num = parseNumber(*newValue)) idx.byNumber[*num].insert(nodeId);
+        }
+        auto& postings = idx.history[*newValue];
+        idx.open[nodeId] = postings.size();
+        postings.push_back({nodeId, timestamp, std::numeric_limits<std::int64_t>::max()});
+    }
+}
+
+void Graph::resetIndexes() {
+    for (auto& [key, idx] : nodeIndexes_) {
+        idx.byValue.clear();
+        idx.byNumber.clear();
+        idx.history.clear();
+        idx.open.clear();
+    }
 }
 
 // ---- Graph Getters ----
@@ -0,0 +1,96 @@
+// src/Hash.cpp
+#include <chronograph/graph/Hash.h>
+
+namespace chronograph {
+namespace {
+    inline std::uint64_t rotl(std::uint64_t x, int r) {
+        return (x << r) | (x >> (64 - r));
+    }
+
+    inline std::uint64_t fmix(std::uint64_t k) {
+        k ^= k >> 33;
+        k *= 0xff51afd7ed558ccdULL;
+        k ^= k >> 33;
+        k *= 0xc4ceb9fe1a85ec53ULL;
+        k ^= k >> 33;
+        return k;
+    }
+
+    // little-endian load, independent of host byte order
+    inline std::uint64_t load64(const unsigned char* p) {
+        std::uint64_t v = 0;
+        for (int i = 7; i >= 0; --i) v = (v << 8) | p[i];
+        return v;
+    }
+
+    struct Crc32Table {
+        std::uint32_t t[256];
+        Crc32Table() {
+            for (std::uint32_t i = 0; i < 256; ++i) {
+                std::uint32_t c = i;
+                for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+                t[i] = c;
+            }
+        }
+    };
+} // anonymous
+
+Hash128 hash128(const void* data, std::size_t len, std::uint64_t seed) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    const std::size_t nblocks = len / 16;
+    const std::uint64_t c1 = 0x87c37b91114253d5ULL;
+    const std::uint64_t c2 = 0x4cf5ad432745937fULL;
+    std::uint64_t h1 = seed, h2 = seed;
+
+    // body: 16-byte blocks
+    for (std::size_t i = 0; i < nblocks; ++i) {
+        std::uint64_t k1 = load64(bytes + i * 16);
+        std::uint64_t k2 = load64(bytes + i * 16 + 8);
+
+        k1 *= c1; k1 = rotl(k1, 31); k1 *= c2; h1 ^= k1;
+        h1 = rotl(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52dce729;
+
+        k2 *= c2; k2 = rotl(k2, 33); k2 *= c1; h2 ^= k2;
+        h2 = rotl(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495ab5;
+    }
+
+    // tail: remaining 0..15 bytes
+    const unsigned char* tail = bytes + nblocks * 16;
+    std::uint64_t k1 = 0, k2 = 0;
+    const std::size_t rest = len & 15;
+    for (std::size_t i = rest; i > 8; --i) k2 = (k2 << 8) | tail[i - 1];
+    for (std::size_t i = rest < 8 ? rest : 8; i > 0; --i) k1 = (k1 << 8) | tail[i - 1];
+    if (rest > 8) {
+        k2 *= c2; k2 = rotl(k2, 33); k2 *= c1; h2 ^= k2;
+    }
+    if (rest > 0) {
+        k1 *= c1; k1 = rotl(k1, 31); k1 *= c2; h1 ^= k1;
+    }
+
+    // finalization
+    h1 ^= len; h2 ^= len;
+    h1 += h2; h2 += h1;
+    h1 = fmix(h1); h2 = fmix(h2);
+    h1 += h2; h2 += h1;
+    return Hash128{h1, h2};
+}
+
+std::string Hash128::toHex() const {
+    static const char digits[] = "0123456789abcdef";
+    char buf[32];
+    for (int i = 0; i < 16; ++i) {
+        buf[i]      = digits[(hi >> (60 - 4 * i)) & 0xf];
+        buf[16 + i] = digits[(lo >> (60 - 4 * i)) & 0xf];
+    }
+    return std::string(buf, sizeof(buf));
+}
+
+std::uint32_t crc32(const void* data, std::size_t len, std::uint32_t crc) {
+    static const Crc32Table table;
+    const auto* p = static_cast<const unsigned char*>(data);
+    crc = ~crc;
+    for (std::size_t i = 0; i < len; ++i) crc = table.t[(crc ^ p[i]) & 0xff] ^ (crc >> 8);
+    return ~crc;
+}
+
+}  // namespace chronograph
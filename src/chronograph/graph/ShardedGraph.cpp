@@ -0,0 +1,144 @@
+// src/ShardedGraph.cpp
+#include <chronograph/graph/ShardedGraph.h>
+#include <chronograph/graph/Hash.h>
+#include <chronograph/graph/Snapshot.h>
+
+#include <algorithm>
+#include <queue>
+#include <thread>
+#include <utility>
+
+namespace chronograph {
+
+ShardedGraph::ShardedGraph(std::size_t shards) {
+    if (shards == 0) shards = std::max(1u, std::thread::hardware_concurrency());
+    shards_.reserve(shards);
+    for (std::size_t i = 0; i < shards; ++i) shards_.push_back(std::make_unique<Shard>());
+}
+
+std::size_t ShardedGraph::shardOf(const std::string& id) const {
+    return static_cast<std::size_t>(hash128(id).lo % shards_.size());
+}
+
+template <class Op>
+void ShardedGraph::mutate(Shard& s, Op&& op) {
+    std::lock_guard<std::mutex> lock(s.mutex);
+    op(s.graph);
+    // one op may log several events (cascading deletes)
+    const std::size_t logged = s.graph.getEventLog().size();
+    if (logged == s.sequence.size()) return;
+    std::uint64_t seq = nextSequence_.fetch_add(logged - s.sequence.size(),
+                                                std::memory_order_relaxed);
+    while (s.sequence.size() < logged) s.sequence.push_back(seq++);
+}
+
+// ---- Mutators ----
+
+void ShardedGraph::addNode(const std::string& id,
+                           const std::map<std::string, std::string>& attrs,
+                           std::int64_t timestamp) {
+    mutate(*shards_[shardOf(id)], [&](Graph& g) { g.addNode(id, attrs, timestamp); });
+}
+
+void ShardedGraph::delNode(const std::string& id, std::int64_t timestamp) {
+    const std::size_t home = shardOf(id);
+    mutate(*shards_[home], [&](Graph& g) { g.delNode(id, timestamp); });
+    // incoming edges owned by the shards of their sources
+    for (std::size_t i = 0; i < shards_.size(); ++i) {
+        if (i == home) continue;
+        mutate(*shards_[i], [&](Graph& g) {
+            auto it = g.getIncoming().find(id);
+            if (it == g.getIncoming().end()) return;
+            const std::vector<std::string> edges = it->second;   // delEdge edits the list
+            for (const auto& eid : edges) g.delEdge(eid, timestamp);
+        });
+    }
+}
+
+void ShardedGraph::addEdge(const std::string& id,
+                           const std::string& from,
+                           const std::string& to,
+                           const std::map<std::string, std::string>& attrs,
+                           std::int64_t timestamp) {
+    mutate(*shards_[shardOf(from)], [&](Graph& g) { g.addEdge(id, from, to, attrs, timestamp); });
+}
+
+void ShardedGraph::delEdge(const std::string& id, std::int64_t timestamp) {
+    for (auto& s : shards_) {
+        bool found = false;
+        mutate(*s, [&](Graph& g) {
+            if ((found = g.getEdges().count(id) > 0)) g.delEdge(id, timestamp);
+        });
+        if (found) return;
+    }
+}
+
+void ShardedGraph::updateNode(const std::string& id,
+                              const std::map<std::string, std::string>& attrs,
+                              std::int64_t timestamp) {
+    mutate(*shards_[shardOf(id)], [&](Graph& g) { g.updateNode(id, attrs, timestamp); });
+}
+
+void ShardedGraph::updateEdge(const std::string& id,
+                              const std::map<std::string, std::string>& attrs,
+                              std::int64_t timestamp) {
+    for (auto& s : shards_) {
+        bool found = false;
+        mutate(*s, [&](Graph& g) {
+            if ((found = g.getEdges().count(id) > 0)) g.updateEdge(id, attrs, timestamp);
+        });
+        if (found) return;
+    }
+}
+
+// ---- Reading ----
+
+std::size_t ShardedGraph::eventCount() const {
+    std::size_t total = 0;
+    for (const auto& s : shards_) {
+        std::lock_guard<std::mutex> lock(s->mutex);
+        total += s->sequence.size();
+    }
+    return total;
+}
+
+std::vector<Event> ShardedGraph::events() const {
+    // hold every shard, in index order, so the merge sees one consistent cut
+    std::vector<std::unique_lock<std::mutex>> locks;
+    locks.reserve(shards_.size());
+    for (const auto& s : shards_) locks.emplace_back(s->mutex);
+
+    // k-way merge of the shard logs by sequence number
+    using Head = std::pair<std::uint64_t, std::size_t>;   // (sequence, shard)
+    std::priority_queue<Head, std::vector<Head>, std::greater<Head>> heads;
+    std::vector<std::size_t> pos(shards_.size(), 0);
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < shards_.size(); ++i) {
+        total += shards_[i]->sequence.size();
+        if (!shards_[i]->sequence.empty()) heads.push({ shards_[i]->sequence[0], i });
+    }
+    std::vector<Event> out;
+    out.reserve(total);
+    while (!heads.empty()) {
+        const std::size_t i = heads.top().second;
+        heads.pop();
+        const Shard& s = *shards_[i];
+        out.push_back(s.graph.getEventLog()[pos[i]]);
+        if (++pos[i] < s.sequence.size()) heads.push({ s.sequence[pos[i]], i });
+    }
+    return out;
+}
+
+Graph ShardedGraph::merged() const {
+    Graph g;
+    g.replayEvents(EventChunk(events()));
+    return g;
+}
+
+Snapshot ShardedGraph::snapshotShard(std::size_t shard, std::int64_t timestamp) const {
+    const Shard& s = *shards_.at(shard);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return Snapshot(s.graph, timestamp);
+}
+
+}  // namespace chronograph
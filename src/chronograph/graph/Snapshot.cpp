@@ -2,114 +2,418 @@
 #include <chronograph/graph/Snapshot.h>
 #include <chronograph/graph/Event.h>
 #include <chronograph/graph/Graph.h>
+#include <chronograph/graph/EventSegment.h>
+#include <chronograph/graph/ShardedGraph.h>
+#include <chronograph/graph/utils/Parallel.h>
 #include <algorithm>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <thread>
 
 namespace chronograph {
 
+namespace {
+  const std::string& str(const std::string& s) { return s; }
+  std::string str(std::string_view s) { return std::string(s); }
+
+  const std::map<std::string, std::string>& attributes(const std::map<std::string, std::string>& p) {
+    return p;
+  }
+  std::map<std::string, std::string> attributes(const PayloadView& p) {
+    std::map<std::string, std::string> out;
+    for (const auto& [k, v] : p) out.emplace_hint(out.end(), k, v);
+    return out;
+  }
+
+  // latest checkpoint at or before `timestamp` (nullptr: replay from the start)
+  const Graph::Checkpoint* checkpointFor(const Graph& graph, std::int64_t timestamp) {
+    if (timestamp < graph.compactionHorizon()) {
+      throw std::runtime_error("Snapshot: timestamp " + std::to_string(timestamp) +
+                               " is before the compaction horizon");
+    }
+    const auto& checkpoints = graph.getCheckpoints();
+    for (auto it = checkpoints.rbegin(); it != checkpoints.rend(); ++it) {
+      if (it->timestamp <= timestamp) return &*it;
+    }
+    return nullptr;
+  }
+
+  // ---- parallel replay ----
+
+  // an edge and the log index of its latest ADD_EDGE (-1: from the checkpoint)
+  struct EdgeState {
+    Edge edge;
+    std::int64_t addedAt;
+  };
+  // a surviving edge, filed under one endpoint
+  struct AdjEntry {
+    const std::string* node;
+    std::int64_t addedAt;
+    const std::string* edge;
+  };
+  // the entities whose IDs hash to one partition
+  struct EntityPartition {
+    std::unordered_map<std::string, Node> nodes;
+    std::unordered_map<std::string, EdgeState> edges;
+    std::unordered_map<std::string, std::int64_t> lastDelete;   // node -> last DEL_NODE
+    std::vector<std::vector<AdjEntry>> out, in;                 // by partition of the endpoint
+    std::unordered_map<std::string, std::vector<std::string>> outgoing, incoming;
+    bool stale = false;   // an edge ID re-added or deleted with other endpoints
+  };
+} // anonymous
+
 Snapshot::Snapshot(const Graph& graph, std::int64_t timestamp) {
   const auto& events = graph.getEventLog();
-  const auto& checkpoints = graph.getCheckpoints();
 
   size_t startIdx = 0;
   // find latest checkpoint <= timestamp
-  if (!checkpoints.empty()) {
-    for (auto it = checkpoints.rbegin(); it != checkpoints.rend(); ++it) {
-      if (it->timestamp <= timestamp) {
-        nodes_ =it->nodes;
-        edges_ = it->edges;
-        outgoing_ = it->outgoing;
-        incoming_ = it->incoming;
-        startIdx = it->eventIndex;
-        break;
-      }
-    }
+  if (const auto* cp = checkpointFor(graph, timestamp)) {
+    nodes_ = cp->nodes;
+    edges_ = cp->edges;
+    outgoing_ = cp->outgoing;
+    incoming_ = cp->incoming;
+    startIdx = cp->eventIndex;
   }
 
   // "replay" remaining events
-  for (size_t i = startIdx; i < events.size(); ++i) {
-    const auto& e = events[i];
+  for (auto it = events.begin() + startIdx; it != events.end(); ++it) {
+    const auto& e = *it;
     if (e.timestamp > timestamp) break;
 
-    switch (e.type) {
-      case EventType::ADD_NODE:
-        nodes_[e.entityId] = Node{e.entityId, e.payload};
-        outgoing_.emplace(e.entityId, std::vector<std::string>{});
-        incoming_.emplace(e.entityId, std::vector<std::string>{});
-        break;
-
-      case EventType::DEL_NODE: {
-        // remove all outgoing edges
-        if (auto oit = outgoing_.find(e.entityId); oit != outgoing_.end()) {
-          for (auto& eid : oit->second) {
-            // remove from edges_
-            if (auto eit = edges_.find(eid); eit != edges_.end()) {
-              // also clean up incoming_ on that edge’s target
-              incoming_[eit->second.to].erase(
-                std::remove(incoming_[eit->second.to].begin(),
-                            incoming_[eit->second.to].end(),
-                            eid),
-                incoming_[eit->second.to].end()
-              );
-              edges_.erase(eit);
-            }
+    apply(e);
+  }
+}
+
+Snapshot::Snapshot(const Graph& graph, std::int64_t timestamp, std::size_t threads) {
+  if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+  threads = std::min<std::size_t>(threads, std::numeric_limits<std::uint16_t>::max());
+  const auto& events = graph.getEventLog();
+  const Graph::Checkpoint* cp = checkpointFor(graph, timestamp);
+  const std::size_t start = cp ? cp->eventIndex : 0;
+  std::size_t end = start;
+  for (auto it = events.begin() + start; it != events.end() && it->timestamp <= timestamp; ++it) ++end;
+  if (threads == 1 || end - start < kParallelMinEvents) {
+    *this = Snapshot(graph, timestamp);
+    return;
+  }
+
+  // Every entity's events are replayed by the worker owning its partition.
+  // The only effect crossing entities is DEL_NODE removing the edges at the
+  // node: an edge goes if an endpoint was deleted after the edge's latest
+  // ADD_EDGE. Each worker records the last DEL_NODE per node, then the
+  // edges are checked against them, and adjacency lists are rebuilt in
+  // ADD_EDGE order (checkpoint order for older edges).
+  const std::size_t parts = threads;
+  std::vector<EntityPartition> part(parts);
+  auto partOf = [parts](const std::string& id) {
+    return static_cast<std::uint16_t>(std::hash<std::string>{}(id) % parts);
+  };
+
+  // 1) partition of every event and checkpoint entry, one contiguous slice
+  //    per worker; then bucketed, so each worker visits only its own
+  std::vector<const Event*> event(end - start);
+  std::vector<std::uint16_t> owner(end - start);
+  std::vector<const std::pair<const std::string, Node>*> cpNodes;
+  std::vector<const std::pair<const std::string, Edge>*> cpEdges;
+  if (cp) {
+    cpNodes.reserve(cp->nodes.size());
+    for (const auto& entry : cp->nodes) cpNodes.push_back(&entry);
+    cpEdges.reserve(cp->edges.size());
+    for (const auto& entry : cp->edges) cpEdges.push_back(&entry);
+  }
+  std::vector<std::uint16_t> nodeOwner(cpNodes.size()), edgeOwner(cpEdges.size());
+  onWorkers(parts, [&](std::size_t w) {
+    const std::size_t from = (end - start) * w / parts;
+    const std::size_t to = (end - start) * (w + 1) / parts;
+    auto it = events.begin() + static_cast<std::ptrdiff_t>(start + from);
+    for (std::size_t i = from; i < to; ++i, ++it) {
+      event[i] = &*it;
+      owner[i] = partOf(it->entityId);
+    }
+    auto assign = [&](const auto& entries, std::vector<std::uint16_t>& out) {
+      const std::size_t hi = entries.size() * (w + 1) / parts;
+      for (std::size_t i = entries.size() * w / parts; i < hi; ++i) out[i] = partOf(entries[i]->first);
+    };
+    assign(cpNodes, nodeOwner);
+    assign(cpEdges, edgeOwner);
+  });
+  const PartitionBuckets eventBuckets(owner, parts);
+  const PartitionBuckets nodeBuckets(nodeOwner, parts), edgeBuckets(edgeOwner, parts);
+
+  // 2) replay each partition's entities, starting from their checkpoint state
+  onWorkers(parts, [&](std::size_t w) {
+    EntityPartition& p = part[w];
+    for (std::size_t k = nodeBuckets.start[w]; k < nodeBuckets.start[w + 1]; ++k) {
+      const auto& [id, node] = *cpNodes[nodeBuckets.order[k]];
+      p.nodes.emplace(id, node);
+    }
+    for (std::size_t k = edgeBuckets.start[w]; k < edgeBuckets.start[w + 1]; ++k) {
+      const auto& [id, edge] = *cpEdges[edgeBuckets.order[k]];
+      p.edges.emplace(id, EdgeState{ edge, -1 });
+    }
+    for (std::size_t k = eventBuckets.start[w]; k < eventBuckets.start[w + 1]; ++k) {
+      const std::size_t i = eventBuckets.order[k];
+      const Event& e = *event[i];
+      switch (e.type) {
+        case EventType::ADD_NODE:
+          p.nodes[e.entityId] = Node{ e.entityId, e.payload };
+          break;
+        case EventType::DEL_NODE:
+          p.nodes.erase(e.entityId);
+          p.lastDelete[e.entityId] = static_cast<std::int64_t>(i);
+          break;
+        case EventType::UPDATE_NODE:
+          if (auto nit = p.nodes.find(e.entityId); nit != p.nodes.end()) {
+            for (const auto& [k, v] : e.payload) nit->second.attributes[k] = v;
           }
-          outgoing_.erase(oit);
-        }
-        // remove all incoming edges
-        if (auto iit = incoming_.find(e.entityId); iit != incoming_.end()) {
-          for (auto& eid : iit->second) {
-            if (auto eit = edges_.find(eid); eit != edges_.end()) {
-              outgoing_[eit->second.from].erase(
-                std::remove(outgoing_[eit->second.from].begin(),
-                            outgoing_[eit->second.from].end(),
-                            eid),
-                outgoing_[eit->second.from].end()
-              );
-              edges_.erase(eit);
-            }
+          break;
+        case EventType::ADD_EDGE: {
+          EdgeState state{ Edge{ e.entityId, e.from, e.to, e.payload, e.timestamp },
+                           static_cast<std::int64_t>(i) };
+          auto [eit, added] = p.edges.try_emplace(e.entityId, std::move(state));
+          if (!added) {
+            p.stale = true;   // the old endpoints' lists keep the ID
+            eit->second = std::move(state);
+          }
+        } break;
+        case EventType::DEL_EDGE:
+          if (auto eit = p.edges.find(e.entityId); eit != p.edges.end()) {
+            const Edge& edge = eit->second.edge;
+            if (edge.from != e.from || edge.to != e.to) p.stale = true;
+            p.edges.erase(eit);
+          }
+          break;
+        case EventType::UPDATE_EDGE:
+          // an edge already cascaded away is dropped in 3) anyway
+          if (auto eit = p.edges.find(e.entityId); eit != p.edges.end()) {
+            for (const auto& [k, v] : e.payload) eit->second.edge.attributes[k] = v;
+          }
+          break;
+      }
+    }
+  });
+
+  // stale list entries make DEL_NODE cascades depend on the whole history
+  for (const auto& p : part) {
+    if (p.stale) {
+      *this = Snapshot(graph, timestamp);
+      return;
+    }
+  }
+
+  // 3) cascades: drop edges whose endpoint was deleted after they were added,
+  //    and route the rest to the partitions of their endpoints
+  auto lastDelete = [&](const std::string& node) {
+    const auto& m = part[partOf(node)].lastDelete;
+    auto it = m.find(node);
+    return it == m.end() ? std::int64_t{-2} : it->second;
+  };
+  onWorkers(parts, [&](std::size_t w) {
+    EntityPartition& p = part[w];
+    p.out.resize(parts);
+    p.in.resize(parts);
+    for (auto it = p.edges.begin(); it != p.edges.end(); ) {
+      const Edge& edge = it->second.edge;
+      const std::int64_t added = it->second.addedAt;
+      if (lastDelete(edge.from) > added || lastDelete(edge.to) > added) {
+        it = p.edges.erase(it);
+        continue;
+      }
+      p.out[partOf(edge.from)].push_back({ &edge.from, added, &edge.id });
+      p.in[partOf(edge.to)].push_back({ &edge.to, added, &edge.id });
+      ++it;
+    }
+  });
+
+  // 4) adjacency lists of each partition's node IDs
+  auto buildLists = [&](std::size_t w, bool outgoing,
+                        std::unordered_map<std::string, std::vector<std::string>>& lists) {
+    std::unordered_map<const std::string*, std::vector<const AdjEntry*>> byNode;
+    std::unordered_map<std::string, const std::string*> canonical;   // one key pointer per ID
+    for (std::size_t src = 0; src < parts; ++src) {
+      for (const auto& entry : (outgoing ? part[src].out : part[src].in)[w]) {
+        const std::string* key = canonical.emplace(*entry.node, entry.node).first->second;
+        byNode[key].push_back(&entry);
+      }
+    }
+    for (auto& [node, entries] : byNode) {
+      std::vector<std::string>& list = lists[*node];
+      // edges from the checkpoint keep their order there
+      if (cp) {
+        const auto& cpLists = outgoing ? cp->outgoing : cp->incoming;
+        if (auto cit = cpLists.find(*node); cit != cpLists.end()) {
+          for (const auto& eid : cit->second) {
+            const auto& owned = part[partOf(eid)].edges;
+            auto eit = owned.find(eid);
+            if (eit != owned.end() && eit->second.addedAt < 0) list.push_back(eid);
           }
-          incoming_.erase(iit);
         }
-        nodes_.erase(e.entityId);
-      } break;
+      }
+      std::sort(entries.begin(), entries.end(),
+                [](const AdjEntry* a, const AdjEntry* b) { return a->addedAt < b->addedAt; });
+      for (const AdjEntry* entry : entries) {
+        if (entry->addedAt >= 0) list.push_back(*entry->edge);
+      }
+    }
+  };
+  onWorkers(parts, [&](std::size_t w) {
+    EntityPartition& p = part[w];
+    buildLists(w, true, p.outgoing);
+    buildLists(w, false, p.incoming);
+    for (const auto& [id, node] : p.nodes) {
+      p.outgoing.emplace(id, std::vector<std::string>{});
+      p.incoming.emplace(id, std::vector<std::string>{});
+    }
+  });
+
+  // 5) combine the partitions (their keys are disjoint)
+  std::size_t nodeCount = 0, edgeCount = 0, outCount = 0, inCount = 0;
+  for (const auto& p : part) {
+    nodeCount += p.nodes.size();
+    edgeCount += p.edges.size();
+    outCount += p.outgoing.size();
+    inCount += p.incoming.size();
+  }
+  nodes_.reserve(nodeCount);
+  edges_.reserve(edgeCount);
+  outgoing_.reserve(outCount);
+  incoming_.reserve(inCount);
+  for (auto& p : part) {
+    nodes_.merge(p.nodes);
+    outgoing_.merge(p.outgoing);
+    incoming_.merge(p.incoming);
+    for (auto& [id, state] : p.edges) edges_.emplace(id, std::move(state.edge));
+  }
+}
+
+Snapshot::Snapshot(const EventSegment& segment, std::int64_t timestamp) {
+  EventView e;
+  for (auto cursor = segment.cursor(); cursor.next(e); ) {
+    if (e.timestamp > timestamp) break;
+    apply(e);
+  }
+}
+
+Snapshot::Snapshot(const ShardedGraph& graph, std::int64_t timestamp, std::size_t threads) {
+  const std::size_t shards = graph.shardCount();
+  if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+  threads = std::min(threads, shards);
+
+  // every shard replays on its own; workers take the next shard in turn
+  std::vector<std::optional<Snapshot>> parts(shards);
+  std::atomic<std::size_t> next{0};
+  auto work = [&] {
+    for (std::size_t i; (i = next.fetch_add(1)) < shards; ) {
+      parts[i].emplace(graph.snapshotShard(i, timestamp));
+    }
+  };
+  onWorkers(threads, [&](std::size_t) { work(); });
 
-      case EventType::UPDATE_NODE:
-        if (auto nit = nodes_.find(e.entityId); nit != nodes_.end()) {
-          for (auto& [k,v] : e.payload)
-            nit->second.attributes[k] = v;
+  // nodes, edges and outgoing lists belong to one shard each; a node's
+  // incoming edges may come from several
+  for (auto& part : parts) {
+    nodes_.merge(part->nodes_);
+    edges_.merge(part->edges_);
+    for (auto& [id, list] : part->outgoing_) {
+      auto& out = outgoing_[id];
+      out.insert(out.end(), list.begin(), list.end());
+    }
+    for (auto& [id, list] : part->incoming_) {
+      auto& in = incoming_[id];
+      in.insert(in.end(), list.begin(), list.end());
+    }
+  }
+}
+
+template <class E>
+void Snapshot::apply(const E& e) {
+  // owning strings for the maps; no copies when E is Event
+  const std::string& entityId = str(e.entityId);
+  const std::string& from = str(e.from);
+  const std::string& to = str(e.to);
+
+  switch (e.type) {
+    case EventType::ADD_NODE:
+      nodes_[entityId] = Node{entityId, attributes(e.payload)};
+      outgoing_.emplace(entityId, std::vector<std::string>{});
+      incoming_.emplace(entityId, std::vector<std::string>{});
+      break;
+
+    case EventType::DEL_NODE: {
+      // remove all outgoing edges
+      if (auto oit = outgoing_.find(entityId); oit != outgoing_.end()) {
+        for (auto& eid : oit->second) {
+          // remove from edges_
+          if (auto eit = edges_.find(eid); eit != edges_.end()) {
+            // also clean up incoming_ on that edge’s target
+            incoming_[eit->second.to].erase(
+              std::remove(incoming_[eit->second.to].begin(),
+                          incoming_[eit->second.to].end(),
+                          eid),
+              incoming_[eit->second.to].end()
+            );
+            edges_.erase(eit);
+          }
         }
-        break;
-
-      case EventType::ADD_EDGE:
-        edges_[e.entityId] = Edge{e.entityId, e.from, e.to, e.payload, e.timestamp};
-        outgoing_[e.from].push_back(e.entityId);
-        incoming_[e.to].push_back(e.entityId);
-        break;
-
-      case EventType::DEL_EDGE:
-        // use recorded endpoints
-        outgoing_[e.from].erase(
-          std::remove(outgoing_[e.from].begin(),
-                      outgoing_[e.from].end(),
-                      e.entityId),
-          outgoing_[e.from].end()
-        );
-        incoming_[e.to].erase(
-          std::remove(incoming_[e.to].begin(),
-                      incoming_[e.to].end(),
-                      e.entityId),
-          incoming_[e.to].end()
-        );
-        edges_.erase(e.entityId);
-        break;
-
-      case EventType::UPDATE_EDGE:
-        if (auto eit = edges_.find(e.entityId); eit != edges_.end()) {
-          for (auto& [k,v] : e.payload)
-            eit->second.attributes[k] = v;
+        outgoing_.erase(oit);
+      }
+      // remove all incoming edges
+      if (auto iit = incoming_.find(entityId); iit != incoming_.end()) {
+        for (auto& eid : iit->second) {
+          if (auto eit = edges_.find(eid); eit != edges_.end()) {
+            outgoing_[eit->second.from].erase(
+              std::remove(outgoing_[eit->second.from].begin(),
+                          outgoing_[eit->second.from].end(),
+                          eid),
+              outgoing_[eit->second.from].end()
+            );
+            edges_.erase(eit);
+          }
         }
-        break;
-    }
+        incoming_.erase(iit);
+      }
+      nodes_.erase(entityId);
+    } break;
+
+    case EventType::UPDATE_NODE:
+      if (auto nit = nodes_.find(entityId); nit != nodes_.end()) {
+        for (auto& [k,v] : e.payload)
+          nit->second.attributes[str(k)] = str(v);
+      }
+      break;
+
+    case EventType::ADD_EDGE:
+      edges_[entityId] = Edge{entityId, from, to, attributes(e.payload), e.timestamp};
+      outgoing_[from].push_back(entityId);
+      incoming_[to].push_back(entityId);
+      break;
+
+    case EventType::DEL_EDGE:
+      // use recorded endpoints
+      outgoing_[from].erase(
+        std::remove(outgoing_[from].begin(),
+                    outgoing_[from].end(),
+                    entityId),
+        outgoing_[from].end()
+      );
+      incoming_[to].erase(
+        std::remove(incoming_[to].begin(),
+                    incoming_[to].end(),
+                    entityId),
+        incoming_[to].end()
+      );
+      edges_.erase(entityId);
+      break;
+
+    case EventType::UPDATE_EDGE:
+      if (auto eit = edges_.find(entityId); eit != edges_.end()) {
+        for (auto& [k,v] : e.payload)
+          eit->second.attributes[str(k)] = str(v);
+      }
+      break;
   }
 }
 
@@ -0,0 +1,132 @@
+// src/VersionedGraph.cpp
+#include <chronograph/graph/VersionedGraph.h>
+
+#include <atomic>
+#include <utility>
+
+namespace chronograph {
+
+VersionedGraph::VersionedGraph(Graph initial)
+    : head_(std::make_unique<Graph>(initial)),
+      publishedSize_(head_->getEventLog().size())
+{
+    // only the writer's graph logs: versions caught up by replay must not
+    // hold the WAL, or the writer's events would miss it after a recycle
+    head_->attachWal(initial.wal());
+    initial.attachWal(nullptr);
+    current_ = std::shared_ptr<const Graph>(new Graph(std::move(initial)), Retire{ retired_ });
+}
+
+void VersionedGraph::Retire::operator()(const Graph* g) const {
+    std::unique_ptr<Graph> owned(const_cast<Graph*>(g));
+    std::lock_guard<std::mutex> lock(retired->mutex);
+    if (retired->graphs.size() < kMaxRetired) retired->graphs.push_back(std::move(owned));
+}
+
+// ---- Writer ----
+
+void VersionedGraph::addNode(const std::string& id,
+                             const std::map<std::string, std::string>& attrs,
+                             std::int64_t timestamp) {
+    head_->addNode(id, attrs, timestamp);
+    afterWrite();
+}
+
+void VersionedGraph::delNode(const std::string& id, std::int64_t timestamp) {
+    head_->delNode(id, timestamp);
+    afterWrite();
+}
+
+void VersionedGraph::addEdge(const std::string& id,
+                             const std::string& from,
+                             const std::string& to,
+                             const std::map<std::string, std::string>& attrs,
+                             std::int64_t timestamp) {
+    head_->addEdge(id, from, to, attrs, timestamp);
+    afterWrite();
+}
+
+void VersionedGraph::delEdge(const std::string& id, std::int64_t timestamp) {
+    head_->delEdge(id, timestamp);
+    afterWrite();
+}
+
+void VersionedGraph::updateNode(const std::string& id,
+                                const std::map<std::string, std::string>& attrs,
+                                std::int64_t timestamp) {
+    head_->updateNode(id, attrs, timestamp);
+    afterWrite();
+}
+
+void VersionedGraph::updateEdge(const std::string& id,
+                                const std::map<std::string, std::string>& attrs,
+                                std::int64_t timestamp) {
+    head_->updateEdge(id, attrs, timestamp);
+    afterWrite();
+}
+
+void VersionedGraph::afterWrite() {
+    if (publishEvery_ && pendingEvents() >= publishEvery_) publish();
+}
+
+std::size_t VersionedGraph::pendingEvents() const {
+    return head_->getEventLog().size() - publishedSize_;
+}
+
+void VersionedGraph::publish() {
+    if (pendingEvents() == 0) return;
+
+    // 1) the writer's graph becomes the current version; the version it
+    //    replaces is retired once its last reader lets go
+    head_->shareEvents(publishedSize_);   // seal the log, so it can be shared below
+    std::shared_ptr<WriteAheadLog> wal = head_->wal();   // moves on to the next head
+    head_->attachWal(nullptr);
+    std::shared_ptr<const Graph> published(head_.release(), Retire{ retired_ });
+    std::atomic_store(&current_, published);
+    publishedSize_ = published->getEventLog().size();
+    sequence_.fetch_add(1, std::memory_order_release);
+
+    // 2) the next private graph: the most recently retired version, caught
+    //    up with the events published since, or else a copy
+    {
+        std::lock_guard<std::mutex> lock(retired_->mutex);
+        if (!retired_->graphs.empty()) {
+            head_ = std::move(retired_->graphs.back());
+            retired_->graphs.pop_back();
+        }
+    }
+    if (!head_) {
+        head_ = std::make_unique<Graph>(*published);
+        head_->attachWal(std::move(wal));
+        ++copies_;
+        return;
+    }
+    head_->attachWal(std::move(wal));
+    Graph& g = *head_;
+    size_t logSize = g.eventLog_.size();
+    for (const auto& chunk : published->getEventLog().sealedChunks(logSize)) {
+        g.eventLog_.append(chunk);
+        for (const auto& e : chunk) {
+            g.applyEventAt(e, ++logSize);
+            // same cadence as the mutators, so every version keeps the same checkpoints
+            if (logSize % Graph::kCheckpointInterval == 0) g.createCheckpoint(e.timestamp, logSize);
+        }
+    }
+}
+
+// ---- Readers ----
+
+std::shared_ptr<const Graph> VersionedGraph::current() const {
+    return std::atomic_load(&current_);
+}
+
+const Graph& VersionedGraph::Reader::get() {
+    const std::uint64_t seq = graph_->sequence_.load(std::memory_order_acquire);
+    if (!held_ || seq != seen_) {
+        held_ = graph_->current();
+        seen_ = seq;
+    }
+    return *held_;
+}
+
+}  // namespace chronograph
@@ -0,0 +1,247 @@
+// src/WriteAheadLog.cpp
+#include <chronograph/graph/WriteAheadLog.h>
+#include <chronograph/graph/EventCodec.h>
+#include <chronograph/graph/FileSync.h>
+#include <chronograph/graph/Hash.h>
+
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace chronograph {
+
+namespace {
+    constexpr char kMagic[8] = {'C','G','W','A','L','0','0','1'};
+    constexpr std::size_t kHeaderBytes = 9;          // length, crc, type
+    constexpr std::size_t kWriteThreshold = 1 << 20; // bytes buffered before a write
+
+    std::runtime_error ioError(const std::string& what, const std::string& path) {
+        return std::runtime_error("WriteAheadLog: " + what + " '" + path + "': " +
+                                  std::strerror(errno));
+    }
+
+    void encodeRecord(std::string& out, WriteAheadLog::RecordType type,
+                      const char* data, std::size_t len) {
+        const auto t = static_cast<char>(type);
+        std::uint32_t crc = crc32(&t, 1);
+        crc = crc32(data, len, crc);
+        putU32(out, static_cast<std::uint32_t>(len));
+        putU32(out, crc);
+        out.push_back(t);
+        out.append(data, len);
+    }
+
+    void writeAll(int fd, const std::string& bytes, const std::string& path) {
+        const char* p = bytes.data();
+        std::size_t left = bytes.size();
+        while (left > 0) {
+            ssize_t n = ::write(fd, p, left);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                throw ioError("cannot write", path);
+            }
+            p += n;
+            left -= static_cast<std::size_t>(n);
+        }
+    }
+} // anonymous
+
+WriteAheadLog::WriteAheadLog(const std::string& path, WalOptions options)
+    : WriteAheadLog(path, options, scanValidBytes(path)) {}
+
+WriteAheadLog::WriteAheadLog(const std::string& path, WalOptions options, std::size_t validBytes)
+    : path_(path), options_(options), lastSync_(std::chrono::steady_clock::now())
+{
+    // cut off a torn tail so new records follow the last valid one
+    std::error_code ec;
+    if (std::filesystem::exists(path, ec) &&
+        std::filesystem::file_size(path, ec) > validBytes) {
+        std::filesystem::resize_file(path, validBytes, ec);
+        if (ec) throw std::runtime_error("WriteAheadLog: cannot truncate '" + path + "'");
+    }
+
+    openForAppend();
+    if (validBytes == 0) {
+        buffer_.assign(kMagic, sizeof(kMagic));
+        syncLocked();
+    }
+    if (options_.syncInterval.count() > 0) {
+        flusher_ = std::thread([this] { flushLoop(); });
+    }
+}
+
+void WriteAheadLog::openForAppend() {
+    fd_ = ::open(path_.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd_ < 0) throw ioError("cannot open", path_);
+}
+
+WriteAheadLog::~WriteAheadLog() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    flusherWake_.notify_all();
+    if (flusher_.joinable()) flusher_.join();
+    try {
+        std::lock_guard<std::mutex> lock(mutex_);
+        syncLocked();
+    } catch (...) {
+        // nothing sensible to do while destroying
+    }
+    if (fd_ >= 0) ::close(fd_);
+}
+
+void WriteAheadLog::appendEvent(const Event& e) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    scratch_.clear();
+    encodeEvent(e, scratch_);
+    appendLocked(RecordType::EVENT, scratch_.data(), scratch_.size());
+}
+
+void WriteAheadLog::append(RecordType type, const std::string& payload) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    appendLocked(type, payload.data(), payload.size());
+}
+
+void WriteAheadLog::appendLocked(RecordType type, const char* data, std::size_t len) {
+    encodeRecord(buffer_, type, data, len);
+    ++records_;
+    ++pending_;
+
+    if (options_.syncEveryRecords && pending_ >= options_.syncEveryRecords) {
+        syncLocked();
+    } else if (buffer_.size() >= kWriteThreshold) {
+        writeBuffer();  // bound memory; durable at the next sync
+    }
+}
+
+void WriteAheadLog::writeBuffer() {
+    writeAll(fd_, buffer_, path_);
+    buffer_.clear();
+}
+
+void WriteAheadLog::flushLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+        const auto now = std::chrono::steady_clock::now();
+        const auto due = lastSync_ + options_.syncInterval;
+        if (pending_ > 0 && now >= due) {
+            try {
+                syncLocked();
+            } catch (const std::exception&) {
+                // the records stay buffered; sync() or the next append reports it
+                lastSync_ = now;
+            }
+            continue;
+        }
+        flusherWake_.wait_until(lock, pending_ > 0 ? due : now + options_.syncInterval);
+    }
+}
+
+void WriteAheadLog::sync() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    syncLocked();
+}
+
+void WriteAheadLog::syncLocked() {
+    writeBuffer();
+    if (::fsync(fd_) != 0) throw ioError("cannot fsync", path_);
+    pending_ = 0;
+    ++syncs_;
+    lastSync_ = std::chrono::steady_clock::now();
+}
+
+void WriteAheadLog::rewrite(const std::vector<Record>& records) {
+    std::string bytes(kMagic, sizeof(kMagic));
+    for (const auto& r : records) encodeRecord(bytes, r.type, r.payload.data(), r.payload.size());
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    // the rename is the commit point: a crash before it leaves the old log
+    replaceFile(path_, {bytes});
+
+    // later appends go to the new file
+    ::close(fd_);
+    buffer_.clear();
+    pending_ = 0;
+    openForAppend();
+    syncParentDirectory(path_);
+    ++syncs_;
+    lastSync_ = std::chrono::steady_clock::now();
+}
+
+std::size_t WriteAheadLog::recordCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return records_;
+}
+
+std::size_t WriteAheadLog::syncCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return syncs_;
+}
+
+std::size_t WriteAheadLog::scanValidBytes(const std::string& path) {
+    // record by record through one reused buffer: no copy of the log
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return 0;
+    std::error_code ec;
+    const std::size_t size = static_cast<std::size_t>(std::filesystem::file_size(path, ec));
+    char magic[sizeof(kMagic)];
+    if (ec || !in.read(magic, sizeof(magic))) return 0;   // empty, or a torn header
+    if (std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("WriteAheadLog: '" + path + "' is not a write-ahead log");
+    }
+
+    std::size_t valid = sizeof(kMagic);
+    char header[8];
+    std::string record;   // type + payload
+    while (in.read(header, sizeof(header))) {
+        const char* p = header;
+        const std::uint32_t len = getU32(p, header + sizeof(header));
+        const std::uint32_t crc = getU32(p, header + sizeof(header));
+        if (size - valid - sizeof(header) < 1 + static_cast<std::size_t>(len)) break;
+        record.resize(1 + static_cast<std::size_t>(len));
+        if (!in.read(&record[0], static_cast<std::streamsize>(record.size()))) break;
+        if (crc32(record.data(), record.size()) != crc) break;
+        valid += sizeof(header) + record.size();
+    }
+    return valid;
+}
+
+WriteAheadLog::ReadResult WriteAheadLog::read(const std::string& path) {
+    ReadResult result;
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return result;
+    std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (bytes.empty()) return result;
+    if (bytes.size() < sizeof(kMagic)) {
+        result.tornTail = true;  // crashed while writing the header
+        return result;
+    }
+    if (bytes.compare(0, sizeof(kMagic), kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("WriteAheadLog: '" + path + "' is not a write-ahead log");
+    }
+
+    const char* pos = bytes.data() + sizeof(kMagic);
+    const char* end = bytes.data() + bytes.size();
+    result.validBytes = sizeof(kMagic);
+    while (static_cast<std::size_t>(end - pos) >= kHeaderBytes) {
+        const char* p = pos;
+        std::uint32_t len = getU32(p, end);
+        std::uint32_t crc = getU32(p, end);
+        if (static_cast<std::size_t>(end - p) < 1 + static_cast<std::size_t>(len)) break;
+        if (crc32(p, 1 + len) != crc) break;
+        result.records.push_back({static_cast<RecordType>(*p), std::string(p + 1, len)});
+        pos = p + 1 + len;
+        result.validBytes = static_cast<std::size_t>(pos - bytes.data());
+    }
+    result.tornTail = result.validBytes < bytes.size();
+    return result;
+}
+
+}  // namespace chronograph
@@ -0,0 +1,137 @@
+#include <chronograph/graph/algorithms/Cache.h>
+#include <chronograph/graph/algorithms/Connectivity.h>
+#include <chronograph/graph/algorithms/Paths.h>
+#include <chronograph/graph/Graph.h>
+#include <chronograph/graph/EventCodec.h>
+#include <initializer_list>
+#include <stdexcept>
+
+namespace chronograph {
+namespace graph {
+namespace algorithms {
+
+AlgorithmCache::AlgorithmCache(std::size_t capacity)
+    : capacity_(capacity)
+{
+    if (capacity_ == 0) {
+        throw std::invalid_argument("AlgorithmCache capacity must be positive");
+    }
+}
+
+std::string AlgorithmCache::makeKey(const std::string& algorithm,
+                                    const std::string& params,
+                                    std::uint64_t version)
+{
+    // the length-prefixed name and the fixed-width version end where the
+    // params begin, so no two triples share a key
+    std::string key;
+    key.reserve(algorithm.size() + params.size() + 12);
+    putString(key, algorithm);
+    putU64(key, version);
+    key += params;
+    return key;
+}
+
+std::optional<std::any> AlgorithmCache::lookup(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+        ++misses_;
+        return std::nullopt;
+    }
+    ++hits_;
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return it->second->second;
+}
+
+void AlgorithmCache::insert(std::string key, std::any value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (auto it = index_.find(key); it != index_.end()) {
+        // another thread computed it meanwhile
+        it->second->second = std::move(value);
+        lru_.splice(lru_.begin(), lru_, it->second);
+        return;
+    }
+    lru_.emplace_front(key, std::move(value));
+    index_.emplace(std::move(key), lru_.begin());
+    while (lru_.size() > capacity_) {
+        index_.erase(lru_.back().first);
+        lru_.pop_back();
+    }
+}
+
+std::size_t AlgorithmCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lru_.size();
+}
+
+std::size_t AlgorithmCache::hits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+}
+
+std::size_t AlgorithmCache::misses() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return misses_;
+}
+
+void AlgorithmCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    lru_.clear();
+    index_.clear();
+}
+
+// ---- Cached algorithm wrappers ----
+
+namespace {
+// Length-prefix each parameter: IDs may contain any byte, so no separator
+// could tell ("a\0", "b") from ("a", "\0b")
+std::string joinParams(std::initializer_list<const std::string*> params) {
+    std::string out;
+    for (const auto* p : params) putString(out, *p);
+    return out;
+}
+}  // namespace
+
+std::vector<std::vector<std::string>>
+cachedStronglyConnectedComponents(AlgorithmCache& cache, const Graph& g) {
+    using R = std::vector<std::vector<std::string>>;
+    return cache.getOrCompute<R>("scc", "", g.version(),
+        [&] { return stronglyConnectedComponents(g); });
+}
+
+std::vector<std::vector<std::string>>
+cachedWeaklyConnectedComponents(AlgorithmCache& cache, const Graph& g) {
+    using R = std::vector<std::vector<std::string>>;
+    return cache.getOrCompute<R>("wcc", "", g.version(),
+        [&] { return weaklyConnectedComponents(g); });
+}
+
+std::optional<std::vector<std::string>>
+cachedTopologicalSort(AlgorithmCache& cache, const Graph& g) {
+    using R = std::optional<std::vector<std::string>>;
+    return cache.getOrCompute<R>("toposort", "", g.version(),
+        [&] { return topologicalSort(g); });
+}
+
+std::vector<std::string>
+cachedShortestPath(AlgorithmCache& cache, const Graph& g,
+                   const std::string& start, const std::string& target) {
+    using R = std::vector<std::string>;
+    return cache.getOrCompute<R>("shortestPath", joinParams({&start, &target}),
+        g.version(), [&] { return shortestPath(g, start, target); });
+}
+
+std::vector<std::string>
+cachedDijkstra(AlgorithmCache& cache, const Graph& g,
+               const std::string& start, const std::string& target,
+               const std::string& weightKey) {
+    using R = std::vector<std::string>;
+    return cache.getOrCompute<R>("dijkstra",
+        joinParams({&start, &target, &weightKey}), g.version(),
+        [&] { return dijkstra(g, start, target, weightKey); });
+}
+
+}  // namespace algorithms
+}  // namespace graph
+}  // namespace chronograph
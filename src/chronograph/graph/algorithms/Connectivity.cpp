@@ -1,5 +1,8 @@
 #include <chronograph/graph/algorithms/Connectivity.h>
 #include <chronograph/graph/Graph.h>
+#include <chronograph/graph/Snapshot.h>
+#include <chronograph/graph/CsrGraph.h>
+#include <chronograph/graph/FilteredView.h>
 #include <queue>
 #include <unordered_set>
 #include <unordered_map>
@@ -11,21 +14,19 @@ namespace chronograph {
 namespace graph {
 namespace algorithms {
 
+template <typename G>
 std::vector<std::vector<std::string>>
-weaklyConnectedComponents(const Graph& g) {
-    // Grab adjacency in both directions
-    const auto& out = g.getOutgoing();
-    const auto& in  = g.getIncoming();
-    const auto& edges = g.getEdges();
-    const auto& nodes = g.getNodes();
+weaklyConnectedComponents(const G& g) {
+    using View = GraphViewTraits<G>;
 
     std::unordered_set<std::string> visited;
     std::vector<std::vector<std::string>> components;
-    components.reserve(nodes.size());
+    components.reserve(View::nodeCount(g));
 
     // For every node in the graph:
-    for (const auto& [nid, node] : nodes) {
-        if (visited.count(nid)) continue;
+    View::forEachNode(g, [&](const Node& node) {
+        const std::string& nid = node.id;
+        if (visited.count(nid)) return;
 
         // Start a BFS from nid over undirected neighbors
         std::vector<std::string> comp;
@@ -38,143 +39,75 @@ weaklyConnectedComponents(const Graph& g) {
             comp.push_back(u);
 
             // Outgoing edges → neighbors
-            if (auto oit = out.find(u); oit != out.end()) {
-                for (auto& eid : oit->second) {
-                    if (auto eit = edges.find(eid); eit != edges.end()) {
-                        const auto& v = eit->second.to;
-                        if (!visited.count(v)) {
-                            visited.insert(v);
-                            q.push(v);
-                        }
-                    }
-                }
-            }
+            View::forEachOutEdge(g, u, [&](const Edge& e) {
+                if (visited.insert(e.to).second) q.push(e.to);
+            });
 
             // Incoming edges → neighbors
-            if (auto iit = in.find(u); iit != in.end()) {
-                for (auto& eid : iit->second) {
-                    if (auto eit = edges.find(eid); eit != edges.end()) {
-                        const auto& v = eit->second.from;
-                        if (!visited.count(v)) {
-                            visited.insert(v);
-                            q.push(v);
-                        }
-                    }
-                }
-            }
+            View::forEachInEdge(g, u, [&](const Edge& e) {
+                if (visited.insert(e.from).second) q.push(e.from);
+            });
         }
 
         components.push_back(std::move(comp));
-    }
+    });
 
     return components;
 }
 
-static void tarjanDFS(const Graph& g,
-    const std::string& v,
-    int& index,
-    std::unordered_map<std::string,int>& indexes,
-    std::unordered_map<std::string,int>& lowlinks,
-    std::vector<std::string>& stack,
-    std::unordered_set<std::string>& onStack,
-    std::vector<std::vector<std::string>>& comps)
-    {
-    indexes[v] = index;
-    lowlinks[v] = index;
-    ++index;
-
-    stack.push_back(v);
-    onStack.insert(v);
-
-    // For each neighbor w of v
-    const auto& out = g.getOutgoing();
-    const auto& edges = g.getEdges();
-    auto oit = out.find(v);
-    if (oit != out.end()) {
-        for (const auto& eid : oit->second) {
-            auto eit = edges.find(eid);
-            if (eit == edges.end()) continue;
-            const auto& w = eit->second.to;
-
-            if (!indexes.count(w)) {
-            // not visited
-                tarjanDFS(g, w, index, indexes, lowlinks, stack, onStack, comps);
-                lowlinks[v] = std::min(lowlinks[v], lowlinks[w]);
-            }
-            else if (onStack.count(w)) {
-                lowlinks[v] = std::min(lowlinks[v], indexes[w]);
-            }
-        }
-    }
+// Kosaraju pass 1: DFS on the original graph, recording finish order
+template <typename G>
+static void finishOrderDFS(const G& g,
+    const std::string& u,
+    std::unordered_set<std::string>& visited,
+    std::vector<std::string>& finishOrder)
+{
+    visited.insert(u);
+    GraphViewTraits<G>::forEachOutEdge(g, u, [&](const Edge& e) {
+        if (!visited.count(e.to)) finishOrderDFS(g, e.to, visited, finishOrder);
+    });
+    finishOrder.push_back(u);
+}
 
-    // If v is a root node, pop the stack and generate an SCC
-    if (lowlinks[v] == indexes[v]) {
-        std::vector<std::string> comp;
-        while (true) {
-            std::string w = stack.back();
-            stack.pop_back();
-            onStack.erase(w);
-            comp.push_back(std::move(w));
-            if (w == v) break;
-        }
-        comps.push_back(std::move(comp));
-    }
+// Kosaraju pass 2: DFS on the *reversed* graph, collecting one component
+template <typename G>
+static void collectReversedDFS(const G& g,
+    const std::string& u,
+    std::unordered_set<std::string>& visited,
+    std::vector<std::string>& comp)
+{
+    visited.insert(u);
+    comp.push_back(u);
+    GraphViewTraits<G>::forEachInEdge(g, u, [&](const Edge& e) {
+        if (!visited.count(e.from)) collectReversedDFS(g, e.from, visited, comp);
+    });
 }
 
+template <typename G>
 std::vector<std::vector<std::string>>
-stronglyConnectedComponents(const Graph& g)
+stronglyConnectedComponents(const G& g)
 {
-    const auto& nodes = g.getNodes();
-    const auto& out   = g.getOutgoing();
-    const auto& in    = g.getIncoming();
-    const auto& edges = g.getEdges();
+    using View = GraphViewTraits<G>;
 
     std::unordered_set<std::string> visited;
     std::vector<std::string>        finishOrder;
-    finishOrder.reserve(nodes.size());
+    finishOrder.reserve(View::nodeCount(g));
 
     // 1) DFS1: on original graph to compute finish times
-    std::function<void(const std::string&)> dfs1 = [&](auto const& u) {
-        visited.insert(u);
-        if (auto oit = out.find(u); oit != out.end()) {
-            for (auto const& eid : oit->second) {
-                if (auto eit = edges.find(eid); eit != edges.end()) {
-                    auto const& v = eit->second.to;
-                    if (!visited.count(v)) dfs1(v);
-                }
-            }
-        }
-        finishOrder.push_back(u);
-    };
-
-    for (auto const& [nid, node] : nodes) {
-        if (!visited.count(nid)) dfs1(nid);
-    }
+    View::forEachNode(g, [&](const Node& node) {
+        if (!visited.count(node.id)) finishOrderDFS(g, node.id, visited, finishOrder);
+    });
 
     // 2) DFS2: on the *reversed* graph, in reverse finish order
     visited.clear();
     std::vector<std::vector<std::string>> components;
-    components.reserve(nodes.size());
-
-    std::function<void(const std::string&, std::vector<std::string>&)> dfs2 =
-        [&](auto const& u, auto& comp) {
-            visited.insert(u);
-            comp.push_back(u);
-            if (auto iit = in.find(u); iit != in.end()) {
-                for (auto const& eid : iit->second) {
-                    if (auto eit = edges.find(eid); eit != edges.end()) {
-                        auto const& v = eit->second.from;
-                        if (!visited.count(v)) dfs2(v, comp);
-                    }
-                }
-            }
-        };
+    components.reserve(View::nodeCount(g));
 
     // Process nodes in decreasing finish time
     for (auto it = finishOrder.rbegin(); it != finishOrder.rend(); ++it) {
         if (!visited.count(*it)) {
             std::vector<std::string> comp;
-            dfs2(*it, comp);
+            collectReversedDFS(g, *it, visited, comp);
             components.push_back(std::move(comp));
         }
     }
@@ -185,85 +118,73 @@ stronglyConnectedComponents(const Graph& g)
 
 
 // Directed cycle detection via DFS + recursion stack
+template <typename G>
 static bool dfsDetectCycle(
-    const Graph& g,
+    const G& g,
     const std::string& u,
     std::unordered_map<std::string,int>& state  // 0=unseen,1=visiting,2=done
 ) {
     state[u] = 1;  // visiting
 
-    const auto& outEdges = g.getOutgoing();
-    const auto& edges    = g.getEdges();
-
-    if (auto oit = outEdges.find(u); oit != outEdges.end()) {
-        for (auto const& eid : oit->second) {
-            auto eit = edges.find(eid);
-            if (eit == edges.end()) continue;
-            const auto& v = eit->second.to;
+    bool cycle = false;
+    GraphViewTraits<G>::forEachOutEdge(g, u, [&](const Edge& e) {
+        if (cycle) return;
+        const auto& v = e.to;
 
-            // if neighbor is in recursion stack -> cycle
-            if (state[v] == 1) {
-                return true;
-            }
-            // if unseen, recurse
-            if (state[v] == 0) {
-                if (dfsDetectCycle(g, v, state)) {
-                    return true;
-                }
-            }
+        // if neighbor is in recursion stack -> cycle
+        if (state[v] == 1) {
+            cycle = true;
         }
-    }
+        // if unseen, recurse
+        else if (state[v] == 0 && dfsDetectCycle(g, v, state)) {
+            cycle = true;
+        }
+    });
+    if (cycle) return true;
 
     state[u] = 2;  // done
     return false;
 }
 
-bool hasCycle(const Graph& g) {
-    const auto& nodes = g.getNodes();
+template <typename G>
+bool hasCycle(const G& g) {
+    using View = GraphViewTraits<G>;
+
     // track visitation state for each node
     std::unordered_map<std::string,int> state;
-    state.reserve(nodes.size());
-    for (auto const& [nid, _] : nodes) {
-        state[nid] = 0;
-    }
+    state.reserve(View::nodeCount(g));
+    View::forEachNode(g, [&](const Node& node) { state[node.id] = 0; });
 
     // run DFS from each unvisited node
-    for (auto const& [nid, _] : nodes) {
-        if (state[nid] == 0) {
-            if (dfsDetectCycle(g, nid, state)) {
-                return true;
-            }
+    bool cycle = false;
+    View::forEachNode(g, [&](const Node& node) {
+        if (!cycle && state[node.id] == 0) {
+            cycle = dfsDetectCycle(g, node.id, state);
         }
-    }
-    return false;
+    });
+    return cycle;
 }
 
+template <typename G>
 std::optional<std::vector<std::string>>
-topologicalSort(const Graph& g)
+topologicalSort(const G& g)
 {
-    // 1) Gather all nodes and build in‐degree map
-    const auto& nodes    = g.getNodes();
-    const auto& outEdges = g.getOutgoing();
-    const auto& edges    = g.getEdges();
+    using View = GraphViewTraits<G>;
 
+    // 1) Gather all nodes and build in‐degree map
     std::unordered_map<std::string,int> indegree;
-    indegree.reserve(nodes.size());
-    for (const auto& [nid, _] : nodes) {
-        indegree[nid] = 0;
-    }
+    indegree.reserve(View::nodeCount(g));
+    View::forEachNode(g, [&](const Node& node) { indegree[node.id] = 0; });
 
     // For every outgoing edge u→v, increment indegree[v]
-    for (const auto& [u, eids] : outEdges) {
-        for (const auto& eid : eids) {
-            auto it = edges.find(eid);
-            if (it == edges.end()) continue;
-            const auto& v = it->second.to;
+    View::forEachNode(g, [&](const Node& node) {
+        View::forEachOutEdge(g, node.id, [&](const Edge& e) {
             // only count if v is a known node
-            if (indegree.count(v)) {
-                indegree[v]++;
+            if (auto dit = indegree.find(e.to); dit != indegree.end()) {
+                dit->second++;
             }
-        }
-    }
+        });
+    });
 
     // 2) Initialize queue with all zero‐indegree nodes
     std::queue<std::string> q;
@@ -272,7 +193,7 @@ topologicalSort(const Graph& g)
     }
 
     std::vector<std::string> order;
-    order.reserve(nodes.size());
+    order.reserve(indegree.size());
 
     // 3) Kahn’s algorithm
     while (!q.empty()) {
@@ -280,29 +201,37 @@ topologicalSort(const Graph& g)
         order.push_back(u);
 
         // For each neighbor v of u
-        auto oit = outEdges.find(u);
-        if (oit == outEdges.end()) continue;
-        for (const auto& eid : oit->second) {
-            auto eit = edges.find(eid);
-            if (eit == edges.end()) continue;
-            const auto& v = eit->second.to;
-            auto dit = indegree.find(v);
-            if (dit == indegree.end()) continue;
+        View::forEachOutEdge(g, u, [&](const Edge& e) {
+            auto dit = indegree.find(e.to);
+            if (dit == indegree.end()) return;
             if (--(dit->second) == 0) {
-                q.push(v);
+                q.push(e.to);
             }
-        }
+        });
     }
 
     // 4) If we ordered all nodes, succeed; else cycle detected
-    if (order.size() == nodes.size()) {
+    if (order.size() == indegree.size()) {
         return order;
     } else {
         return std::nullopt;
     }
 }
 
+// ——— Explicit instantiations for every GraphView ———
+#define CHRONOGRAPH_INSTANTIATE_CONNECTIVITY(G)                            \
+    template std::vector<std::vector<std::string>>                         \
+        weaklyConnectedComponents<G>(const G&);                            \
+    template std::vector<std::vector<std::string>>                         \
+        stronglyConnectedComponents<G>(const G&);                          \
+    template bool hasCycle<G>(const G&);                                   \
+    template std::optional<std::vector<std::string>>                       \
+        topologicalSort<G>(const G&);
+
+CHRONOGRAPH_GRAPH_VIEW_TYPES(CHRONOGRAPH_INSTANTIATE_CONNECTIVITY)
+
+#undef CHRONOGRAPH_INSTANTIATE_CONNECTIVITY
+
 }  // namespace algorithms
 }  // namespace graph
 }  // namespace chronograph
-
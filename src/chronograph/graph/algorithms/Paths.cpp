@@ -1,5 +1,9 @@
+
 #include <chronograph/graph/algorithms/Paths.h>
 #include <chronograph/graph/Graph.h>
+#include <chronograph/graph/Snapshot.h>
+#include <chronograph/graph/CsrGraph.h>
+#include <chronograph/graph/FilteredView.h>
 #include <queue>
 #include <unordered_set>
 #include <unordered_map>
@@ -7,6 +11,7 @@
 #include <algorithm>
 #include <sstream>
 #include <cmath>
+#include <limits>
 #include <utility>
 
 
@@ -14,23 +19,20 @@ namespace chronograph {
 namespace graph {
 namespace algorithms {
 
-bool isReachable(const Graph& g,
+template <typename G>
+bool isReachable(const G& g,
                  const std::string& start,
                  const std::string& target)
 {
-    // Maps node -> list of outgoing edge IDs
-    const auto& outEdges = g.getOutgoing();
-    // Maps edge ID -> Edge struct (with .to, .from)
-    const auto& edges = g.getEdges();
+    using View = GraphViewTraits<G>;
 
     // Trivial self‐case: only if the node exists
     if (start == target) {
-        return outEdges.find(start) != outEdges.end();
+        return View::findNode(g, start) != nullptr;
     }
 
     // Can't start if the node isn't known
-    auto itStart = outEdges.find(start);
-    if (itStart == outEdges.end()) {
+    if (!View::findNode(g, start)) {
         return false;
     }
 
@@ -41,43 +43,37 @@ bool isReachable(const Graph& g,
     visited.insert(start);
     q.push(start);
 
-    while (!q.empty()) {
+    bool found = false;
+    while (!q.empty() && !found) {
         const auto u = q.front(); q.pop();
 
-        // For each outgoing edge ID from u...
-        auto oit = outEdges.find(u);
-        if (oit == outEdges.end()) continue;
-
-        for (const auto& eid : oit->second) {
-            // Find the edge record
-            auto eit = edges.find(eid);
-            if (eit == edges.end()) continue;
-
-            const std::string& v = eit->second.to;
+        // For each outgoing edge from u...
+        View::forEachOutEdge(g, u, [&](const Edge& e) {
+            if (found) return;
+            const std::string& v = e.to;
             // if found, its reachable
-            if (v == target) return true;
+            if (v == target) { found = true; return; }
             // Otherwise enqueue if unseen
-            if (!visited.count(v)) {
-                visited.insert(v);
+            if (visited.insert(v).second) {
                 q.push(v);
             }
-        }
+        });
     }
 
-    return false;
+    return found;
 }
 
-std::vector<std::string> shortestPath(const Graph& g,
+template <typename G>
+std::vector<std::string> shortestPath(const G& g,
                                       const std::string& start,
                                       const std::string& target)
 {
-    const auto& outEdges = g.getOutgoing();
-    const auto& edges    = g.getEdges();
+    using View = GraphViewTraits<G>;
 
     // Special case: path from a node to itself
     if (start == target) {
         // if the node exists, return path to just itself
-        if (outEdges.find(start) != outEdges.end()) {
+        if (View::findNode(g, start)) {
             return { start };
         } else {
             return {};
@@ -85,8 +81,7 @@ std::vector<std::string> shortestPath(const Graph& g,
     }
 
     // Ensure start and target exist
-    if (outEdges.find(start) == outEdges.end() ||
-        outEdges.find(target) == outEdges.end()) {
+    if (!View::findNode(g, start) || !View::findNode(g, target)) {
         return {};
     }
 
@@ -102,23 +97,18 @@ std::vector<std::string> shortestPath(const Graph& g,
     while (!q.empty() && !found) {
         auto u = q.front(); q.pop();
 
-        auto oit = outEdges.find(u);
-        if (oit == outEdges.end()) continue;
-
-        for (const auto& eid : oit->second) {
-            auto eit = edges.find(eid);
-            if (eit == edges.end()) continue;
-            const std::string& v = eit->second.to;
-            if (!visited.count(v)) {
-                visited.insert(v);
+        View::forEachOutEdge(g, u, [&](const Edge& e) {
+            if (found) return;
+            const std::string& v = e.to;
+            if (visited.insert(v).second) {
                 prev[v] = u;
                 if (v == target) {
                     found = true;
-                    break;
+                    return;
                 }
                 q.push(v);
             }
-        }
+        });
     }
 
     if (!found) {
@@ -141,62 +131,26 @@ bool isReachableAt(const Graph& g,
     const std::string& target,
     std::int64_t timestamp)
 {
-    // Build snapshot at T
+    // Build snapshot at T and run the generic BFS on it
     Snapshot snap(g, timestamp);
-
-    // Use the same BFS logic, but on the snapshot
-    const auto& outEdges = snap.getOutgoing();
-    const auto& edges    = snap.getEdges();
-
-    if (start == target) {
-        return outEdges.find(start) != outEdges.end();
-    }
-    auto itStart = outEdges.find(start);
-    if (itStart == outEdges.end()) {
-        return false;
-    }
-
-    std::unordered_set<std::string> visited;
-    std::queue<std::string> q;
-    visited.insert(start);
-    q.push(start);
-
-    while (!q.empty()) {
-        const auto u = q.front(); q.pop();
-        auto oit = outEdges.find(u);
-        if (oit == outEdges.end()) continue;
-        for (const auto& eid : oit->second) {
-            auto eit = edges.find(eid);
-            if (eit == edges.end()) continue;
-            const auto& v = eit->second.to;
-            if (v == target) return true;
-            if (!visited.count(v)) {
-                visited.insert(v);
-                q.push(v);
-            }
-        }
-    }
-    return false;
+    return isReachable(snap, start, target);
 }
 
-bool isTimeRespectingReachable(const Graph& g,
+template <typename G>
+bool isTimeRespectingReachable(const G& g,
     const std::string& start,
     const std::string& target)
 {
+    using View = GraphViewTraits<G>;
+
     // Quick checks
-    const auto& nodes = g.getNodes();
-    if (!nodes.count(start) || !nodes.count(target)) {
+    if (!View::findNode(g, start) || !View::findNode(g, target)) {
         return false;
     }
     if (start == target) {
         return true;
     }
 
-    // Adjacency: node -> list of edge-IDs
-    const auto& outEdges = g.getOutgoing();
-    // Edge storage: edge-ID -> Edge
-    const auto& edges = g.getEdges();
-
     // Keep track of the smallest timestamp at reached each node
     std::unordered_map<std::string, std::int64_t> bestTime;
     std::queue<std::pair<std::string, std::int64_t>> q;
@@ -205,26 +159,23 @@ bool isTimeRespectingReachable(const Graph& g,
     bestTime[start] = std::numeric_limits<std::int64_t>::min();
     q.push({start, bestTime[start]});
 
-    while (!q.empty()) {
+    bool found = false;
+    while (!q.empty() && !found) {
         auto [u, lastTs] = q.front();
         q.pop();
 
-        auto oit = outEdges.find(u);
-        if (oit == outEdges.end()) continue;
-
-        for (auto const& eid : oit->second) {
-            auto eit = edges.find(eid);
-            if (eit == edges.end()) continue;
-            const auto& edge = eit->second;
+        View::forEachOutEdge(g, u, [&, lastTs = lastTs](const Edge& edge) {
+            if (found) return;
             std::int64_t ts  = edge.createdTimestamp;  // creation time of this edge
 
             // skip "back in time edges"
             // only allows nondecreasing paths
-            if (ts < lastTs) continue;
+            if (ts < lastTs) return;
 
             const auto& v = edge.to;
             if (v == target) {
-                return true;
+                found = true;
+                return;
             }
 
             // if v is not visited, or found a strictly smaller arrival time
@@ -233,25 +184,23 @@ bool isTimeRespectingReachable(const Graph& g,
                 bestTime[v] = ts;
                 q.push({v, ts});
             }
-        }
+        });
     }
 
-    return false;
+    return found;
 }
 
+template <typename G>
 std::vector<std::string> dijkstra(
-    const Graph&       g,
+    const G&           g,
     const std::string& start,
     const std::string& target,
     const std::string& weightKey)
 {
-    const auto& adjAll    = g.getOutgoing();
-    const auto& allEdges  = g.getEdges();
-    const auto& allNodes  = g.getNodes();
+    using View = GraphViewTraits<G>;
 
     // 1) Make sure both start and target exist as nodes.
-    if (allNodes.find(start) == allNodes.end() ||
-        allNodes.find(target) == allNodes.end()) {
+    if (!View::findNode(g, start) || !View::findNode(g, target)) {
         return {};
     }
 
@@ -266,14 +215,11 @@ std::vector<std::string> dijkstra(
                         std::vector<DistNode>,
                         Compare> pq;
 
-    // 3) Distance map & parent map
+    // 3) Distance map & parent map (missing entry = +∞)
     std::unordered_map<std::string, double> dist;
     std::unordered_map<std::string, std::string> parent;
+    dist.reserve(View::nodeCount(g));
 
-    // Initialize distances to +∞ for every node
-    for (auto const& [nid, _] : allNodes) {
-        dist[nid] = std::numeric_limits<double>::infinity();
-    }
     dist[start] = 0.0;
     pq.push({0.0, start});
 
@@ -288,52 +234,30 @@ std::vector<std::string> dijkstra(
         // Early exit if we reached target
         if (u == target) break;
 
-        // Fetch neighbors of u (if any). If none, treat as empty list.
-        auto itU = adjAll.find(u);
-        if (itU == adjAll.end()) {
-            // No outgoing edges → nothing to relax.
-            continue;
-        }
-
-        for (auto const& v : itU->second) {
-            // We need to find the minimum weight among all edges from u→v
-            double bestWeight = std::numeric_limits<double>::infinity();
-            bool   foundValid = false;
-
-            // Scan every edge in allEdges
-            for (auto const& [eid, e] : allEdges) {
-                if (e.from == u && e.to == v) {
-                    auto lit = e.attributes.find(weightKey);
-                    if (lit == e.attributes.end()) continue;
-
-                    // Try parsing the attribute string into a double
-                    double w = std::nan("");
-                    std::istringstream iss(lit->second);
-                    iss >> w;
-                    if (iss.fail() || std::isnan(w)) continue;
-
-                    // If multiple edges u→v exist, pick the smallest numeric weight
-                    if (!foundValid || w < bestWeight) {
-                        bestWeight = w;
-                        foundValid = true;
-                    }
-                }
-            }
-
-            // If we never found a parsable weight for ANY edge u→v, skip this neighbor
-            if (!foundValid) continue;
-
-            double d_v = d_u + bestWeight;
-            if (d_v < dist[v]) {
-                dist[v] = d_v;
-                parent[v] = u;
-                pq.push({d_v, v});
+        // Relax every outgoing edge that carries a parsable weight.
+        // Parallel edges u→v are handled naturally: the cheapest one wins.
+        View::forEachOutEdge(g, u, [&, d_u = d_u, u = u](const Edge& e) {
+            auto lit = e.attributes.find(weightKey);
+            if (lit == e.attributes.end()) return;
+
+            // Try parsing the attribute string into a double
+            double w = std::nan("");
+            std::istringstream iss(lit->second);
+            iss >> w;
+            if (iss.fail() || std::isnan(w)) return;
+
+            double d_v = d_u + w;
+            auto dit = dist.find(e.to);
+            if (dit == dist.end() || d_v < dit->second) {
+                dist[e.to] = d_v;
+                parent[e.to] = u;
+                pq.push({d_v, e.to});
             }
-        }
+        });
     }
 
-    // 5) If target was never reached (distance still ∞), return empty
-    if (dist[target] == std::numeric_limits<double>::infinity()) {
+    // 5) If target was never reached, return empty
+    if (!dist.count(target)) {
         return {};
     }
 
@@ -348,6 +272,20 @@ std::vector<std::string> dijkstra(
     return path;
 }
 
+// ——— Explicit instantiations for every GraphView ———
+#define CHRONOGRAPH_INSTANTIATE_PATHS(G)                                   \
+    template bool isReachable<G>(const G&,                                 \
+        const std::string&, const std::string&);                           \
+    template std::vector<std::string> shortestPath<G>(const G&,            \
+        const std::string&, const std::string&);                           \
+    template bool isTimeRespectingReachable<G>(const G&,                   \
+        const std::string&, const std::string&);                           \
+    template std::vector<std::string> dijkstra<G>(const G&,                \
+        const std::string&, const std::string&, const std::string&);
+
+CHRONOGRAPH_GRAPH_VIEW_TYPES(CHRONOGRAPH_INSTANTIATE_PATHS)
+
+#undef CHRONOGRAPH_INSTANTIATE_PATHS
 
 }  // namespace algorithms
 }  // namespace graph
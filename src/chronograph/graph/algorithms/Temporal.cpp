@@ -0,0 +1,312 @@
+#include <chronograph/graph/algorithms/Temporal.h>
+#include <chronograph/graph/algorithms/Connectivity.h>
+#include <chronograph/graph/algorithms/Paths.h>
+#include <chronograph/graph/Graph.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace chronograph {
+namespace graph {
+namespace algorithms {
+
+namespace {
+
+void requireSorted(const std::vector<std::int64_t>& timestamps) {
+    if (!std::is_sorted(timestamps.begin(), timestamps.end())) {
+        throw std::invalid_argument("timestamps must be sorted in non-decreasing order");
+    }
+}
+
+/// Starting state of a sweep: the base state of a compacted graph.
+/// Throws std::runtime_error if a timestamp is before the compaction horizon.
+Graph initialState(const Graph& g, const std::vector<std::int64_t>& timestamps) {
+    if (!timestamps.empty() && timestamps.front() < g.compactionHorizon()) {
+        throw std::runtime_error("timestamp " + std::to_string(timestamps.front()) +
+                                 " is before the compaction horizon");
+    }
+    return g.baseState();
+}
+
+/**
+ * Drive a single forward pass over the event log of `g`.
+ * - `onEvent(e)` is called for every event *before* it is applied to `state`.
+ * - `onCut(i)` is called once `state` reflects timestamps[i]; returning false
+ *   stops the sweep early.
+ */
+template <typename OnEvent, typename OnCut>
+void replayAcross(const Graph& g,
+                  const std::vector<std::int64_t>& timestamps,
+                  Graph& state,
+                  OnEvent&& onEvent,
+                  OnCut&& onCut)
+{
+    const auto& events = g.getEventLog();
+
+    auto next = events.begin();
+    for (size_t i = 0; i < timestamps.size(); ++i) {
+        // same cut rule as Snapshot: stop at the first event past T
+        while (next != events.end() && next->timestamp <= timestamps[i]) {
+            onEvent(*next);
+            state.applyEvent(*next);
+            ++next;
+        }
+        if (!onCut(i)) return;
+    }
+}
+
+/// Tracks whether a reachability answer can be reused between cuts.
+// * no structural change -> answer unchanged
+// * only additions       -> a reachable pair stays reachable
+struct ReachabilityTracker {
+    bool changed = false;
+    bool removed = false;
+    bool evaluated = false;
+    bool last = false;
+
+    void observe(const Event& e, const Graph& state) {
+        switch (e.type) {
+          case EventType::ADD_NODE:
+            changed = true;
+            break;
+          case EventType::ADD_EDGE:
+            changed = true;
+            // re-adding an edge ID rewires existing adjacency entries
+            if (state.getEdges().count(e.entityId)) removed = true;
+            break;
+          case EventType::DEL_NODE:
+          case EventType::DEL_EDGE:
+            changed = true;
+            removed = true;
+            break;
+          case EventType::UPDATE_NODE:
+          case EventType::UPDATE_EDGE:
+            break;
+        }
+    }
+
+    bool evaluate(const Graph& state,
+                  const std::string& start,
+                  const std::string& target) {
+        bool reuse = evaluated && (!changed || (last && !removed));
+        if (!reuse) {
+            last = isReachable(state, start, target);
+            evaluated = true;
+        }
+        changed = removed = false;
+        return last;
+    }
+};
+
+/// Incremental weakly-connected component count.
+// * new nodes and edges between live nodes go through union-find
+// * anything else marks the count dirty; it is recomputed at the next cut
+class ComponentTracker {
+public:
+    // a non-empty starting state (compacted graph) is counted at the first cut
+    explicit ComponentTracker(const Graph& initial) : dirty_(!initial.getNodes().empty()) {}
+
+    void observe(const Event& e, const Graph& state) {
+        if (dirty_) return;
+        const auto& nodes = state.getNodes();
+        switch (e.type) {
+          case EventType::ADD_NODE:
+            if (nodes.count(e.entityId)) return;  // attribute overwrite only
+            if (parent_.count(e.entityId) ||
+                state.getOutgoing().count(e.entityId) ||
+                state.getIncoming().count(e.entityId)) {
+                // ID already seen as a dangling edge endpoint
+                dirty_ = true;
+                return;
+            }
+            parent_.emplace(e.entityId, e.entityId);
+            ++count_;
+            break;
+
+          case EventType::ADD_EDGE:
+            if (state.getEdges().count(e.entityId) ||
+                !nodes.count(e.from) || !nodes.count(e.to)) {
+                dirty_ = true;
+                return;
+            }
+            if (unite(e.from, e.to)) --count_;
+            break;
+
+          case EventType::UPDATE_NODE:
+          case EventType::UPDATE_EDGE:
+            break;
+
+          case EventType::DEL_NODE:
+          case EventType::DEL_EDGE:
+            dirty_ = true;
+            break;
+        }
+    }
+
+    std::size_t count(const Graph& state) {
+        if (dirty_) rebuild(state);
+        return count_;
+    }
+
+private:
+    std::unordered_map<std::string, std::string> parent_;
+    std::size_t count_ = 0;
+    bool dirty_ = false;
+
+    std::string find(std::string x) {
+        // path halving
+        while (true) {
+            std::string& p = parent_.at(x);
+            if (p == x) return x;
+            p = parent_.at(p);
+            x = p;
+        }
+    }
+
+    bool unite(const std::string& a, const std::string& b) {
+        std::string ra = find(a);
+        std::string rb = find(b);
+        if (ra == rb) return false;
+        parent_[ra] = rb;
+        return true;
+    }
+
+    void rebuild(const Graph& state) {
+        auto comps = weaklyConnectedComponents(state);
+        parent_.clear();
+        for (const auto& comp : comps) {
+            for (const auto& member : comp) {
+                parent_[member] = comp.front();
+            }
+        }
+        count_ = comps.size();
+        dirty_ = false;
+    }
+};
+
+std::size_t degreeOf(const std::unordered_map<std::string, std::vector<std::string>>& adj,
+                     const Graph& state,
+                     const std::string& nodeId)
+{
+    if (!state.getNodes().count(nodeId)) return 0;
+    auto it = adj.find(nodeId);
+    return it == adj.end() ? 0 : it->second.size();
+}
+
+}  // anonymous
+
+void sweepTimestamps(const Graph& g,
+    const std::vector<std::int64_t>& timestamps,
+    const SweepVisitor& visit)
+{
+    requireSorted(timestamps);
+    Graph state = initialState(g, timestamps);
+    replayAcross(g, timestamps, state,
+        [](const Event&) {},
+        [&](size_t i) {
+            visit(timestamps[i], state);
+            return true;
+        });
+}
+
+std::vector<bool> isReachableAtTimes(const Graph& g,
+    const std::string& start,
+    const std::string& target,
+    const std::vector<std::int64_t>& timestamps)
+{
+    requireSorted(timestamps);
+    Graph state = initialState(g, timestamps);
+    ReachabilityTracker tracker;
+    std::vector<bool> result;
+    result.reserve(timestamps.size());
+
+    replayAcross(g, timestamps, state,
+        [&](const Event& e) { tracker.observe(e, state); },
+        [&](size_t) {
+            result.push_back(tracker.evaluate(state, start, target));
+            return true;
+        });
+    return result;
+}
+
+std::optional<std::int64_t> firstReachableTime(const Graph& g,
+    const std::string& start,
+    const std::string& target,
+    const std::vector<std::int64_t>& timestamps)
+{
+    requireSorted(timestamps);
+    Graph state = initialState(g, timestamps);
+    ReachabilityTracker tracker;
+    std::optional<std::int64_t> first;
+
+    replayAcross(g, timestamps, state,
+        [&](const Event& e) { tracker.observe(e, state); },
+        [&](size_t i) {
+            if (tracker.evaluate(state, start, target)) {
+                first = timestamps[i];
+                return false;
+            }
+            return true;
+        });
+    return first;
+}
+
+std::vector<std::size_t> componentCountAtTimes(const Graph& g,
+    const std::vector<std::int64_t>& timestamps)
+{
+    requireSorted(timestamps);
+    Graph state = initialState(g, timestamps);
+    ComponentTracker tracker(state);
+    std::vector<std::size_t> result;
+    result.reserve(timestamps.size());
+
+    replayAcross(g, timestamps, state,
+        [&](const Event& e) { tracker.observe(e, state); },
+        [&](size_t) {
+            result.push_back(tracker.count(state));
+            return true;
+        });
+    return result;
+}
+
+std::vector<std::size_t> outDegreeAtTimes(const Graph& g,
+    const std::string& nodeId,
+    const std::vector<std::int64_t>& timestamps)
+{
+    requireSorted(timestamps);
+    Graph state = initialState(g, timestamps);
+    std::vector<std::size_t> result;
+    result.reserve(timestamps.size());
+
+    replayAcross(g, timestamps, state,
+        [](const Event&) {},
+        [&](size_t) {
+            result.push_back(degreeOf(state.getOutgoing(), state, nodeId));
+            return true;
+        });
+    return result;
+}
+
+std::vector<std::size_t> inDegreeAtTimes(const Graph& g,
+    const std::string& nodeId,
+    const std::vector<std::int64_t>& timestamps)
+{
+    requireSorted(timestamps);
+    Graph state = initialState(g, timestamps);
+    std::vector<std::size_t> result;
+    result.reserve(timestamps.size());
+
+    replayAcross(g, timestamps, state,
+        [](const Event&) {},
+        [&](size_t) {
+            result.push_back(degreeOf(state.getIncoming(), state, nodeId));
+            return true;
+        });
+    return result;
+}
+
+}  // namespace algorithms
+}  // namespace graph
+}  // namespace chronograph
@@ -0,0 +1,258 @@
+// src/Merge.cpp
+#include <chronograph/repo/Merge.h>
+#include <chronograph/graph/utils/Parallel.h>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <string_view>
+
+namespace chronograph {
+namespace {
+    bool isNodeEvent(EventType t) {
+        return t == EventType::ADD_NODE || t == EventType::DEL_NODE ||
+               t == EventType::UPDATE_NODE;
+    }
+    bool isAdd(EventType t) {
+        return t == EventType::ADD_NODE || t == EventType::ADD_EDGE;
+    }
+    bool isDelete(EventType t) {
+        return t == EventType::DEL_NODE || t == EventType::DEL_EDGE;
+    }
+
+    std::uint16_t partitionOf(std::string_view id, bool node, std::size_t parts) {
+        std::size_t h = std::hash<std::string_view>{}(id);
+        // node and edge IDs live in separate namespaces
+        if (!node) h ^= 0x9e3779b97f4a7c15ULL;
+        return static_cast<std::uint16_t>(h % parts);
+    }
+    std::uint16_t partitionOf(const Event& e, std::size_t parts) {
+        return partitionOf(e.entityId, isNodeEvent(e.type), parts);
+    }
+    // an edge event of theirs against a node event of ours
+    bool isEndpointConflict(const Conflict& c) {
+        return isNodeEvent(c.ours.type) && !isNodeEvent(c.theirs.type);
+    }
+} // anonymous
+
+void TouchedIndex::add(const Event& e) {
+    Entity& ent = (isNodeEvent(e.type) ? nodes_ : edges_)[e.entityId];
+    if (isAdd(e.type)) {
+        // a new incarnation: earlier changes no longer apply
+        ent.added = &e;
+        ent.deleted = nullptr;
+        ent.updated = nullptr;
+        ent.keys.clear();
+    } else if (isDelete(e.type)) {
+        ent.deleted = &e;
+        ent.added = nullptr;
+        ent.updated = nullptr;
+        ent.keys.clear();
+    } else {
+        ent.updated = &e;
+        for (const auto& [k, v] : e.payload) ent.keys[k] = &e;
+    }
+}
+
+const TouchedIndex::Entity* TouchedIndex::find(const Event& e) const {
+    const auto& map = isNodeEvent(e.type) ? nodes_ : edges_;
+    auto it = map.find(e.entityId);
+    return it == map.end() ? nullptr : &it->second;
+}
+
+bool TouchedIndex::sameAdd(const Event& theirs) const {
+    const Entity* ent = find(theirs);
+    return isAdd(theirs.type) && ent && ent->added &&
+           ent->added->payload == theirs.payload &&
+           ent->added->from == theirs.from && ent->added->to == theirs.to;
+}
+
+const Event* TouchedIndex::deletedNode(std::string_view id) const {
+    auto it = nodes_.find(id);
+    return it == nodes_.end() ? nullptr : it->second.deleted;
+}
+
+std::optional<Conflict> TouchedIndex::conflictWith(const Event& theirs,
+                                                   const NodeLookup& nodes) const {
+    if (auto conflict = entityConflict(theirs)) return conflict;
+    // an edge they add or change needs both endpoints, which we may have deleted
+    if (theirs.type == EventType::ADD_EDGE || theirs.type == EventType::UPDATE_EDGE) {
+        for (const std::string* end : { &theirs.from, &theirs.to }) {
+            if (end->empty()) continue;
+            const TouchedIndex& index = nodes ? nodes(*end) : *this;
+            if (const Event* del = index.deletedNode(*end)) {
+                return Conflict{Conflict::DEL_UPDATE, *del, theirs};
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<Conflict> TouchedIndex::entityConflict(const Event& theirs) const {
+    const Entity* ent = find(theirs);
+    if (!ent) return std::nullopt;
+
+    if (isAdd(theirs.type)) {
+        if (ent->added && !sameAdd(theirs)) {
+            return Conflict{Conflict::ADD_ADD, *ent->added, theirs};
+        }
+        return std::nullopt;
+    }
+    if (isDelete(theirs.type)) {
+        // we changed what they delete
+        if (const Event* ours = ent->updated ? ent->updated : ent->added) {
+            return Conflict{Conflict::DEL_UPDATE, *ours, theirs};
+        }
+        return std::nullopt;
+    }
+    // theirs is an update
+    if (ent->deleted) {
+        return Conflict{Conflict::DEL_UPDATE, *ent->deleted, theirs};
+    }
+    for (const auto& [k, v] : theirs.payload) {
+        auto kit = ent->keys.find(k);
+        if (kit != ent->keys.end()) {
+            if (kit->second->payload.at(k) != v) {
+                return Conflict{Conflict::UPDATE_UPDATE, *kit->second, theirs};
+            }
+        } else if (ent->added) {
+            auto pit = ent->added->payload.find(k);
+            if (pit != ent->added->payload.end() && pit->second != v) {
+                return Conflict{Conflict::UPDATE_UPDATE, *ent->added, theirs};
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+Event TouchedIndex::withoutOurKeys(const Event& theirs) const {
+    Event out = theirs;
+    const Entity* ent = find(theirs);
+    if (!ent) return out;
+    for (auto it = out.payload.begin(); it != out.payload.end(); ) {
+        bool ours = ent->keys.count(it->first) ||
+                    (ent->added && ent->added->payload.count(it->first));
+        it = ours ? out.payload.erase(it) : std::next(it);
+    }
+    return out;
+}
+
+std::vector<Event> resolveConflict(const Conflict& conflict,
+                                   MergePolicy policy,
+                                   const TouchedIndex& ours) {
+    // an edge cannot hang off a node we deleted, whatever the policy
+    if (conflict.kind == Conflict::DEL_UPDATE && isEndpointConflict(conflict)) return {};
+    if (policy == MergePolicy::THEIRS) {
+        const Event& t = conflict.theirs;
+        if (conflict.kind != Conflict::ADD_ADD || t.type != EventType::ADD_EDGE) return { t };
+        // our edge is in the adjacency lists: update it in place, or unlink
+        // it from our endpoints before their edge is linked to theirs
+        const Event& o = conflict.ours;
+        if (t.from == o.from && t.to == o.to) {
+            Event update = t;
+            update.type = EventType::UPDATE_EDGE;
+            return { update };
+        }
+        Event del{ t.id + ":del", t.timestamp, EventType::DEL_EDGE, t.entityId, {}, o.from, o.to };
+        return { del, t };
+    }
+
+    switch (conflict.kind) {
+      case Conflict::UPDATE_UPDATE: {
+        Event rest = ours.withoutOurKeys(conflict.theirs);
+        if (rest.payload.empty()) return {};
+        return { rest };
+      }
+      case Conflict::ADD_ADD: {
+        if (policy != MergePolicy::ATTRIBUTE_UNION) return {};
+        const Event& t = conflict.theirs;
+        if (t.type == EventType::ADD_EDGE &&
+            (t.from != conflict.ours.from || t.to != conflict.ours.to)) {
+            return {};
+        }
+        // the entity exists on our side: contribute the missing keys as an update
+        Event rest = ours.withoutOurKeys(t);
+        if (rest.payload.empty()) return {};
+        rest.type = t.type == EventType::ADD_NODE ? EventType::UPDATE_NODE
+                                                  : EventType::UPDATE_EDGE;
+        return { rest };
+      }
+      case Conflict::DEL_UPDATE:
+        return {};
+    }
+    return {};
+}
+
+std::vector<Conflict> mergeDeltas(const std::vector<const Event*>& ours,
+                                  const std::vector<const Event*>& theirs,
+                                  MergePolicy policy, std::size_t threads,
+                                  const std::function<void(const Event&)>& apply) {
+    const std::size_t parts = std::clamp<std::size_t>(threads, 1, 256);
+
+    // 1) Partition both deltas by entity (hashing split evenly over workers)
+    std::vector<std::uint16_t> oursPart(ours.size()), theirsPart(theirs.size());
+    onWorkers(parts, [&](std::size_t w) {
+        auto assign = [&](const std::vector<const Event*>& events,
+                          std::vector<std::uint16_t>& out) {
+            const std::size_t lo = events.size() * w / parts;
+            const std::size_t hi = events.size() * (w + 1) / parts;
+            for (std::size_t i = lo; i < hi; ++i) out[i] = partitionOf(*events[i], parts);
+        };
+        assign(ours, oursPart);
+        assign(theirs, theirsPart);
+    });
+    // so that every worker visits only its own events
+    const PartitionBuckets oursBuckets(oursPart, parts), theirsBuckets(theirsPart, parts);
+
+    // 2) Classify and resolve each partition; every worker writes only the
+    //    slots of its own events
+    enum : std::uint8_t { APPLY, SKIP, SPECIAL };
+    struct Special {
+        std::vector<Event> resolved;
+        std::optional<Conflict> conflict;
+    };
+    std::vector<std::uint8_t> action(theirs.size(), APPLY);
+    std::vector<std::vector<Special>> specials(parts);  // in `theirs` order
+    std::vector<TouchedIndex> indexes(parts);
+    onWorkers(parts, [&](std::size_t p) {
+        for (std::size_t k = oursBuckets.start[p]; k < oursBuckets.start[p + 1]; ++k) {
+            indexes[p].add(*ours[oursBuckets.order[k]]);
+        }
+    });
+    // edge endpoints are looked up in the partition of the node
+    auto nodeIndex = [&](std::string_view id) -> const TouchedIndex& {
+        return indexes[partitionOf(id, true, parts)];
+    };
+    onWorkers(parts, [&](std::size_t p) {
+        const TouchedIndex& index = indexes[p];
+        for (std::size_t k = theirsBuckets.start[p]; k < theirsBuckets.start[p + 1]; ++k) {
+            const std::size_t i = theirsBuckets.order[k];
+            const Event& e = *theirs[i];
+            std::optional<Conflict> conflict = index.conflictWith(e, nodeIndex);
+            if (!conflict) {
+                // an identical add on both sides is already in place
+                if (index.sameAdd(e)) action[i] = SKIP;
+                continue;
+            }
+            action[i] = SPECIAL;
+            auto resolved = resolveConflict(*conflict, policy, index);
+            specials[p].push_back({std::move(resolved), std::move(conflict)});
+        }
+    });
+
+    // 3) Stitch the outcome back together in `theirs` order
+    std::vector<Conflict> conflicts;
+    std::vector<std::size_t> next(parts, 0);
+    for (std::size_t i = 0; i < theirs.size(); ++i) {
+        if (action[i] == APPLY) {
+            apply(*theirs[i]);
+        } else if (action[i] == SPECIAL) {
+            Special& sp = specials[theirsPart[i]][next[theirsPart[i]]++];
+            for (const auto& e : sp.resolved) apply(e);
+            conflicts.push_back(std::move(*sp.conflict));
+        }
+    }
+    return conflicts;
+}
+
+}  // namespace chronograph
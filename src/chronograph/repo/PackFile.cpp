@@ -0,0 +1,341 @@
+// src/PackFile.cpp
+#include <chronograph/repo/PackFile.h>
+#include <chronograph/graph/Compression.h>
+#include <chronograph/graph/EventCodec.h>
+#include <chronograph/graph/FileSync.h>
+#include <chronograph/graph/Hash.h>
+#include <chronograph/repo/StateCache.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace chronograph {
+
+namespace {
+    constexpr char kIndexMagic[8] = {'C','G','I','D','X','0','0','1'};
+    constexpr char kPackMagic[8]  = {'C','G','P','A','C','K','0','2'};
+
+    std::string join(const std::string& dir, const std::string& name) {
+        return (std::filesystem::path(dir) / name).string();
+    }
+
+    std::runtime_error ioError(const std::string& what, const std::string& path) {
+        return std::runtime_error("PackFile: " + what + " '" + path + "': " + std::strerror(errno));
+    }
+
+    struct Refs {
+        std::uint64_t generation = 0;
+        std::string head;
+        std::unordered_map<std::string, std::string> branches;
+    };
+
+    Refs parseRefs(const std::string& text) {
+        Refs refs;
+        std::istringstream in(text);
+        std::string line;
+        while (std::getline(in, line)) {
+            if (line.empty()) continue;
+            auto space = line.find(' ');
+            if (space == std::string::npos) {
+                throw std::runtime_error("PackFile: malformed refs line '" + line + "'");
+            }
+            if (line.compare(0, space, "HEAD") == 0) {
+                refs.head = line.substr(space + 1);
+            } else if (line.compare(0, space, "PACK") == 0) {
+                refs.generation = std::strtoull(line.c_str() + space + 1, nullptr, 10);
+            } else {
+                refs.branches[line.substr(space + 1)] = line.substr(0, space);
+            }
+        }
+        return refs;
+    }
+
+    std::string indexName(std::uint64_t generation) { return "index." + std::to_string(generation); }
+    std::string packName(std::uint64_t generation) { return "pack." + std::to_string(generation); }
+
+    std::string readFile(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) throw std::runtime_error("PackFile: cannot open '" + path + "'");
+        return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    }
+} // anonymous
+
+// ---- Writing ----
+
+void PackFile::write(const std::string& dir,
+                     const std::vector<std::pair<const Commit*, EventChunk>>& commits,
+                     const std::unordered_map<std::string, std::string>& branches,
+                     const std::string& head,
+                     const std::string& baseCommitId,
+                     const Graph* baseState) {
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+    if (ec) throw std::runtime_error("PackFile: cannot create '" + dir + "'");
+
+    std::string pack(kPackMagic, sizeof(kPackMagic));
+    std::string index(kIndexMagic, sizeof(kIndexMagic));
+    putU64(index, commits.size());
+    for (const auto& [c, events] : commits) {
+        const std::string block = compressEvents(events);
+        const std::uint64_t offset = pack.size();
+        putU32(pack, crc32(block.data(), block.size()));
+        pack += block;
+
+        putString(index, c->id);
+        putU32(index, static_cast<std::uint32_t>(c->parents.size()));
+        for (const auto& p : c->parents) putString(index, p);
+        putString(index, c->message);
+        putU64(index, c->eventCount);
+        putU64(index, static_cast<std::uint64_t>(c->firstTimestamp));
+        putU64(index, static_cast<std::uint64_t>(c->lastTimestamp));
+        putU64(index, offset);
+        putU64(index, pack.size() - offset);
+    }
+    putString(index, baseCommitId);
+    if (!baseCommitId.empty()) baseState->encodeBase(index);
+    putU32(index, crc32(index.data() + sizeof(kIndexMagic), index.size() - sizeof(kIndexMagic)));
+
+    // the new generation's files never overwrite the ones refs names now
+    const std::string refsPath = join(dir, "refs");
+    std::uint64_t generation = 1;
+    if (std::filesystem::exists(refsPath)) {
+        try {
+            generation = parseRefs(readFile(refsPath)).generation + 1;
+        } catch (const std::runtime_error&) {
+            // unreadable refs: nothing to preserve
+        }
+    }
+
+    // sorted for stable output; PACK and HEAD first
+    std::vector<std::pair<std::string, std::string>> refs(branches.begin(), branches.end());
+    std::sort(refs.begin(), refs.end());
+    std::string refsText = "PACK " + std::to_string(generation) + "\nHEAD " + head + "\n";
+    for (const auto& [name, cid] : refs) refsText += cid + " " + name + "\n";
+
+    // each file is synced before its rename, and the directory before refs
+    // switches to the new generation, so a crash at any point leaves refs
+    // naming a complete pack (the old one until the last rename)
+    replaceFile(join(dir, packName(generation)), {pack});
+    replaceFile(join(dir, indexName(generation)), {index});
+    syncDirectory(dir);
+    replaceFile(refsPath, {refsText});
+    syncDirectory(dir);
+
+    // files of older generations and of interrupted writes
+    const std::string keepIndex = indexName(generation), keepPack = packName(generation);
+    for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+        const std::string name = entry.path().filename().string();
+        if ((name.rfind("index.", 0) == 0 || name.rfind("pack.", 0) == 0) &&
+            name != keepIndex && name != keepPack) {
+            std::filesystem::remove(entry.path(), ec);
+        }
+    }
+}
+
+// ---- Reading ----
+
+PackFile::PackFile(const std::string& dir) {
+    // refs
+    Refs refs = parseRefs(readFile(join(dir, "refs")));
+    head_ = std::move(refs.head);
+    branches_ = std::move(refs.branches);
+    if (head_.empty() || !branches_.count(head_)) {
+        throw std::runtime_error("PackFile: '" + dir + "' has no valid HEAD");
+    }
+    if (refs.generation == 0) {
+        throw std::runtime_error("PackFile: '" + dir + "' names no pack generation");
+    }
+    packPath_ = join(dir, packName(refs.generation));
+
+    // index
+    const std::string index = readFile(join(dir, indexName(refs.generation)));
+    if (index.size() < sizeof(kIndexMagic) + 12 ||
+        index.compare(0, sizeof(kIndexMagic), kIndexMagic, sizeof(kIndexMagic)) != 0) {
+        throw std::runtime_error("PackFile: '" + dir + "' has no valid index");
+    }
+    const char* pos = index.data() + sizeof(kIndexMagic);
+    const char* end = index.data() + index.size() - 4;
+    const char* crcAt = end;
+    if (getU32(crcAt, crcAt + 4) != crc32(pos, static_cast<std::size_t>(end - pos))) {
+        throw std::runtime_error("PackFile: index checksum mismatch in '" + dir + "'");
+    }
+    std::uint64_t count = getU64(pos, end);
+    commits_.reserve(static_cast<std::size_t>(std::min<std::uint64_t>(count, index.size())));
+    for (std::uint64_t i = 0; i < count; ++i) {
+        Commit c;
+        c.id = getString(pos, end);
+        c.parents.resize(getU32(pos, end));
+        for (auto& p : c.parents) p = getString(pos, end);
+        c.message = getString(pos, end);
+        c.eventCount = static_cast<std::size_t>(getU64(pos, end));
+        c.firstTimestamp = static_cast<std::int64_t>(getU64(pos, end));
+        c.lastTimestamp = static_cast<std::int64_t>(getU64(pos, end));
+        Block b;
+        b.offset = getU64(pos, end);
+        b.bytes = getU64(pos, end);
+        blocks_.emplace(c.id, b);
+        commits_.push_back(std::move(c));
+    }
+    baseCommitId_ = getString(pos, end);
+    if (!baseCommitId_.empty()) {
+        if (!blocks_.count(baseCommitId_)) {
+            throw std::runtime_error("PackFile: base names unknown commit " + baseCommitId_);
+        }
+        baseState_ = std::make_shared<const Graph>(Graph::decodeBase(pos, end));
+    }
+    for (const auto& [name, cid] : branches_) {
+        if (!blocks_.count(cid)) {
+            throw std::runtime_error("PackFile: branch '" + name + "' names unknown commit " + cid);
+        }
+    }
+
+    // pack: blocks are read on demand
+    fd_ = ::open(packPath_.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd_ < 0) throw ioError("cannot open", packPath_);
+    char magic[sizeof(kPackMagic)];
+    if (::pread(fd_, magic, sizeof(magic), 0) != static_cast<ssize_t>(sizeof(magic)) ||
+        std::memcmp(magic, kPackMagic, sizeof(magic)) != 0) {
+        ::close(fd_);
+        throw std::runtime_error("PackFile: '" + packPath_ + "' is not a pack");
+    }
+}
+
+PackFile::~PackFile() {
+    if (fd_ >= 0) ::close(fd_);
+}
+
+const PackFile::Block& PackFile::blockFor(const std::string& commitId) const {
+    auto it = blocks_.find(commitId);
+    if (it == blocks_.end()) {
+        throw std::runtime_error("PackFile: unknown commit " + commitId);
+    }
+    if (it->second.bytes < 6) throw std::runtime_error("PackFile: corrupt block for " + commitId);
+    return it->second;
+}
+
+EventChunk PackFile::events(const std::string& commitId) const {
+    return events(std::vector<std::string>{ commitId }).front();
+}
+
+std::vector<EventChunk> PackFile::events(const std::vector<std::string>& commitIds) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<EventChunk> out(commitIds.size());
+    std::vector<const std::string*> missing;
+    for (std::size_t i = 0; i < commitIds.size(); ++i) {
+        if (auto it = cached_.find(commitIds[i]); it != cached_.end()) {
+            lru_.splice(lru_.begin(), lru_, it->second);
+            out[i] = it->second->events;
+        } else {
+            missing.push_back(&commitIds[i]);
+        }
+    }
+    if (missing.empty()) return out;
+
+    std::unordered_map<std::string, EventChunk> read;
+    readBlocks(missing, read);
+    for (std::size_t i = 0; i < commitIds.size(); ++i) {
+        if (auto it = read.find(commitIds[i]); it != read.end()) out[i] = it->second;
+    }
+    return out;
+}
+
+void PackFile::readBlocks(const std::vector<const std::string*>& ids,
+                          std::unordered_map<std::string, EventChunk>& out) const {
+    // pack order: a chain written parents-first becomes one forward scan
+    std::vector<std::pair<const Block*, const std::string*>> order;
+    order.reserve(ids.size());
+    for (const auto* id : ids) order.emplace_back(&blockFor(*id), id);
+    std::sort(order.begin(), order.end(),
+              [](const auto& a, const auto& b) { return a.first->offset < b.first->offset; });
+
+    std::string buffer;
+    for (std::size_t i = 0; i < order.size(); ) {
+        // coalesce adjacent blocks into one read
+        const std::uint64_t start = order[i].first->offset;
+        std::uint64_t stop = start + order[i].first->bytes;
+        std::size_t j = i + 1;
+        while (j < order.size() && order[j].first->offset <= stop &&
+               order[j].first->offset + order[j].first->bytes - start <= kMaxReadBytes) {
+            stop = std::max(stop, order[j].first->offset + order[j].first->bytes);
+            ++j;
+        }
+
+        buffer.resize(static_cast<std::size_t>(stop - start));
+        for (std::size_t done = 0; done < buffer.size(); ) {
+            ssize_t n = ::pread(fd_, &buffer[done], buffer.size() - done,
+                                static_cast<off_t>(start + done));
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) throw std::runtime_error("PackFile: cannot read '" + packPath_ + "'");
+            done += static_cast<std::size_t>(n);
+            ++reads_;
+        }
+
+        for (; i < j; ++i) {
+            const auto& [block, id] = order[i];
+            if (out.count(*id)) continue;
+            const char* pos = buffer.data() + (block->offset - start);
+            const char* end = pos + block->bytes;
+            if (getU32(pos, end) != crc32(pos, static_cast<std::size_t>(end - pos))) {
+                throw std::runtime_error("PackFile: checksum mismatch in block for " + *id);
+            }
+            EventChunk chunk(decompressEvents(pos, static_cast<std::size_t>(end - pos)));
+            cacheLocked(*id, chunk);
+            out.emplace(*id, std::move(chunk));
+        }
+    }
+}
+
+void PackFile::cacheLocked(const std::string& commitId, const EventChunk& events) const {
+    const std::size_t size = StateCache::estimateBytes(events);
+    if (size > maxBytes_) return;
+    evictToFit(maxBytes_ - size);
+    lru_.push_front(Entry{ commitId, events, size });
+    cached_.emplace(commitId, lru_.begin());
+    bytes_ += size;
+}
+
+void PackFile::evictToFit(std::size_t budget) const {
+    while (bytes_ > budget && !lru_.empty()) {
+        bytes_ -= lru_.back().bytes;
+        cached_.erase(lru_.back().commitId);
+        lru_.pop_back();
+    }
+}
+
+void PackFile::setCacheLimit(std::size_t maxBytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    maxBytes_ = maxBytes;
+    evictToFit(maxBytes_);
+}
+
+std::size_t PackFile::cacheLimit() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return maxBytes_;
+}
+
+std::size_t PackFile::cacheBytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bytes_;
+}
+
+std::size_t PackFile::cachedCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lru_.size();
+}
+
+std::size_t PackFile::readCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return reads_;
+}
+
+}  // namespace chronograph
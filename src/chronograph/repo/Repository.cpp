@@ -1,30 +1,77 @@
 #include <chronograph/repo/Repository.h>
+#include <chronograph/repo/PackFile.h>
 #include <chronograph/graph/Snapshot.h>
+#include <chronograph/graph/Compression.h>
+#include <chronograph/graph/EventCodec.h>
+#include <chronograph/graph/Hash.h>
 #include <algorithm>
-#include <random>
-#include <sstream>
+#include <memory>
+#include <queue>
 #include <unordered_set>
 #include <stdexcept>
+#include <thread>
 
 namespace chronograph {
 namespace {
-/// Quick helper for random commit IDs;
-// TODO: replace with better UUID generator
-std::string generateCommitId() {
-    static std::mt19937_64 rng(std::random_device{}());
-    static std::uniform_int_distribution<uint64_t> dist;
-    std::ostringstream ss;
-    ss << std::hex << dist(rng);
-    return ss.str();
+/// Content address of a commit: hash of its parents, message and events
+// * parent IDs are content addresses themselves, so equal IDs mean equal
+//   histories (a Merkle DAG)
+// * the encoding buffer is reused per thread; only the ID string allocates
+std::string commitIdFor(const std::vector<std::string>& parents,
+                        const std::string& message,
+                        const EventChunk& events) {
+    thread_local std::string buf;
+    buf.clear();
+    putU32(buf, static_cast<std::uint32_t>(parents.size()));
+    for (const auto& p : parents) putString(buf, p);
+    putString(buf, message);
+    putU64(buf, events.size());
+    for (const auto& e : events) encodeEvent(e, buf);
+    return hash128(buf).toHex();
+}
+
+// payloads of the repository's WAL records
+// * COMMIT: ID, parents, message, event count; the events are the EVENT
+//   records before it. A commit folded into the compaction base has no
+//   EVENT records and ends in a 1 byte and its first/last timestamps
+// * BASE: base commit ID, Graph::encodeBase() of the base state
+std::string commitPayload(const Commit& c, bool folded) {
+    std::string payload;
+    putString(payload, c.id);
+    putU32(payload, static_cast<std::uint32_t>(c.parents.size()));
+    for (const auto& p : c.parents) putString(payload, p);
+    putString(payload, c.message);
+    putU64(payload, c.eventCount);
+    if (folded) {
+        payload.push_back(1);
+        putU64(payload, static_cast<std::uint64_t>(c.firstTimestamp));
+        putU64(payload, static_cast<std::uint64_t>(c.lastTimestamp));
+    }
+    return payload;
+}
+
+std::string branchPayload(const std::string& name, const std::string& cid) {
+    std::string payload;
+    putString(payload, name);
+    putString(payload, cid);
+    return payload;
+}
+
+std::string eventPayload(const Event& e) {
+    std::string payload;
+    encodeEvent(e, payload);
+    return payload;
 }
 }  // anon
 
 Repository Repository::init(const std::string& rootBranch) {
     Repository repo;
     // Create an initial “root” commit
-    const std::string rootId = generateCommitId();
+    const std::string rootId = commitIdFor({}, "", {});
     Commit root{ rootId, {}, {} };
-    repo.commits_.emplace(rootId, root);
+    repo.addCommit(std::move(root));
+    // before-images let checkout revert commits instead of rebuilding
+    repo.workingGraph_.enableUndoJournal();
 
     // Set up branches and HEAD
     repo.branches_[rootBranch]     = rootId;
@@ -36,16 +83,337 @@ Repository Repository::init(const std::string& rootBranch) {
     return repo;
 }
 
+Repository Repository::open(const std::string& walPath,
+                            WalOptions options,
+                            const std::string& rootBranch) {
+    using RecordType = WriteAheadLog::RecordType;
+    WriteAheadLog::ReadResult log = WriteAheadLog::read(walPath);
+
+    // New repository: log the root commit and the initial HEAD
+    if (log.records.empty()) {
+        Repository repo = init(rootBranch);
+        repo.wal_ = std::make_shared<WriteAheadLog>(walPath, options, log.validBytes);
+        repo.logCommit(repo.commits_.at(repo.HEAD_commitId_));
+        repo.logBranch(rootBranch, repo.HEAD_commitId_);
+        repo.logHead(rootBranch);
+        repo.wal_->sync();
+        repo.workingGraph_.attachWal(repo.wal_);
+        return repo;
+    }
+
+    // Recovery: one sequential pass over the records
+    Repository repo;
+    std::vector<Event> staged;  // events since the last commit or checkout
+    std::string baseId;
+    std::shared_ptr<const Graph> baseState;
+    for (const auto& rec : log.records) {
+        const char* pos = rec.payload.data();
+        const char* end = pos + rec.payload.size();
+        switch (rec.type) {
+          case RecordType::EVENT:
+            staged.push_back(decodeEvent(pos, end));
+            break;
+          case RecordType::COMMIT: {
+            Commit c;
+            c.id = getString(pos, end);
+            c.parents.resize(getU32(pos, end));
+            for (auto& p : c.parents) p = getString(pos, end);
+            c.message = getString(pos, end);
+            std::uint64_t count = getU64(pos, end);
+            if (pos != end && *pos++ == 1) {
+                // folded into the base: only the metadata was kept
+                c.eventCount = static_cast<std::size_t>(count);
+                c.firstTimestamp = static_cast<std::int64_t>(getU64(pos, end));
+                c.lastTimestamp = static_cast<std::int64_t>(getU64(pos, end));
+            } else {
+                if (count > staged.size()) {
+                    throw std::runtime_error("Repository::open: commit record without its events");
+                }
+                // the commit's delta is the newest `count` staged events
+                c.events = EventChunk(std::vector<Event>(staged.end() - count, staged.end()));
+            }
+            staged.clear();
+            std::string id = c.id;
+            repo.addCommit(std::move(c));
+            if (!repo.HEAD_.empty()) repo.branches_[repo.HEAD_] = id;
+            repo.HEAD_commitId_ = id;
+          } break;
+          case RecordType::BRANCH: {
+            std::string name = getString(pos, end);
+            std::string cid = getString(pos, end);
+            if (cid.empty()) repo.branches_.erase(name);   // deleted
+            else repo.branches_[name] = std::move(cid);
+          } break;
+          case RecordType::HEAD:
+            repo.HEAD_ = getString(pos, end);
+            repo.HEAD_commitId_ = repo.branches_.at(repo.HEAD_);
+            staged.clear();
+            break;
+          case RecordType::BASE:
+            baseId = getString(pos, end);
+            if (!repo.commits_.count(baseId)) {
+                throw std::runtime_error("Repository::open: base names unknown commit " + baseId);
+            }
+            baseState = std::make_shared<const Graph>(Graph::decodeBase(pos, end));
+            break;
+        }
+    }
+    if (repo.HEAD_.empty()) {
+        throw std::runtime_error("Repository::open: '" + walPath + "' has no HEAD record");
+    }
+    if (!baseId.empty()) repo.restoreBase(baseId, std::move(baseState));
+
+    // Rebuild the working graph at HEAD and restage uncommitted events
+    repo.workingGraph_.enableUndoJournal();
+    repo.rebuildWorkingGraph(repo.HEAD_commitId_);
+    repo.lastCommittedEventIndex_ = repo.workingGraph_.getEventLog().size();
+    for (const auto& e : staged) {
+        repo.workingGraph_.addEvent(e);
+        repo.workingGraph_.applyEvent(e);
+    }
+
+    repo.wal_ = std::make_shared<WriteAheadLog>(walPath, options, log.validBytes);
+    repo.workingGraph_.attachWal(repo.wal_);
+    return repo;
+}
+
+void Repository::writePack(const std::string& dir) const {
+    // index order puts every commit after its parents
+    std::vector<const Commit*> ordered(commits_.size());
+    for (const auto& [cid, cm] : commits_) ordered[commitIndex_.at(cid)] = &cm;
+    std::vector<std::pair<const Commit*, EventChunk>> commits;
+    commits.reserve(ordered.size());
+    for (const Commit* c : ordered) commits.emplace_back(c, eventsOf(*c));
+    PackFile::write(dir, commits, branches_, HEAD_, baseCommitId_, baseState_.get());
+}
+
+Repository Repository::openPack(const std::string& dir) {
+    Repository repo;
+    auto pack = std::make_shared<PackFile>(dir);
+    for (const auto& c : pack->commits()) {
+        for (const auto& pid : c.parents) {
+            if (!repo.commits_.count(pid)) {
+                throw std::runtime_error("Repository::openPack: commit " + c.id +
+                                         " precedes its parent " + pid);
+            }
+        }
+        repo.addCommit(c);
+    }
+    repo.branches_ = pack->branches();
+    repo.HEAD_ = pack->head();
+    repo.HEAD_commitId_ = repo.branches_.at(repo.HEAD_);
+    if (!pack->baseCommitId().empty()) repo.restoreBase(pack->baseCommitId(), pack->baseState());
+    repo.pack_ = std::move(pack);
+
+    repo.workingGraph_.enableUndoJournal();
+    repo.lastCommittedEventIndex_ = 0;
+    repo.workingGraphPending_ = true;
+    return repo;
+}
+
+const Graph& Repository::graph() const {
+    loadWorkingGraph();
+    return workingGraph_;
+}
+
+void Repository::loadWorkingGraph() const {
+    if (!workingGraphPending_) return;
+    workingGraphPending_ = false;
+    rebuildWorkingGraph(HEAD_commitId_);
+    lastCommittedEventIndex_ = workingGraph_.getEventLog().size();
+}
+
+void Repository::setEventCacheLimit(std::size_t maxBytes) {
+    if (pack_) pack_->setCacheLimit(maxBytes);
+}
+
+std::size_t Repository::compressColdCommits() {
+    std::unique_lock<std::shared_mutex> lock(locks_->history);
+    std::size_t saved = 0;
+    for (auto& [cid, c] : commits_) {
+        if (c.events.empty() || !c.events.ownsStorage()) continue;
+        std::string block = compressEvents(c.events);
+        const std::size_t before = StateCache::estimateBytes(c.events);
+        if (block.size() >= before) continue;
+        saved += before - block.size();
+        coldEvents_[cid] = std::move(block);
+        c.events = EventChunk();
+    }
+    return saved;
+}
+
+std::string Repository::compact(std::int64_t horizonTs) {
+    loadWorkingGraph();
+    std::unique_lock<std::shared_mutex> lock(locks_->history);
+
+    // 1) candidates: HEAD's first-parent chain, oldest first, as far as its
+    //    events stay before the horizon
+    std::vector<std::string> chain;
+    for (std::string cid = HEAD_commitId_; ; ) {
+        chain.push_back(cid);
+        const Commit& cm = commits_.at(cid);
+        if (cm.parents.empty()) break;
+        cid = cm.parents[0];
+    }
+    std::reverse(chain.begin(), chain.end());
+    std::size_t usable = 0;
+    for (; usable < chain.size(); ++usable) {
+        const Commit& cm = commits_.at(chain[usable]);
+        if (cm.eventCount > 0 && cm.lastTimestamp >= horizonTs) break;
+    }
+
+    // 2) ... and on every branch tip's first-parent chain
+    std::unordered_map<std::string, std::size_t> onTips;
+    for (const auto& [name, tip] : branches_) {
+        for (std::string cid = tip; ; ) {
+            ++onTips[cid];
+            const Commit& cm = commits_.at(cid);
+            if (cm.parents.empty() || cid == baseCommitId_) break;
+            cid = cm.parents[0];
+        }
+    }
+    std::string base;
+    for (std::size_t i = usable; i-- > 0; ) {
+        if (onTips[chain[i]] == branches_.size()) {
+            base = chain[i];
+            break;
+        }
+    }
+    if (base.empty() || base == baseCommitId_ ||
+        (!baseCommitId_.empty() &&
+         commits_.at(base).generation < commits_.at(baseCommitId_).generation)) {
+        return baseCommitId_;
+    }
+
+    // 3) the base state, with the commits up to the base folded into it
+    auto state = std::make_shared<Graph>(*materialize(base));
+    state->compactEvents(state->getEventLog().size());
+    std::size_t folded = 0;
+    for (auto it = std::find(chain.begin(), chain.end(), base); ; --it) {
+        if (*it == baseCommitId_) break;
+        folded += commits_.at(*it).eventCount;
+        if (it == chain.begin()) break;
+    }
+    workingGraph_.compactEvents(folded);
+    lastCommittedEventIndex_ -= folded;
+
+    // 4) drop the events below the base; cached states still hold them
+    std::vector<std::string> ancestors;
+    std::unordered_set<std::string> seen;
+    buildAncestors(base, ancestors, seen);
+    for (const auto& cid : ancestors) {
+        commits_.at(cid).events = EventChunk();
+        coldEvents_.erase(cid);
+        compacted_.insert(cid);
+    }
+    {
+        std::lock_guard<std::mutex> cacheLock(locks_->cache);
+        stateCache_.clear();
+    }
+    baseCommitId_ = base;
+    baseState_ = std::move(state);
+    if (wal_) rewriteWal();
+    return base;
+}
+
+void Repository::restoreBase(const std::string& cid, std::shared_ptr<const Graph> state) {
+    std::vector<std::string> ancestors;
+    std::unordered_set<std::string> seen;
+    buildAncestors(cid, ancestors, seen);
+    compacted_.insert(ancestors.begin(), ancestors.end());
+    baseCommitId_ = cid;
+    baseState_ = std::move(state);
+}
+
+EventChunk Repository::eventsOf(const Commit& c) const {
+    if (c.eventCount == 0 || !c.events.empty() || compacted_.count(c.id)) return c.events;
+    if (auto it = coldEvents_.find(c.id); it != coldEvents_.end()) {
+        return EventChunk(decompressEvents(it->second.data(), it->second.size()));
+    }
+    return pack_->events(c.id);
+}
+
+std::vector<EventChunk> Repository::eventsOf(const std::vector<std::string>& cids) const {
+    std::vector<EventChunk> out(cids.size());
+    std::vector<std::string> packed;
+    std::vector<std::size_t> slots;
+    for (std::size_t i = 0; i < cids.size(); ++i) {
+        const Commit& c = commits_.at(cids[i]);
+        if (c.eventCount == 0 || !c.events.empty() || coldEvents_.count(c.id) ||
+            compacted_.count(c.id)) {
+            out[i] = eventsOf(c);
+        } else {
+            packed.push_back(c.id);
+            slots.push_back(i);
+        }
+    }
+    if (!packed.empty()) {
+        auto read = pack_->events(packed);
+        for (std::size_t k = 0; k < slots.size(); ++k) out[slots[k]] = std::move(read[k]);
+    }
+    return out;
+}
+
+void Repository::logCommit(const Commit& c) {
+    if (!wal_) return;
+    wal_->append(WriteAheadLog::RecordType::COMMIT, commitPayload(c, false));
+}
+
+void Repository::logBranch(const std::string& name, const std::string& cid) {
+    if (!wal_) return;
+    wal_->append(WriteAheadLog::RecordType::BRANCH, branchPayload(name, cid));
+}
+
+void Repository::logHead(const std::string& name) {
+    if (!wal_) return;
+    std::string payload;
+    putString(payload, name);
+    wal_->append(WriteAheadLog::RecordType::HEAD, payload);
+}
+
+void Repository::rewriteWal() {
+    // what open() replays: the commits (parents first) with the events of
+    // those above the base, the base, the refs and the uncommitted events
+    using RecordType = WriteAheadLog::RecordType;
+    std::vector<WriteAheadLog::Record> records;
+    std::vector<const Commit*> ordered(commits_.size());
+    for (const auto& [cid, cm] : commits_) ordered[commitIndex_.at(cid)] = &cm;
+    for (const Commit* c : ordered) {
+        const bool folded = compacted_.count(c->id) > 0;
+        if (!folded) {
+            for (const auto& e : eventsOf(*c)) records.push_back({RecordType::EVENT, eventPayload(e)});
+        }
+        records.push_back({RecordType::COMMIT, commitPayload(*c, folded)});
+    }
+    std::string base;
+    putString(base, baseCommitId_);
+    baseState_->encodeBase(base);
+    records.push_back({RecordType::BASE, std::move(base)});
+    for (const auto& [name, cid] : branches_) {
+        records.push_back({RecordType::BRANCH, branchPayload(name, cid)});
+    }
+    std::string head;
+    putString(head, HEAD_);
+    records.push_back({RecordType::HEAD, std::move(head)});
+    const auto& log = workingGraph_.getEventLog();
+    for (std::size_t i = lastCommittedEventIndex_; i < log.size(); ++i) {
+        records.push_back({RecordType::EVENT, eventPayload(log[i])});
+    }
+    wal_->rewrite(records);
+}
+
 // --- MUTATORS for workign Graph ---- 
 // * simply forward to graph functions
 void Repository::addNode(const std::string& id,
     const std::map<std::string, std::string>& attrs,
     std::int64_t timestamp)
 {
+loadWorkingGraph();
 workingGraph_.addNode(id, attrs, timestamp);
 }
 
 void Repository::delNode(const std::string& id, std::int64_t timestamp) {
+loadWorkingGraph();
 workingGraph_.delNode(id, timestamp);
 }
 
@@ -55,10 +423,12 @@ void Repository::addEdge(const std::string& id,
     const std::map<std::string, std::string>& attrs,
     std::int64_t timestamp)
 {
+loadWorkingGraph();
 workingGraph_.addEdge(id, from, to, attrs, timestamp);
 }
 
 void Repository::delEdge(const std::string& id, std::int64_t timestamp) {
+loadWorkingGraph();
 workingGraph_.delEdge(id, timestamp);
 }
 
@@ -66,6 +436,7 @@ void Repository::updateNode(const std::string& id,
        const std::map<std::string, std::string>& attrs,
        std::int64_t timestamp)
 {
+loadWorkingGraph();
 workingGraph_.updateNode(id, attrs, timestamp);
 }
 
@@ -73,35 +444,37 @@ void Repository::updateEdge(const std::string& id,
        const std::map<std::string, std::string>& attrs,
        std::int64_t timestamp)
 {
+loadWorkingGraph();
 workingGraph_.updateEdge(id, attrs, timestamp);
 }
 
 
 // --- Commit staged events ---
 std::string Repository::commit(const std::string& message) {
-    const auto& log = workingGraph_.getEventLog();
-    size_t total = log.size();
+    loadWorkingGraph();
+    size_t total = workingGraph_.getEventLog().size();
 
     // Nothing new to commit?
     if (total <= lastCommittedEventIndex_) {
         return HEAD_commitId_;
     }
 
-    // Slice out the new delta
-    std::vector<Event> delta(
-        log.begin() + lastCommittedEventIndex_,
-        log.end()
-    );
+    // Seal the new delta; the commit and the working log share its storage
+    EventChunk delta = workingGraph_.shareEvents(lastCommittedEventIndex_);
 
     // Make a commit (add to commits map)
-    std::string newId = generateCommitId();
+    std::string newId = commitIdFor({ HEAD_commitId_ }, message, delta);
     Commit c{ newId, { HEAD_commitId_ }, std::move(delta), message };
-    commits_.emplace(newId, c);
+    std::unique_lock<std::shared_mutex> lock(locks_->history);
+    addCommit(std::move(c));
+    logCommit(commits_.at(newId));
 
     // Advance branch & HEAD
     branches_[HEAD_] = newId;
     HEAD_commitId_ = newId;
     lastCommittedEventIndex_ = total;
+    trimUndoJournal(newId);
+    if (bitmapsEnabled_) dropUnreferencedBitmaps();
 
     return newId;
 }
@@ -109,7 +482,78 @@ std::string Repository::commit(const std::string& message) {
 // ——— Branching ———
 void Repository::branch(const std::string& branchName) {
     // point new branch at current HEAD commit
+    std::unique_lock<std::shared_mutex> lock(locks_->history);
     branches_[branchName] = HEAD_commitId_;
+    logBranch(branchName, HEAD_commitId_);
+    if (bitmapsEnabled_) bitmapFor(HEAD_commitId_);
+}
+
+void Repository::deleteBranch(const std::string& branchName) {
+    std::unique_lock<std::shared_mutex> lock(locks_->history);
+    if (!branches_.count(branchName)) {
+        throw std::runtime_error("Branch '" + branchName + "' does not exist");
+    }
+    if (branchName == HEAD_) {
+        throw std::runtime_error("Cannot delete the checked-out branch '" + branchName + "'");
+    }
+    branches_.erase(branchName);
+    logBranch(branchName, "");
+    if (bitmapsEnabled_) dropUnreferencedBitmaps();
+}
+
+GcResult Repository::gc() {
+    std::unique_lock<std::shared_mutex> lock(locks_->history);
+    GcResult result;
+
+    // 1) mark everything reachable from a branch tip
+    std::vector<std::string> order;
+    std::unordered_set<std::string> live;
+    for (const auto& [name, tip] : branches_) buildAncestors(tip, order, live);
+    if (live.size() == commits_.size()) return result;
+
+    // 2) sweep the rest; cached states go first, as their logs share the
+    //    commits' events
+    {
+        std::lock_guard<std::mutex> cacheLock(locks_->cache);
+        for (const auto& [cid, c] : commits_) {
+            if (live.count(cid)) continue;
+            if (std::size_t bytes = stateCache_.erase(cid)) {
+                result.bytes += bytes;
+                ++result.cachedStates;
+            }
+        }
+    }
+    for (auto it = commits_.begin(); it != commits_.end(); ) {
+        if (live.count(it->first)) {
+            ++it;
+            continue;
+        }
+        const Commit& c = it->second;
+        result.bytes += sizeof(Commit) + c.id.capacity() + c.message.capacity();
+        for (const auto& p : c.parents) result.bytes += sizeof(p) + p.capacity();
+        if (c.events.ownsStorage()) result.bytes += StateCache::estimateBytes(c.events);
+        if (auto cold = coldEvents_.find(c.id); cold != coldEvents_.end()) {
+            result.bytes += cold->second.capacity();
+            coldEvents_.erase(cold);
+        }
+        compacted_.erase(c.id);
+        commitIndex_.erase(c.id);
+        ++result.commits;
+        it = commits_.erase(it);
+    }
+
+    // 3) renumber the survivors densely, in their old order, and rebuild
+    //    the bitmaps that index by it
+    std::vector<std::pair<std::size_t, std::string>> byIndex;
+    byIndex.reserve(commitIndex_.size());
+    for (const auto& [cid, index] : commitIndex_) byIndex.push_back({ index, cid });
+    std::sort(byIndex.begin(), byIndex.end());
+    for (std::size_t i = 0; i < byIndex.size(); ++i) commitIndex_[byIndex[i].second] = i;
+    if (bitmapsEnabled_) {
+        tipBitmaps_.clear();
+        enableReachabilityBitmaps();
+    }
+    return result;
 }
 
 void Repository::checkout(const std::string& branchName) {
@@ -122,56 +566,19 @@ void Repository::checkout(const std::string& branchName) {
     // 1) Switch HEAD to the target branch
     HEAD_ = branchName;
     HEAD_commitId_ = newCommit;
+    logHead(branchName);
 
-    // 2) If nothing changed, no need to update graph
+    // 2) If nothing changed, no need to update graph; a working graph that
+    //    was never built is simply built at the new HEAD later
+    if (workingGraphPending_) return;
     if (newCommit == oldCommit) {
         // make sure lastCommittedEventIndex_ stays correct
         lastCommittedEventIndex_ = workingGraph_.getEventLog().size();
         return;
     }
 
-    // 3) Otherwise, rebuild or fast‐forward…
-    // Collect oldChain from old HEAD, newChain from newCommit
-    std::vector<std::string> oldChain, newChain;
-    std::unordered_set<std::string> seen;
-    buildAncestors(oldCommit, oldChain, seen);
-    seen.clear();
-    buildAncestors(newCommit, newChain, seen);
-
-    bool isDescendant = false;
-    if (oldChain.size() <= newChain.size()) {
-      isDescendant = std::equal(
-        oldChain.begin(), oldChain.end(),
-        newChain.begin()
-      );
-    }
-
-    // if old chain is a descendant of the new chain
-    // * we fast forward new commits to match the branch
-    // else if the old chain is a descendant of the new chain
-    // * rebuild the chain based on prior commits
-    if (isDescendant) { 
-        // fast‐forward only the missing commits
-        auto it2 = std::find(newChain.begin(), newChain.end(), oldCommit);
-        ++it2;
-        for (; it2 != newChain.end(); ++it2) {
-            const Commit& cm = commits_.at(*it2);
-            for (auto& e : cm.events) {
-                workingGraph_.addEvent(e);
-                workingGraph_.applyEvent(e);
-            }
-        }
-    } else {
-        // full rebuild
-        workingGraph_.clearGraph();
-        for (auto& cid : newChain) {
-            const Commit& cm = commits_.at(cid);
-            for (auto& e : cm.events) {
-                workingGraph_.addEvent(e);
-                workingGraph_.applyEvent(e);
-            }
-        }
-    }
+    // 3) Otherwise, fast‐forward or revert to the common ancestor and replay
+    moveWorkingGraph(oldCommit, newCommit);
 
     // update how many events we have in the log now
     lastCommittedEventIndex_ = workingGraph_.getEventLog().size();
@@ -197,14 +604,49 @@ std::vector<Commit> Repository::listCommits(const std::string& branchName) const
     std::unordered_set<std::string> seen;
     buildAncestors(it->second, chainIds, seen);
 
+    std::vector<EventChunk> events = eventsOf(chainIds);
     std::vector<Commit> chain;
     chain.reserve(chainIds.size());
-    for (auto& cid : chainIds) {
-        chain.push_back(commits_.at(cid));
+    for (std::size_t i = 0; i < chainIds.size(); ++i) {
+        chain.push_back(commits_.at(chainIds[i]));
+        chain.back().events = std::move(events[i]);
     }
     return chain;
 }
 
+CommitWalk Repository::walkCommits(const std::string& ref, std::size_t limit) const {
+    auto bit = branches_.find(ref);
+    const std::string& cid = bit != branches_.end() ? bit->second : ref;
+    auto cit = commits_.find(cid);
+    if (cit == commits_.end()) {
+        throw std::runtime_error("No branch or commit named '" + ref + "'");
+    }
+    return CommitWalk(*this, cit->second, limit);
+}
+
+CommitWalk::CommitWalk(const Repository& repo, const Commit& tip, std::size_t limit)
+    : repo_(&repo),
+      remaining_(limit == 0 ? static_cast<std::size_t>(-1) : limit) {
+    push(tip);
+}
+
+void CommitWalk::push(const Commit& c) {
+    if (seen_.insert(&c).second) {
+        frontier_.push({ { c.generation, repo_->commitIndex_.at(c.id) }, &c });
+    }
+}
+
+std::optional<CommitInfo> CommitWalk::next() {
+    if (remaining_ == 0 || frontier_.empty()) return std::nullopt;
+    const Commit* c = frontier_.top().second;
+    frontier_.pop();
+    --remaining_;
+    for (const auto& pid : c->parents) {
+        push(repo_->commits_.at(pid));
+    }
+    return CommitInfo(*c);
+}
+
 CommitGraph Repository::getCommitGraph() const {
     CommitGraph g;
 
@@ -242,6 +684,7 @@ MergeResult Repository::merge(const std::string& branchName,
     if (bit == branches_.end()) {
         throw std::runtime_error("Branch '" + branchName + "' does not exist");
     }
+    loadWorkingGraph();
     const std::string A = HEAD_commitId_;
     const std::string B = bit->second;
 
@@ -250,98 +693,516 @@ MergeResult Repository::merge(const std::string& branchName,
         return MergeResult{ A, {} };
     }
 
-    // 3) Build ancestor chains and sets
-    std::vector<std::string> ancA, ancB;
-    std::unordered_set<std::string> setA, setB;
-    buildAncestors(A, ancA, setA);
-    buildAncestors(B, ancB, setB);
+    // 3) Find the merge base
+    std::optional<std::string> base = mergeBase(A, B);
+    if (!base) {
+        throw std::runtime_error("No common ancestor found!");
+    }
 
-    // 4) IF A is ancestor of B: simply fast forward
-    if (setB.count(A)) {
-        // compute linear path B->A (exclusive of A), using first‐parent pointers
-        std::vector<std::string> pathB;
-        for (std::string cid = B; cid != A; cid = commits_[cid].parents[0]) {
-            pathB.push_back(cid);
-        }
-        std::reverse(pathB.begin(), pathB.end());
+    // IF B is already contained in A: nothing to merge
+    if (*base == B) {
+        return MergeResult{ A, {} };
+    }
 
-        // apply each commit’s events in order
-        for (auto& cid : pathB) {
-            for (auto& e : commits_.at(cid).events) {
-                workingGraph_.addEvent(e);
-                workingGraph_.applyEvent(e);
-            }
-        }
+    // 4) IF A is ancestor of B: simply fast forward
+    if (*base == A) {
+        moveWorkingGraph(A, B);
 
         // advance main branch pointer
+        std::unique_lock<std::shared_mutex> lock(locks_->history);
         branches_[HEAD_] = B;
         HEAD_commitId_ = B;
+        logBranch(HEAD_, B);
+        logHead(HEAD_);
         lastCommittedEventIndex_ = workingGraph_.getEventLog().size();
+        if (bitmapsEnabled_) dropUnreferencedBitmaps();
         return MergeResult{ B, {} };
     }
 
     // 5) IF True three‐way merge
-    // 5a) Find the common ancestor (CA), walk back from B until we hit something in ancA
-    std::string CA;
-    for (auto it = ancB.rbegin(); it != ancB.rend(); ++it) {
-        if (setA.count(*it)) {
-            CA = *it;
-            break;
-        }
-    }
-    if (CA.empty()) {
-        throw std::runtime_error("No common ancestor found!");
+    // 5a) B's delta is read off its first-parent chain, so the common ancestor
+    //     (CA) must lie on it. The merge base usually does; if it is only
+    //     reachable through a merge on B's side, use the nearest commit on
+    //     that chain that is an ancestor of A instead.
+    std::optional<std::vector<std::string>> pathB = firstParentPath(*base, B);
+    if (!pathB) {
+        pathB = firstParentPath(firstParentForkPoint(A, B), B);
     }
 
-    // 5b) Compute B’s delta since CA: linear path from CA→B
-    std::vector<std::string> pathB;
-    for (std::string cid = B; cid != CA; cid = commits_[cid].parents[0]) {
-        pathB.push_back(cid);
+    // 5b) Collect both sides' deltas: A's since its fork from B's history
+    std::vector<std::string> pathA =
+        *firstParentPath(firstParentForkPoint(B, A), A);
+    std::vector<const Event*> ours, theirs;
+    // both chains are read in one pass; the chunks keep the events alive
+    std::vector<std::string> paths = pathA;
+    paths.insert(paths.end(), pathB->begin(), pathB->end());
+    const std::vector<EventChunk> chunks = eventsOf(paths);
+    for (std::size_t i = 0; i < chunks.size(); ++i) {
+        auto& side = i < pathA.size() ? ours : theirs;
+        for (const auto& e : chunks[i]) side.push_back(&e);
     }
-    std::reverse(pathB.begin(), pathB.end());
 
-    // 5c) Apply B’s delta onto the current working‐tree (which is at A)
-    std::vector<Conflict> conflicts;    
-    std::vector<Event>   mergedEvents;
-    for (auto& cid : pathB) {
-        for (auto& e : commits_.at(cid).events) {
-            //TODO: detailed conflict population
-            bool conflict = false;
-            if (conflict && policy == MergePolicy::OURS) {
-            // skip applying
-            } else {
-            // either no conflict, or THEIRS/UNION
-                workingGraph_.addEvent(e);
-                workingGraph_.applyEvent(e);
-                mergedEvents.push_back(e);
-            }
-        }
+    // 5c) Apply B’s delta onto the current working‐tree (which is at A),
+    //     classified against A's changes partition by partition
+    const size_t mergeStart = workingGraph_.getEventLog().size();
+    std::size_t threads = 1;
+    if (ours.size() + theirs.size() >= kParallelMergeMinEvents) {
+        threads = mergeThreads_ ? mergeThreads_
+                                : std::max(1u, std::thread::hardware_concurrency());
     }
+    std::vector<Conflict> conflicts = mergeDeltas(
+        ours, theirs, policy, threads, [&](const Event& e) {
+            workingGraph_.addEvent(e);
+            workingGraph_.applyEvent(e);
+        });
+    if (policy != MergePolicy::INTERACTIVE) conflicts.clear();
 
     // 5d) Create the merge commit with two parents (A and B)
-    std::string mergeId = generateCommitId();
+    EventChunk mergedEvents = workingGraph_.shareEvents(mergeStart);
+    std::string mergeId = commitIdFor({ A, B }, "", mergedEvents);
     Commit m{ mergeId, { A, B }, std::move(mergedEvents) };
-    commits_.emplace(mergeId, std::move(m));
+    std::unique_lock<std::shared_mutex> lock(locks_->history);
+    addCommit(std::move(m));
+    logCommit(commits_.at(mergeId));
 
     // advance HEAD on this branch
     branches_[HEAD_] = mergeId;
     HEAD_commitId_  = mergeId;
     lastCommittedEventIndex_ = workingGraph_.getEventLog().size();
+    trimUndoJournal(mergeId);
+    if (bitmapsEnabled_) dropUnreferencedBitmaps();
 
     return MergeResult{ mergeId, std::move(conflicts) };
 }
 
 // ——— Helpers ———
 
+void Repository::addCommit(Commit c) {
+    // identical content, identical ID: already stored
+    if (commits_.count(c.id)) return;
+    std::size_t gen = 0;
+    for (const auto& pid : c.parents) {
+        gen = std::max(gen, commits_.at(pid).generation);
+    }
+    c.generation = gen + 1;
+    if (!c.events.empty()) {
+        c.eventCount = c.events.size();
+        auto [lo, hi] = std::minmax_element(
+            c.events.begin(), c.events.end(),
+            [](const Event& x, const Event& y) { return x.timestamp < y.timestamp; });
+        c.firstTimestamp = lo->timestamp;
+        c.lastTimestamp = hi->timestamp;
+    }
+    commitIndex_.emplace(c.id, commits_.size());
+    std::string id = c.id;
+    commits_.emplace(id, std::move(c));
+    if (bitmapsEnabled_) {
+        bitmapFor(id);  // derived from the parents' bitmaps
+    }
+}
+
 void Repository::buildAncestors(const std::string& cid,
                                 std::vector<std::string>& out,
                                 std::unordered_set<std::string>& seen) const {
     if (!seen.insert(cid).second) return;
-    const Commit& cm = commits_.at(cid);
-    for (auto& pid : cm.parents) {
-        buildAncestors(pid, out, seen);
+
+    // explicit DFS stack of (commit, index of the next parent to visit);
+    // a commit is emitted once all of its parents have been
+    std::vector<std::pair<const Commit*, size_t>> stack;
+    stack.push_back({ &commits_.at(cid), 0 });
+    while (!stack.empty()) {
+        auto& [cm, next] = stack.back();
+        if (next < cm->parents.size()) {
+            const std::string& pid = cm->parents[next++];
+            if (seen.insert(pid).second) {
+                stack.push_back({ &commits_.at(pid), 0 });
+            }
+        } else {
+            out.push_back(cm->id);
+            stack.pop_back();
+        }
+    }
+}
+
+bool Repository::isAncestor(const std::string& ancestor,
+                            const std::string& descendant) const {
+    auto ait = commits_.find(ancestor);
+    if (ait == commits_.end()) {
+        throw std::runtime_error("Commit '" + ancestor + "' does not exist");
+    }
+    if (!commits_.count(descendant)) {
+        throw std::runtime_error("Commit '" + descendant + "' does not exist");
+    }
+    if (auto bit = tipBitmaps_.find(descendant); bit != tipBitmaps_.end()) {
+        return bit->second.test(commitIndex_.at(ancestor));
+    }
+    const std::size_t floor = ait->second.generation;
+
+    // DFS over parents, skipping anything too old to lead to `ancestor`
+    std::vector<std::string> stack{ descendant };
+    std::unordered_set<std::string> seen{ descendant };
+    while (!stack.empty()) {
+        std::string cid = std::move(stack.back());
+        stack.pop_back();
+        if (cid == ancestor) return true;
+
+        const Commit& cm = commits_.at(cid);
+        if (cm.generation <= floor) continue;
+        for (const auto& pid : cm.parents) {
+            if (commits_.at(pid).generation >= floor && seen.insert(pid).second) {
+                stack.push_back(pid);
+            }
+        }
+    }
+    return false;
+}
+
+std::optional<std::string> Repository::mergeBase(const std::string& a,
+                                                const std::string& b) const {
+    if (!commits_.count(a)) {
+        throw std::runtime_error("Commit '" + a + "' does not exist");
+    }
+    if (!commits_.count(b)) {
+        throw std::runtime_error("Commit '" + b + "' does not exist");
+    }
+    if (a == b) return a;
+
+    // O(1) answers for the fast-forward / up-to-date cases
+    if (auto bit = tipBitmaps_.find(b);
+        bit != tipBitmaps_.end() && bit->second.test(commitIndex_.at(a))) {
+        return a;
+    }
+    if (auto ait = tipBitmaps_.find(a);
+        ait != tipBitmaps_.end() && ait->second.test(commitIndex_.at(b))) {
+        return b;
+    }
+
+    // Paint ancestors of a with colour 1 and of b with colour 2, highest
+    // generation first. A commit's colour is final once it is popped, since
+    // all of its descendants have a higher generation.
+    enum : unsigned char { FROM_A = 1, FROM_B = 2, BOTH = 3 };
+    using Item = std::pair<std::size_t, std::string>;  // (generation, commit)
+    std::priority_queue<Item> queue;
+    std::unordered_map<std::string, unsigned char> colour;
+    colour[a] = FROM_A;
+    colour[b] = FROM_B;
+    queue.push({ commits_.at(a).generation, a });
+    queue.push({ commits_.at(b).generation, b });
+
+    std::unordered_set<std::string> done;
+    while (!queue.empty()) {
+        std::string cid = queue.top().second;
+        queue.pop();
+        if (!done.insert(cid).second) continue;
+
+        const unsigned char c = colour[cid];
+        if (c == BOTH) return cid;
+        for (const auto& pid : commits_.at(cid).parents) {
+            unsigned char& pc = colour[pid];
+            if ((pc | c) != pc) {
+                pc |= c;
+                queue.push({ commits_.at(pid).generation, pid });
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+void Repository::enableReachabilityBitmaps() {
+    bitmapsEnabled_ = true;
+    // lower tips first, so higher ones can reuse their bitmaps
+    std::vector<std::pair<std::size_t, std::string>> tips;
+    for (const auto& [name, cid] : branches_) {
+        tips.push_back({ commits_.at(cid).generation, cid });
+    }
+    std::sort(tips.begin(), tips.end());
+    for (const auto& tip : tips) bitmapFor(tip.second);
+}
+
+const ReachabilityBitmap& Repository::bitmapFor(const std::string& cid) {
+    if (auto it = tipBitmaps_.find(cid); it != tipBitmaps_.end()) {
+        return it->second;
+    }
+    // DFS over ancestors, reusing any bitmap already built on the way
+    ReachabilityBitmap bm;
+    std::vector<std::string> stack{ cid };
+    std::unordered_set<std::string> seen{ cid };
+    while (!stack.empty()) {
+        std::string cur = std::move(stack.back());
+        stack.pop_back();
+        if (auto it = tipBitmaps_.find(cur); it != tipBitmaps_.end()) {
+            bm.merge(it->second);
+            continue;
+        }
+        bm.set(commitIndex_.at(cur));
+        for (const auto& pid : commits_.at(cur).parents) {
+            if (seen.insert(pid).second) stack.push_back(pid);
+        }
+    }
+    return tipBitmaps_.emplace(cid, std::move(bm)).first->second;
+}
+
+void Repository::dropUnreferencedBitmaps() {
+    std::unordered_set<std::string> tips;
+    for (const auto& [name, cid] : branches_) tips.insert(cid);
+    for (auto it = tipBitmaps_.begin(); it != tipBitmaps_.end(); ) {
+        if (tips.count(it->first)) ++it;
+        else it = tipBitmaps_.erase(it);
+    }
+}
+
+std::optional<std::vector<std::string>>
+Repository::firstParentPath(const std::string& from, const std::string& to) const {
+    const std::size_t floor = commits_.at(from).generation;
+    std::vector<std::string> path;
+    for (std::string cid = to; cid != from; ) {
+        const Commit& cm = commits_.at(cid);
+        if (cm.generation <= floor || cm.parents.empty()) {
+            return std::nullopt;
+        }
+        path.push_back(cid);
+        cid = cm.parents[0];
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+std::string Repository::firstParentForkPoint(const std::string& a,
+                                             const std::string& b) const {
+    // Walk a's ancestors in decreasing generation order, only as far down as
+    // the current candidate on b's first-parent chain. Once everything above
+    // the candidate's generation is expanded, the candidate is an ancestor
+    // of a exactly when it has been reached.
+    using Item = std::pair<std::size_t, std::string>;  // (generation, commit)
+    std::priority_queue<Item> frontier;
+    std::unordered_set<std::string> reached{ a };
+    frontier.push({ commits_.at(a).generation, a });
+
+    for (std::string cand = b; ; ) {
+        const Commit& cm = commits_.at(cand);
+        while (!frontier.empty() && frontier.top().first > cm.generation) {
+            std::string cid = frontier.top().second;
+            frontier.pop();
+            for (const auto& pid : commits_.at(cid).parents) {
+                if (reached.insert(pid).second) {
+                    frontier.push({ commits_.at(pid).generation, pid });
+                }
+            }
+        }
+        if (reached.count(cand)) return cand;
+        if (cm.parents.empty()) return {};
+        cand = cm.parents[0];
+    }
+}
+
+void Repository::setStateCacheLimit(std::size_t maxBytes) {
+    std::lock_guard<std::mutex> lock(locks_->cache);
+    stateCache_.setLimit(maxBytes);
+}
+
+std::shared_ptr<const Graph> Repository::cachedState(const std::string& cid) const {
+    std::lock_guard<std::mutex> lock(locks_->cache);
+    return stateCache_.get(cid);
+}
+
+void Repository::cacheState(const std::string& cid,
+                            std::shared_ptr<const Graph> state) const {
+    std::lock_guard<std::mutex> lock(locks_->cache);
+    if (stateCache_.limit() > 0 && !stateCache_.contains(cid)) {
+        stateCache_.put(cid, std::move(state));
+    }
+}
+
+// ——— Read-only access ———
+
+std::shared_ptr<const Graph> Repository::graphAt(const std::string& commitId) const {
+    std::shared_lock<std::shared_mutex> lock(locks_->history);
+    if (!commits_.count(commitId)) {
+        throw std::runtime_error("Commit '" + commitId + "' does not exist");
+    }
+    return materialize(commitId);
+}
+
+std::shared_ptr<const Snapshot> Repository::snapshotAt(const std::string& branchName,
+                                                       std::int64_t timestamp) const {
+    std::shared_ptr<const Graph> g;
+    {
+        std::shared_lock<std::shared_mutex> lock(locks_->history);
+        auto it = branches_.find(branchName);
+        if (it == branches_.end()) {
+            throw std::runtime_error("Branch '" + branchName + "' does not exist");
+        }
+        g = materialize(it->second);
+    }
+    return std::make_shared<const Snapshot>(*g, timestamp);
+}
+
+std::shared_ptr<const Graph> Repository::materialize(const std::string& commitId) const {
+    // walk down the first-parent chain to the nearest cached state
+    std::vector<std::string> path;
+    std::shared_ptr<const Graph> base;
+    for (std::string cid = commitId; ; ) {
+        if ((base = cachedState(cid))) break;
+        if (cid == baseCommitId_) {
+            base = baseState_;
+            break;
+        }
+        if (compacted_.count(cid)) {
+            throw std::runtime_error("Commit '" + cid + "' was compacted");
+        }
+        path.push_back(cid);
+        const Commit& cm = commits_.at(cid);
+        if (cm.parents.empty()) break;
+        cid = cm.parents[0];
+    }
+    if (path.empty()) return base;
+
+    // replay the commits above it into a private copy
+    auto g = base ? std::make_shared<Graph>(*base) : std::make_shared<Graph>();
+    std::reverse(path.begin(), path.end());
+    for (const auto& chunk : eventsOf(path)) g->replayEvents(chunk);
+    g->resetUndoJournal();
+    cacheState(commitId, g);
+    return g;
+}
+
+std::string Repository::firstParentMeet(const std::string& a,
+                                        const std::string& b) const {
+    // step down whichever chain is higher; generations strictly decrease
+    // along a chain, so neither walk can skip past the meeting point
+    std::string x = a, y = b;
+    while (x != y) {
+        const Commit& cx = commits_.at(x);
+        const Commit& cy = commits_.at(y);
+        if (cx.generation >= cy.generation) {
+            if (cx.parents.empty()) return {};
+            x = cx.parents[0];
+        } else {
+            if (cy.parents.empty()) return {};
+            y = cy.parents[0];
+        }
+    }
+    return x;
+}
+
+void Repository::moveWorkingGraph(const std::string& from, const std::string& to) {
+    // 0) keep the state being left (unless it has uncommitted changes),
+    //    and restore `to` outright if it is cached
+    if (stateCache_.limit() > 0 &&
+        workingGraph_.getEventLog().size() == lastCommittedEventIndex_ &&
+        !cachedState(from)) {
+        cacheState(from, std::make_shared<Graph>(workingGraph_.copyWithoutUndoJournal()));
+    }
+    if (auto state = cachedState(to)) {
+        restoreWorkingGraph(*state);
+        return;
+    }
+
+    // 1) `to` is ahead of `from` on its first-parent chain: replay the difference
+    if (auto path = firstParentPath(from, to)) {
+        replayCommits(*path);
+        return;
+    }
+
+    // 2) start from the nearest cached ancestor on `to`'s first-parent chain,
+    //    if it is closer than the point where the two chains meet
+    const std::string meet = firstParentMeet(from, to);
+    if (stateCache_.limit() > 0) {
+        std::vector<std::string> path;
+        for (std::string cid = to; cid != meet; ) {
+            if (auto state = cachedState(cid)) {
+                restoreWorkingGraph(*state);
+                std::reverse(path.begin(), path.end());
+                replayCommits(path);
+                return;
+            }
+            path.push_back(cid);
+            const Commit& cm = commits_.at(cid);
+            if (cm.parents.empty()) break;
+            cid = cm.parents[0];
+        }
+    }
+
+    // 3) undo `from`'s commits back to where the two chains meet, then replay
+    //    `to`'s side; the working log is the events of the first-parent chain
+    //    of `from`, so the meeting point sits at a known log position
+    if (!meet.empty()) {
+        size_t revert = 0;
+        for (std::string cid = from; cid != meet; cid = commits_.at(cid).parents[0]) {
+            revert += commits_.at(cid).eventCount;
+        }
+        if (revert <= lastCommittedEventIndex_ &&
+            workingGraph_.rollbackTo(lastCommittedEventIndex_ - revert)) {
+            replayCommits(*firstParentPath(meet, to));
+            return;
+        }
+    }
+
+    // 4) no journal to undo with: rebuild from scratch
+    rebuildWorkingGraph(to);
+}
+
+void Repository::restoreWorkingGraph(const Graph& state) {
+    workingGraph_ = state;
+    // states built by graphAt carry no journal
+    workingGraph_.enableUndoJournal();
+}
+
+void Repository::rebuildWorkingGraph(const std::string& cid) const {
+    // a commit's state is its first parent's state plus its own events
+    // (merge commits record the merged-in delta), so only the first-parent
+    // chain is replayed
+    std::vector<std::string> chain = chainToBase(cid);
+    if (baseState_) {
+        workingGraph_ = *baseState_;
+        workingGraph_.enableUndoJournal();
+    } else {
+        workingGraph_.clearGraph();
+    }
+    replayCommits(chain);
+}
+
+std::vector<std::string> Repository::chainToBase(const std::string& cid) const {
+    std::vector<std::string> chain;
+    for (std::string cur = cid; cur != baseCommitId_; ) {
+        if (compacted_.count(cur)) {
+            throw std::runtime_error("Commit '" + cur + "' was compacted");
+        }
+        chain.push_back(cur);
+        const Commit& cm = commits_.at(cur);
+        if (cm.parents.empty()) break;
+        cur = cm.parents[0];
+    }
+    std::reverse(chain.begin(), chain.end());
+    return chain;
+}
+
+void Repository::replayCommits(const std::vector<std::string>& cids) const {
+    // the working log references the commits' chunks instead of copying them;
+    // long replays trim the journal as they go
+    std::vector<size_t> starts;
+    for (const auto& chunk : eventsOf(cids)) {
+        starts.push_back(workingGraph_.getEventLog().size());
+        workingGraph_.replayEvents(chunk);
+        if (starts.size() >= kUndoCommits) {
+            workingGraph_.trimUndoJournal(starts[starts.size() - kUndoCommits]);
+        }
+    }
+    if (!cids.empty()) trimUndoJournal(cids.back());
+}
+
+void Repository::trimUndoJournal(const std::string& tip) const {
+    // the working log holds the events of tip's first-parent chain
+    size_t keep = 0;
+    std::string cid = tip;
+    for (size_t n = 0; n < kUndoCommits && cid != baseCommitId_; ++n) {
+        const Commit& c = commits_.at(cid);
+        keep += c.eventCount;
+        if (c.parents.empty()) break;
+        cid = c.parents[0];
     }
-    out.push_back(cid);
+    const size_t size = workingGraph_.getEventLog().size();
+    workingGraph_.trimUndoJournal(size > keep ? size - keep : 0);
 }
 
 }  // namespace chronograph
\ No newline at end of file
@@ -0,0 +1,129 @@
+#include <chronograph/repo/StateCache.h>
+#include <utility>
+
+namespace chronograph {
+namespace {
+// per-element overhead of a node-based container entry (links, hash, padding)
+constexpr std::size_t kNodeOverhead = 32;
+
+std::size_t stringBytes(const std::string& s) {
+    // short strings live inside the object (SSO)
+    return sizeof(std::string) + (s.capacity() > 15 ? s.capacity() + 1 : 0);
+}
+
+std::size_t attributeBytes(const std::map<std::string, std::string>& attrs) {
+    std::size_t total = 0;
+    for (const auto& [k, v] : attrs) {
+        total += kNodeOverhead + stringBytes(k) + stringBytes(v);
+    }
+    return total;
+}
+
+std::size_t eventBytes(const Event& e) {
+    return sizeof(Event) + stringBytes(e.id) + stringBytes(e.entityId) +
+           stringBytes(e.from) + stringBytes(e.to) + attributeBytes(e.payload);
+}
+
+template <typename NodeMap, typename EdgeMap, typename AdjMap>
+std::size_t stateBytes(const NodeMap& nodes, const EdgeMap& edges,
+                       const AdjMap& outgoing, const AdjMap& incoming) {
+    std::size_t total = 0;
+    for (const auto& [id, n] : nodes) {
+        total += kNodeOverhead + stringBytes(id) + sizeof(Node) + attributeBytes(n.attributes);
+    }
+    for (const auto& [id, e] : edges) {
+        total += kNodeOverhead + stringBytes(id) + sizeof(Edge) +
+                 stringBytes(e.from) + stringBytes(e.to) + attributeBytes(e.attributes);
+    }
+    for (const auto* adj : { &outgoing, &incoming }) {
+        for (const auto& [id, list] : *adj) {
+            total += kNodeOverhead + stringBytes(id) + sizeof(list);
+            for (const auto& eid : list) total += stringBytes(eid);
+        }
+    }
+    return total;
+}
+}  // namespace
+
+StateCache::StateCache(std::size_t maxBytes)
+    : maxBytes_(maxBytes) {}
+
+void StateCache::setLimit(std::size_t maxBytes) {
+    maxBytes_ = maxBytes;
+    evictToFit(maxBytes_);
+}
+
+std::shared_ptr<const Graph> StateCache::get(const std::string& commitId) {
+    auto it = index_.find(commitId);
+    if (it == index_.end()) return nullptr;
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return it->second->state;
+}
+
+bool StateCache::contains(const std::string& commitId) const {
+    return index_.count(commitId) > 0;
+}
+
+void StateCache::put(const std::string& commitId, std::shared_ptr<const Graph> state) {
+    if (!state) return;
+    const std::size_t size = estimateBytes(*state);
+    if (size > maxBytes_) return;
+
+    if (auto it = index_.find(commitId); it != index_.end()) {
+        bytes_ -= it->second->bytes;
+        lru_.erase(it->second);
+        index_.erase(it);
+    }
+    evictToFit(maxBytes_ - size);
+    lru_.push_front(Entry{ commitId, std::move(state), size });
+    index_.emplace(commitId, lru_.begin());
+    bytes_ += size;
+}
+
+void StateCache::clear() {
+    lru_.clear();
+    index_.clear();
+    bytes_ = 0;
+}
+
+std::size_t StateCache::erase(const std::string& commitId) {
+    auto it = index_.find(commitId);
+    if (it == index_.end()) return 0;
+    const std::size_t size = it->second->bytes;
+    bytes_ -= size;
+    lru_.erase(it->second);
+    index_.erase(it);
+    return size;
+}
+
+void StateCache::evictToFit(std::size_t budget) {
+    while (bytes_ > budget && !lru_.empty()) {
+        bytes_ -= lru_.back().bytes;
+        index_.erase(lru_.back().commitId);
+        lru_.pop_back();
+    }
+}
+
+std::size_t StateCache::estimateBytes(const Graph& g) {
+    std::size_t total = sizeof(Graph);
+    total += stateBytes(g.getNodes(), g.getEdges(), g.getOutgoing(), g.getIncoming());
+    // sealed chunks are shared with the commits that own them; only their
+    // handles and the unsealed tail belong to this state
+    const auto& log = g.getEventLog();
+    total += log.chunkCount() * sizeof(EventChunk);
+    for (auto it = log.begin() + log.sealedSize(); it != log.end(); ++it) {
+        total += eventBytes(*it);
+    }
+    for (const auto& cp : g.getCheckpoints()) {
+        total += sizeof(cp) + stateBytes(cp.nodes, cp.edges, cp.outgoing, cp.incoming);
+    }
+    return total;
+}
+
+std::size_t StateCache::estimateBytes(const EventChunk& events) {
+    std::size_t total = sizeof(std::vector<Event>);
+    for (const auto& e : events) total += eventBytes(e);
+    return total;
+}
+
+}  // namespace chronograph
@@ -0,0 +1,100 @@
+// tests/test_AlgorithmCache.cpp
+
+#include <gtest/gtest.h>
+#include <chronograph/graph/Graph.h>
+#include <chronograph/graph/algorithms/Cache.h>
+#include <chronograph/graph/algorithms/Connectivity.h>
+#include <chronograph/graph/algorithms/Paths.h>
+#include <string>
+#include <vector>
+
+using namespace chronograph;
+using namespace chronograph::graph::algorithms;
+
+TEST(GraphVersion, BumpedByEveryChange) {
+    Graph g;
+    auto v0 = g.version();
+    g.addNode("a", {}, 1);
+    auto v1 = g.version();
+    EXPECT_NE(v0, v1);
+
+    Graph copy = g;
+    EXPECT_EQ(copy.version(), v1);   // same state, same version
+
+    g.updateNode("a", {{"k","v"}}, 2);
+    EXPECT_NE(g.version(), v1);
+    EXPECT_EQ(copy.version(), v1);
+
+    copy.addNode("b", {}, 2);
+    EXPECT_NE(copy.version(), g.version());
+
+    auto before = g.version();
+    g.applyEvent(Event{"ev", 3, EventType::ADD_NODE, "c", {}, "", ""});
+    EXPECT_NE(g.version(), before);
+    before = g.version();
+    g.clearStateKeepLog();
+    EXPECT_NE(g.version(), before);
+}
+
+TEST(AlgorithmCache, HitsUntilGraphChanges) {
+    Graph g;
+    g.addNode("a", {}, 1);
+    g.addNode("b", {}, 1);
+    g.addEdge("e1", "a", "b", {}, 2);
+
+    AlgorithmCache cache(8);
+    auto first = cachedTopologicalSort(cache, g);
+    auto second = cachedTopologicalSort(cache, g);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(cache.misses(), 1u);
+    EXPECT_EQ(cache.hits(), 1u);
+
+    EXPECT_EQ(cachedShortestPath(cache, g, "a", "b"), shortestPath(g, "a", "b"));
+    EXPECT_EQ(cachedShortestPath(cache, g, "b", "a"), std::vector<std::string>{});
+    EXPECT_EQ(cache.misses(), 3u);
+
+    // a back edge creates a cycle: the old answer must not be served
+    g.addEdge("e2", "b", "a", {}, 3);
+    EXPECT_FALSE(cachedTopologicalSort(cache, g).has_value());
+    EXPECT_EQ(cachedStronglyConnectedComponents(cache, g).size(), 1u);
+    EXPECT_EQ(cache.hits(), 1u);
+}
+
+TEST(AlgorithmCache, ParametersWithNulBytesDoNotCollide) {
+    using namespace std::string_literals;
+    Graph g;
+    for (const auto& id : {"a"s, "a\0"s, "b"s, "\0b"s}) g.addNode(id, {}, 1);
+    g.addEdge("e1", "a\0"s, "b", {}, 2);
+    g.addEdge("e2", "a", "\0b"s, {}, 2);
+
+    AlgorithmCache cache(8);
+    EXPECT_EQ(cachedShortestPath(cache, g, "a\0"s, "b"), (std::vector<std::string>{"a\0"s, "b"}));
+    EXPECT_EQ(cachedShortestPath(cache, g, "a", "\0b"s), (std::vector<std::string>{"a", "\0b"s}));
+    EXPECT_EQ(cache.misses(), 2u);
+
+    int calls = 0;
+    auto compute = [&] { return ++calls; };
+    cache.getOrCompute<int>("f\0"s, "x", 1, compute);
+    cache.getOrCompute<int>("f", "\0x"s, 1, compute);
+    EXPECT_EQ(calls, 2);
+}
+
+TEST(AlgorithmCache, EvictsLeastRecentlyUsed) {
+    AlgorithmCache cache(2);
+    int calls = 0;
+    auto compute = [&] { return ++calls; };
+
+    cache.getOrCompute<int>("f", "1", 1, compute);
+    cache.getOrCompute<int>("f", "2", 1, compute);
+    cache.getOrCompute<int>("f", "1", 1, compute);   // hit, 1 is now fresh
+    cache.getOrCompute<int>("f", "3", 1, compute);   // evicts 2
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_EQ(calls, 3);
+
+    EXPECT_EQ(cache.getOrCompute<int>("f", "1", 1, compute), 1);
+    EXPECT_EQ(cache.getOrCompute<int>("f", "2", 1, compute), 4);
+    EXPECT_EQ(calls, 4);
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0u);
+}
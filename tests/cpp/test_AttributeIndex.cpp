@@ -0,0 +1,84 @@
+// tests/test_AttributeIndex.cpp
+
+#include <chronograph/graph/Graph.h>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace chronograph;
+
+using Ids = std::vector<std::string>;
+
+TEST(AttributeIndex, LookupMatchesScanAndTracksMutations) {
+    Graph g;
+    g.addNode("a", {{"status","active"}}, 1);
+    g.addNode("b", {{"status","idle"}},   2);
+
+    // no index: scan
+    EXPECT_FALSE(g.hasNodeIndex("status"));
+    EXPECT_EQ(g.findNodes("status", "active"), (Ids{"a"}));
+
+    g.createNodeIndex("status");
+    ASSERT_TRUE(g.hasNodeIndex("status"));
+    EXPECT_EQ(g.findNodes("status", "active"), (Ids{"a"}));
+
+    g.addNode("c", {{"status","active"}}, 3);
+    g.updateNode("b", {{"status","active"}}, 4);
+    EXPECT_EQ(g.findNodes("status", "active"), (Ids{"a","b","c"}));
+
+    g.delNode("a", 5);
+    g.updateNode("c", {{"status","idle"}}, 6);
+    EXPECT_EQ(g.findNodes("status", "active"), (Ids{"b"}));
+    EXPECT_EQ(g.findNodes("status", "idle"),   (Ids{"c"}));
+    EXPECT_TRUE(g.findNodes("status", "gone").empty());
+
+    g.dropNodeIndex("status");
+    EXPECT_FALSE(g.hasNodeIndex("status"));
+    EXPECT_EQ(g.findNodes("status", "active"), (Ids{"b"}));
+}
+
+TEST(AttributeIndex, OrderedRangeQuery) {
+    Graph g;
+    g.addNode("x", {{"score","1.5"}}, 1);
+    g.addNode("y", {{"score","10"}},  1);
+    g.addNode("z", {{"score","n/a"}}, 1);
+    g.addNode("w", {{"score","7"}},   1);
+
+    Ids scanned = g.findNodesInRange("score", 1.0, 8.0);
+    EXPECT_EQ(scanned, (Ids{"w","x"}));
+
+    g.createNodeIndex("score", Graph::IndexKind::ORDERED);
+    EXPECT_EQ(g.findNodesInRange("score", 1.0, 8.0), scanned);
+
+    g.updateNode("y", {{"score","2"}}, 2);
+    EXPECT_EQ(g.findNodesInRange("score", 1.0, 8.0), (Ids{"w","x","y"}));
+    EXPECT_EQ(g.findNodesInRange("score", 10.0, 10.0), Ids{});
+}
+
+TEST(AttributeIndex, AsOfQueriesUseValidityIntervals) {
+    Graph g;
+    g.addNode("a", {{"status","active"}}, 10);
+    g.addNode("b", {{"status","active"}}, 20);
+    g.updateNode("a", {{"status","idle"}}, 30);
+
+    // index built after the fact still knows the history
+    g.createNodeIndex("status");
+    g.delNode("b", 40);
+    g.updateNode("a", {{"status","active"}}, 50);
+
+    EXPECT_EQ(g.findNodesAt("status", "active", 5),  Ids{});
+    EXPECT_EQ(g.findNodesAt("status", "active", 25), (Ids{"a","b"}));
+    EXPECT_EQ(g.findNodesAt("status", "active", 30), (Ids{"b"}));
+    EXPECT_EQ(g.findNodesAt("status", "idle",   35), (Ids{"a"}));
+    EXPECT_EQ(g.findNodesAt("status", "active", 45), Ids{});
+    EXPECT_EQ(g.findNodesAt("status", "active", 55), (Ids{"a"}));
+
+    EXPECT_THROW(g.findNodesAt("role", "x", 0), std::runtime_error);
+
+    // replaying the log through applyEvent rebuilds the same history
+    g.clearStateKeepLog();
+    for (const auto& e : g.getEventLog()) g.applyEvent(e);
+    EXPECT_EQ(g.findNodesAt("status", "active", 25), (Ids{"a","b"}));
+    EXPECT_EQ(g.findNodes("status", "active"), (Ids{"a"}));
+}
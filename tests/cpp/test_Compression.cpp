@@ -0,0 +1,106 @@
+// tests/test_Compression.cpp
+
+#include <chronograph/graph/Compression.h>
+#include <chronograph/graph/EventCodec.h>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace chronograph;
+
+namespace {
+std::string roundTrip(const std::string& s) {
+    std::string packed = lzCompress(s.data(), s.size());
+    return lzDecompress(packed.data(), packed.size());
+}
+
+// an audit-style history: few keys, similar values, sequential IDs and times
+std::vector<Event> history(std::size_t n) {
+    std::mt19937 rng(7);
+    std::vector<Event> events;
+    for (std::size_t i = 0; i < n; ++i) {
+        Event e;
+        e.id = "ev" + std::to_string(100000 + i);
+        e.timestamp = 1700000000000 + static_cast<std::int64_t>(i) * 1000 + rng() % 50;
+        const std::string node = "account-" + std::to_string(i % 500);
+        if (i % 4 == 3) {
+            e.type = EventType::ADD_EDGE;
+            e.entityId = "tx-" + std::to_string(i);
+            e.from = node;
+            e.to = "account-" + std::to_string((i * 7) % 500);
+            e.payload = {{"amount", std::to_string(rng() % 1000)}, {"currency", "EUR"}};
+        } else {
+            e.type = i < 500 ? EventType::ADD_NODE : EventType::UPDATE_NODE;
+            e.entityId = node;
+            e.payload = {{"status", (rng() % 3) ? "active" : "review"},
+                         {"region", "eu-west-" + std::to_string(rng() % 3)},
+                         {"owner", "team-" + std::to_string(i % 12)}};
+        }
+        events.push_back(std::move(e));
+    }
+    return events;
+}
+}  // namespace
+
+TEST(Compression, LzRoundTrips) {
+    std::mt19937 rng(1);
+    std::string random(70000, '\0');
+    for (auto& c : random) c = static_cast<char>(rng());
+    std::string repetitive;
+    for (int i = 0; i < 5000; ++i) repetitive += "key=value;" + std::to_string(i % 17);
+
+    for (const std::string& s : {std::string(), std::string("a"), std::string("abcdefghij"),
+                                 std::string(100000, 'x'), random, repetitive}) {
+        EXPECT_EQ(roundTrip(s), s);
+    }
+    EXPECT_LT(lzCompress(repetitive.data(), repetitive.size()).size(), repetitive.size() / 5);
+    EXPECT_LT(lzCompress(random.data(), random.size()).size(), random.size() + random.size() / 100);
+}
+
+TEST(Compression, LzRejectsMalformedInput) {
+    std::string s(1000, 'y');
+    std::string packed = lzCompress(s.data(), s.size());
+    EXPECT_THROW(lzDecompress(packed.data(), packed.size() - 1), std::runtime_error);
+    std::string wrongSize = packed;
+    wrongSize[0] = static_cast<char>(wrongSize[0] + 1);   // varint size off by one
+    EXPECT_THROW(lzDecompress(wrongSize.data(), wrongSize.size()), std::runtime_error);
+    const std::string badOffset("\x08\x40" "abcd" "\x09\x00", 8);  // match before the start
+    EXPECT_THROW(lzDecompress(badOffset.data(), badOffset.size()), std::runtime_error);
+
+    // a declared size the input cannot expand to is rejected before allocating
+    std::string huge;
+    putVarint(huge, std::uint64_t(1) << 39);
+    huge += std::string("\x0f\x00", 2);
+    EXPECT_THROW(lzDecompress(huge.data(), huge.size()), std::runtime_error);
+    // the densest encoding still decodes: long runs need ~1 byte per 255
+    std::string run(1 << 20, 'z');
+    packed = lzCompress(run.data(), run.size());
+    EXPECT_LT(packed.size() * 250, run.size());
+    EXPECT_EQ(lzDecompress(packed.data(), packed.size()), run);
+}
+
+TEST(Compression, EventBlocksRoundTripAndShrink) {
+    const auto events = history(20000);
+    const std::string block = compressEvents(events);
+    const auto back = decompressEvents(block.data(), block.size());
+    ASSERT_EQ(back.size(), events.size());
+    for (std::size_t i = 0; i < events.size(); ++i) {
+        EXPECT_EQ(back[i].id, events[i].id);
+        EXPECT_EQ(back[i].timestamp, events[i].timestamp);
+        EXPECT_EQ(back[i].type, events[i].type);
+        EXPECT_EQ(back[i].entityId, events[i].entityId);
+        EXPECT_EQ(back[i].payload, events[i].payload);
+        EXPECT_EQ(back[i].from, events[i].from);
+        EXPECT_EQ(back[i].to, events[i].to);
+    }
+
+    std::string canonical;
+    for (const auto& e : events) encodeEvent(e, canonical);
+    EXPECT_LT(block.size() * 5, canonical.size());
+
+    EXPECT_TRUE(decompressEvents(compressEvents({}).data(), compressEvents({}).size()).empty());
+    std::string corrupt = block;
+    corrupt.resize(corrupt.size() / 2);
+    EXPECT_THROW(decompressEvents(corrupt.data(), corrupt.size()), std::runtime_error);
+}
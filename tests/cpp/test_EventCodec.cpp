@@ -0,0 +1,79 @@
+// tests/test_EventCodec.cpp
+
+#include <chronograph/graph/EventCodec.h>
+#include <chronograph/graph/Graph.h>
+#include <chronograph/graph/Hash.h>
+#include <chronograph/repo/Repository.h>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+
+using namespace chronograph;
+
+TEST(Hash128, MatchesReferenceVectors) {
+    EXPECT_EQ(hash128(std::string()).toHex(), std::string(32, '0'));
+    EXPECT_EQ(hash128(std::string("hello")).toHex(),
+              "cbd8a7b341bd9b025b1e906a48ae1d19");
+    EXPECT_EQ(hash128(std::string("The quick brown fox jumps over the lazy dog")).toHex(),
+              "e34bbc7bbc071b6c7a433ca9c49a9347");
+    EXPECT_NE(hash128(std::string("hello"), 1), hash128(std::string("hello")));
+}
+
+TEST(EventCodec, RoundTripIsCanonical) {
+    Event e{"ev1", -42, EventType::ADD_EDGE, "e1", {{"w","3"},{"a",""}}, "A", "B"};
+    std::string bytes;
+    encodeEvent(e, bytes);
+    encodeEvent(e, bytes);
+
+    const char* pos = bytes.data();
+    const char* end = bytes.data() + bytes.size();
+    Event d = decodeEvent(pos, end);
+    EXPECT_EQ(d.id, e.id);
+    EXPECT_EQ(d.timestamp, -42);
+    EXPECT_EQ(d.type, EventType::ADD_EDGE);
+    EXPECT_EQ(d.payload, e.payload);
+    EXPECT_EQ(d.from, "A");
+    EXPECT_EQ(d.to, "B");
+    ASSERT_EQ(pos, bytes.data() + bytes.size() / 2);
+
+    std::string again;
+    encodeEvent(d, again);
+    EXPECT_EQ(again, bytes.substr(0, bytes.size() / 2));
+
+    end = bytes.data() + bytes.size() - 1;   // cut the last byte
+    EXPECT_THROW(decodeEvent(pos, end), std::runtime_error);
+}
+
+TEST(ContentAddressedCommits, IdsFollowContent) {
+    auto a = Repository::init("main");
+    auto b = Repository::init("main");
+    auto rootA = a.listCommits("main").front().id;
+    EXPECT_EQ(rootA, b.listCommits("main").front().id);   // same (empty) content
+    EXPECT_EQ(rootA.size(), 32u);
+
+    a.addNode("n", {}, 1);
+    auto c1 = a.commit("one");
+    const Commit first = a.listCommits("main").back();
+    // recomputing over the same parents, message and events gives the same ID
+    std::string bytes;
+    putU32(bytes, 1);
+    putString(bytes, rootA);
+    putString(bytes, "one");
+    putU64(bytes, first.events.size());
+    for (const auto& e : first.events) encodeEvent(e, bytes);
+    EXPECT_EQ(hash128(bytes).toHex(), c1);
+
+    // different events (event IDs are random) give a different commit
+    b.addNode("n", {}, 1);
+    EXPECT_NE(b.commit("one"), c1);
+
+    Graph g;
+    std::unordered_set<std::string> ids;
+    for (int i = 0; i < 1000; ++i) g.addNode("x" + std::to_string(i), {}, i);
+    for (const auto& e : g.getEventLog()) {
+        EXPECT_EQ(e.id.size(), 15u);
+        ids.insert(e.id);
+    }
+    EXPECT_EQ(ids.size(), 1000u);
+}
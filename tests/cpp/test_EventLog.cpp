@@ -0,0 +1,86 @@
+// tests/test_EventLog.cpp
+
+#include <chronograph/graph/EventLog.h>
+#include <chronograph/graph/Graph.h>
+#include <chronograph/repo/Repository.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace chronograph;
+
+namespace {
+Event makeEvent(const std::string& id, std::int64_t ts) {
+    return Event{id, ts, EventType::ADD_NODE, "n" + id, {}, "", ""};
+}
+
+std::vector<std::string> idsOf(const EventLog& log) {
+    std::vector<std::string> out;
+    for (const auto& e : log) out.push_back(e.id);
+    return out;
+}
+}  // namespace
+
+TEST(EventLog, ChunksAndTailBehaveLikeOneSequence) {
+    EventChunk shared(std::vector<Event>{makeEvent("c1", 3), makeEvent("c2", 4)});
+
+    EventLog log;
+    log.push_back(makeEvent("a", 1));
+    log.push_back(makeEvent("b", 2));
+    log.append(shared);              // seals a,b first
+    log.push_back(makeEvent("d", 5));
+
+    ASSERT_EQ(log.size(), 5u);
+    EXPECT_EQ(log.sealedSize(), 4u);
+    EXPECT_EQ(idsOf(log), (std::vector<std::string>{"a","b","c1","c2","d"}));
+    EXPECT_EQ(log[2].id, "c1");
+    EXPECT_EQ(&log[3], &shared[1]);  // not copied
+    EXPECT_EQ((log.begin() + 3)->id, "c2");
+    EXPECT_EQ(log.end() - log.begin(), 5);
+    EXPECT_EQ(log.back().id, "d");
+
+    // everything since index 4 is the sealed tail; shares storage with the log
+    EventChunk tail = log.share(4);
+    ASSERT_EQ(tail.size(), 1u);
+    EXPECT_EQ(&tail[0], &log[4]);
+
+    // a range over several chunks is merged once and the log re-pointed at it
+    EventChunk merged = log.share(1);
+    EXPECT_EQ(merged.size(), 4u);
+    EXPECT_EQ(&merged[0], &log[1]);
+    EXPECT_EQ(idsOf(log), (std::vector<std::string>{"a","b","c1","c2","d"}));
+
+    log.truncate(2);
+    EXPECT_EQ(idsOf(log), (std::vector<std::string>{"a","b"}));
+    EXPECT_EQ(merged.size(), 4u);    // chunks stay valid after the log drops them
+    log.push_back(makeEvent("e", 6));
+    EXPECT_EQ(idsOf(log), (std::vector<std::string>{"a","b","e"}));
+}
+
+TEST(EventLog, CommitsAndWorkingLogShareEvents) {
+    auto repo = Repository::init("main");
+    repo.addNode("A", {}, 1);
+    repo.addNode("B", {}, 2);
+    repo.commit("c1");
+    repo.branch("dev");
+    repo.checkout("dev");
+    repo.addEdge("AB", "A", "B", {}, 3);
+    repo.commit("c2");
+
+    auto commits = repo.listCommits("dev");
+    ASSERT_EQ(commits.size(), 3u);
+    const Commit& c1 = commits[1];
+    const Commit& c2 = commits[2];
+    const auto& log = repo.graph().getEventLog();
+    ASSERT_EQ(log.size(), 3u);
+    EXPECT_EQ(&c1.events[0], &log[0]);
+    EXPECT_EQ(&c2.events[0], &log[2]);
+
+    // replaying on checkout references the same chunks
+    repo.checkout("main");
+    repo.checkout("dev");
+    EXPECT_EQ(&repo.graph().getEventLog()[2], &c2.events[0]);
+    auto state = repo.graphAt(c2.id);
+    EXPECT_EQ(&state->getEventLog()[0], &c1.events[0]);
+    EXPECT_TRUE(state->getEdges().count("AB"));
+}
@@ -0,0 +1,139 @@
+// tests/test_EventSegment.cpp
+
+#include <chronograph/graph/EventSegment.h>
+#include <chronograph/graph/Graph.h>
+#include <chronograph/graph/Snapshot.h>
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace chronograph;
+namespace fs = std::filesystem;
+
+namespace {
+// fresh path in the temp directory, removed again at scope exit
+struct TempPath {
+    std::string path;
+    explicit TempPath(const std::string& name) {
+        auto seed = ::testing::UnitTest::GetInstance()->random_seed();
+        path = (fs::temp_directory_path() /
+                ("chronograph_" + name + "_" + std::to_string(seed) + ".seg")).string();
+        fs::remove(path);
+    }
+    ~TempPath() { fs::remove(path); }
+};
+
+Graph buildGraph() {
+    Graph g;
+    for (int i = 0; i < 9000; ++i) {
+        g.addNode("n" + std::to_string(i % 700), {{"i", std::to_string(i % 5)}}, i);
+        if (i % 3 == 0) {
+            g.addEdge("e" + std::to_string(i), "n" + std::to_string(i % 700),
+                      "n" + std::to_string((i + 1) % 700), {{"w", "1"}}, i);
+        }
+        if (i % 7 == 0) g.updateNode("n" + std::to_string(i % 700), {{"x", "y"}}, i);
+        if (i % 11 == 0) g.delNode("n" + std::to_string((i + 5) % 700), i);
+    }
+    return g;
+}
+}  // namespace
+
+TEST(EventSegment, SnapshotReplayMatchesGraph) {
+    TempPath file("replay");
+    Graph g = buildGraph();
+    EventSegment::write(file.path, g.getEventLog());
+
+    EventSegment seg(file.path);
+    ASSERT_EQ(seg.size(), g.getEventLog().size());
+    EXPECT_EQ(seg.minTimestamp(), 0);
+    EXPECT_EQ(seg.maxTimestamp(), 8999);
+    // entity IDs, keys and values repeat across events but are stored once
+    std::size_t occurrences = 0;
+    for (const auto& e : g.getEventLog()) occurrences += 4 + 2 * e.payload.size();
+    EXPECT_LT(seg.stringCount() * 2, occurrences);
+
+    for (std::int64_t t : {-1, 0, 4095, 4096, 5000, 8999}) {
+        Snapshot fromGraph(g, t);
+        Snapshot fromSegment(seg, t);
+        EXPECT_EQ(fromSegment.getNodes().size(), fromGraph.getNodes().size()) << t;
+        EXPECT_EQ(fromSegment.getEdges().size(), fromGraph.getEdges().size()) << t;
+        for (const auto& [id, node] : fromGraph.getNodes()) {
+            ASSERT_TRUE(fromSegment.getNodes().count(id)) << id;
+            EXPECT_EQ(fromSegment.getNodes().at(id).attributes, node.attributes) << id;
+        }
+        for (const auto& [id, edge] : fromGraph.getEdges()) {
+            ASSERT_TRUE(fromSegment.getEdges().count(id)) << id;
+            EXPECT_EQ(fromSegment.getEdges().at(id).from, edge.from);
+            EXPECT_EQ(fromSegment.getEdges().at(id).to, edge.to);
+        }
+    }
+}
+
+TEST(EventSegment, CursorStartsAtAnyEvent) {
+    TempPath file("cursor");
+    Graph g = buildGraph();
+    const auto& log = g.getEventLog();
+    EventSegment::write(file.path, log);
+    EventSegment seg(file.path);
+
+    for (std::size_t index : {std::size_t(0), std::size_t(1), EventSegment::kBlockEvents - 1,
+                              EventSegment::kBlockEvents, log.size() - 1}) {
+        auto cursor = seg.cursor(index);
+        EXPECT_EQ(cursor.position(), index);
+        EventView view;
+        ASSERT_TRUE(cursor.next(view));
+        Event e = EventSegment::toEvent(view);
+        EXPECT_EQ(e.id, log[index].id);
+        EXPECT_EQ(e.timestamp, log[index].timestamp);
+        EXPECT_EQ(e.type, log[index].type);
+        EXPECT_EQ(e.entityId, log[index].entityId);
+        EXPECT_EQ(e.payload, log[index].payload);
+        EXPECT_EQ(e.from, log[index].from);
+        EXPECT_EQ(e.to, log[index].to);
+    }
+    EventView view;
+    EXPECT_FALSE(seg.cursor(log.size()).next(view));
+}
+
+TEST(EventSegment, RejectsInvalidFiles) {
+    TempPath file("invalid");
+    EXPECT_THROW(EventSegment seg(file.path), std::runtime_error);   // missing
+    {
+        std::ofstream out(file.path, std::ios::binary);
+        out << std::string(80, 'x');
+    }
+    EXPECT_THROW(EventSegment seg(file.path), std::runtime_error);   // bad magic
+
+    Graph g;
+    g.addNode("A", {}, 1);
+    EventSegment::write(file.path, g.getEventLog());
+    fs::resize_file(file.path, fs::file_size(file.path) - 1);
+    EXPECT_THROW(EventSegment seg(file.path), std::runtime_error);   // truncated
+
+    Graph empty;
+    EventSegment::write(file.path, empty.getEventLog());
+    EventSegment seg(file.path);
+    EXPECT_EQ(seg.size(), 0u);
+    EXPECT_TRUE(Snapshot(seg, 100).getNodes().empty());
+}
+
+TEST(EventSegment, WriteReplacesTheFileWhole) {
+    TempPath file("replace");
+    Graph g;
+    g.addNode("A", {}, 1);
+    EventSegment::write(file.path, g.getEventLog());
+    EventSegment old(file.path);
+
+    // the mapped segment keeps the old file; the new one is complete
+    g.addNode("B", {}, 2);
+    EventSegment::write(file.path, g.getEventLog());
+    EXPECT_FALSE(fs::exists(file.path + ".tmp"));
+    EXPECT_EQ(old.size(), 1u);
+    EXPECT_EQ(EventSegment(file.path).size(), 2u);
+
+    // a failed write leaves the file as it was
+    const std::string missing = (fs::path(file.path) / "missing.seg").string();
+    EXPECT_THROW(EventSegment::write(missing, g.getEventLog()), std::runtime_error);
+    EXPECT_EQ(EventSegment(file.path).size(), 2u);
+}
@@ -0,0 +1,88 @@
+// tests/test_FilteredView.cpp
+
+#include <gtest/gtest.h>
+#include <chronograph/graph/Graph.h>
+#include <chronograph/graph/Snapshot.h>
+#include <chronograph/graph/CsrGraph.h>
+#include <chronograph/graph/FilteredView.h>
+#include <chronograph/graph/algorithms/Paths.h>
+#include <chronograph/graph/algorithms/Connectivity.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace chronograph;
+using namespace chronograph::graph::algorithms;
+
+namespace {
+// Accounts in two regions linked by transfer and message edges
+Graph makeLedger() {
+    Graph g;
+    g.addNode("a", {{"region","EU"}}, 1);
+    g.addNode("b", {{"region","EU"}}, 1);
+    g.addNode("c", {{"region","US"}}, 1);
+    g.addNode("d", {{"region","EU"}}, 1);
+    g.addEdge("t1", "a", "b", {{"type","transfer"}}, 2);
+    g.addEdge("m1", "b", "d", {{"type","message"}}, 3);
+    g.addEdge("t2", "b", "c", {{"type","transfer"}}, 4);
+    g.addEdge("t3", "c", "d", {{"type","transfer"}}, 5);
+    return g;
+}
+}  // namespace
+
+TEST(FilteredView, EdgePredicateRestrictsTraversal) {
+    Graph g = makeLedger();
+    FilteredView<Graph> transfers(g, {}, attributeEquals("type", "transfer"));
+
+    EXPECT_TRUE(isReachable(g, "a", "d"));
+    EXPECT_EQ(shortestPath(g, "a", "d"), (std::vector<std::string>{"a","b","d"}));
+
+    // without the message edge, d is only reachable through c
+    EXPECT_TRUE(isReachable(transfers, "a", "d"));
+    EXPECT_EQ(shortestPath(transfers, "a", "d"),
+              (std::vector<std::string>{"a","b","c","d"}));
+}
+
+TEST(FilteredView, NodePredicateHidesNodesAndIncidentEdges) {
+    Graph g = makeLedger();
+    FilteredView<Graph> eu(g, attributeEquals("region", "EU"));
+
+    EXPECT_EQ(GraphViewTraits<FilteredView<Graph>>::nodeCount(eu), 3u);
+    EXPECT_FALSE(isReachable(eu, "a", "c"));
+    EXPECT_FALSE(isReachable(eu, "c", "c"));
+    EXPECT_TRUE(isReachable(eu, "a", "d"));   // via the message edge
+
+    FilteredView<Graph> euTransfers(g, attributeEquals("region", "EU"),
+                                    attributeEquals("type", "transfer"));
+    auto comps = weaklyConnectedComponents(euTransfers);
+    for (auto& c : comps) std::sort(c.begin(), c.end());
+    std::sort(comps.begin(), comps.end());
+    EXPECT_EQ(comps, (std::vector<std::vector<std::string>>{{"a","b"},{"d"}}));
+}
+
+TEST(FilteredView, PrecomputedMatchesLazy) {
+    Graph g = makeLedger();
+    CsrGraph frozen(g);
+    Snapshot snap(g, 4);
+
+    FilteredView<Graph>    lazy(g, attributeEquals("region", "EU"));
+    FilteredView<Graph>    masked(g, attributeEquals("region", "EU"));
+    FilteredView<CsrGraph> dense(frozen, attributeEquals("region", "EU"));
+    FilteredView<Snapshot> atFour(snap, attributeEquals("region", "EU"));
+    masked.precompute();
+    dense.precompute();
+    atFour.precompute();
+    EXPECT_TRUE(masked.isPrecomputed());
+    EXPECT_FALSE(lazy.isPrecomputed());
+
+    for (auto s : {"a","b","c","d"}) {
+        for (auto t : {"a","b","c","d"}) {
+            bool expected = isReachable(lazy, s, t);
+            EXPECT_EQ(isReachable(masked, s, t), expected) << s << "->" << t;
+            EXPECT_EQ(isReachable(dense, s, t), expected) << s << "->" << t;
+        }
+    }
+    // at t=4 the c->d transfer does not exist yet
+    EXPECT_TRUE(isReachable(atFour, "a", "d"));
+    EXPECT_FALSE(hasCycle(dense));
+}
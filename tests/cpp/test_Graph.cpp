@@ -1,8 +1,10 @@
 // tests/test_Graph.cpp
 
 #include <chronograph/graph/Graph.h>
+#include <chronograph/graph/Snapshot.h>
 #include <gtest/gtest.h>
 #include <map>
+#include <stdexcept>
 #include <string>
 #include <cstdint>
 
@@ -204,4 +206,138 @@ TEST(GraphUpdateEdge, MergesAttributesAndEmitsEvent) {
     EXPECT_EQ(g.getOutgoing().at("n1")[0], "e1");
     ASSERT_EQ(g.getIncoming().at("n2").size(), 1u);
     EXPECT_EQ(g.getIncoming().at("n2")[0], "e1");
-}
\ No newline at end of file
+}
+namespace {
+// Compare live state field by field (Node/Edge have no operator==)
+void expectSameState(const Graph& a, const Graph& b) {
+    ASSERT_EQ(a.getNodes().size(), b.getNodes().size());
+    for (const auto& [id, n] : a.getNodes()) {
+        ASSERT_TRUE(b.getNodes().count(id)) << id;
+        EXPECT_EQ(n.attributes, b.getNodes().at(id).attributes) << id;
+    }
+    ASSERT_EQ(a.getEdges().size(), b.getEdges().size());
+    for (const auto& [id, e] : a.getEdges()) {
+        ASSERT_TRUE(b.getEdges().count(id)) << id;
+        const Edge& o = b.getEdges().at(id);
+        EXPECT_EQ(e.from, o.from);
+        EXPECT_EQ(e.to, o.to);
+        EXPECT_EQ(e.attributes, o.attributes);
+    }
+    EXPECT_EQ(a.getOutgoing(), b.getOutgoing());
+    EXPECT_EQ(a.getIncoming(), b.getIncoming());
+}
+}  // namespace
+
+TEST(GraphUndoJournal, RollbackRestoresEarlierState) {
+    Graph g;
+    EXPECT_FALSE(g.rollbackTo(0));   // journal disabled
+    g.enableUndoJournal();
+
+    g.addNode("a", {{"v","1"}}, 1);
+    g.addNode("b", {}, 2);
+    g.addNode("c", {}, 3);
+    g.addEdge("ab", "a", "b", {}, 4);
+    g.addEdge("bc", "b", "c", {}, 5);
+    const size_t mark = g.getEventLog().size();
+
+    Graph expected;
+    for (size_t i = 0; i < mark; ++i) expected.applyEvent(g.getEventLog()[i]);
+
+    g.updateNode("a", {{"v","2"}, {"w","x"}}, 6);
+    g.addEdge("ca", "c", "a", {}, 7);
+    g.delNode("b", 8);                 // cascades ab and bc
+    g.addEdge("ad", "a", "d", {}, 9);  // dangling endpoint d
+    g.updateEdge("ca", {{"k","v"}}, 10);
+    g.addNode("b", {{"again","1"}}, 11);
+
+    ASSERT_TRUE(g.rollbackTo(mark));
+    EXPECT_EQ(g.getEventLog().size(), mark);
+    expectSameState(g, expected);
+
+    // replayed events are journaled too
+    g.clearStateKeepLog();
+    EXPECT_FALSE(g.rollbackTo(0));   // the journal restarts at the wipe
+    for (const auto& e : g.getEventLog()) g.applyEvent(e);
+    Event del{"x", 12, EventType::DEL_NODE, "a", {}, "", ""};
+    g.addEvent(del);
+    g.applyEvent(del);
+    ASSERT_TRUE(g.rollbackTo(mark));
+    expectSameState(g, expected);
+}
+
+TEST(GraphUndoJournal, RestoresListPositionsAndTrims) {
+    Graph g;
+    g.enableUndoJournal();
+    g.addNode("hub", {}, 1);
+    for (int i = 0; i < 50; ++i) {
+        const std::string n = "n" + std::to_string(i);
+        g.addNode(n, {}, 2);
+        g.addEdge("out" + std::to_string(i), "hub", n, {}, 3);
+        g.addEdge("in" + std::to_string(i), n, "hub", {}, 3);
+    }
+    g.addEdge("loop", "hub", "hub", {}, 4);
+    // the same ID twice in one list, as a re-added edge leaves it
+    g.replayEvents(EventChunk(std::vector<Event>{
+        Event{"x", 5, EventType::ADD_EDGE, "out7", {}, "hub", "n7"}}));
+    const size_t mark = g.getEventLog().size();
+    Graph expected = g;
+
+    g.delEdge("out3", 6);
+    g.delNode("n9", 7);
+    g.delNode("hub", 8);
+    EXPECT_FALSE(g.getOutgoing().count("hub"));
+    ASSERT_TRUE(g.rollbackTo(mark));
+    expectSameState(g, expected);
+
+    g.delNode("hub", 9);
+    Graph copy = g.copyWithoutUndoJournal();
+    expectSameState(copy, g);
+    EXPECT_TRUE(copy.undoJournalEnabled());
+    EXPECT_FALSE(copy.rollbackTo(mark));
+
+    g.trimUndoJournal(mark);
+    EXPECT_FALSE(g.rollbackTo(mark - 1));
+    ASSERT_TRUE(g.rollbackTo(mark));
+    expectSameState(g, expected);
+}
+
+TEST(GraphCompaction, FoldsPrefixIntoBaseState) {
+    Graph g;
+    g.enableUndoJournal();
+    for (int i = 0; i < 12000; ++i) {
+        g.addNode("n" + std::to_string(i % 100), {{"v", std::to_string(i)}}, i);
+    }
+    g.addEdge("e", "n1", "n2", {}, 12000);
+    Graph full = g;
+    const auto before = g.getCheckpoints().size();
+
+    EXPECT_EQ(g.compact(7000), 7000u);
+    EXPECT_EQ(g.compactedEventCount(), 7000u);
+    EXPECT_EQ(g.compactionHorizon(), 6999);
+    EXPECT_EQ(g.getEventLog().size(), 5001u);
+    EXPECT_EQ(g.getEventLog().front().timestamp, 7000);
+    // the base plus the checkpoint at 10000, now at index 3000
+    ASSERT_EQ(g.getCheckpoints().size(), before);
+    EXPECT_EQ(g.getCheckpoints()[1].eventIndex, 3000u);
+    expectSameState(g, full);
+
+    for (std::int64_t t : {6999, 7000, 9999, 10500, 12000}) {
+        Snapshot a(g, t), b(full, t);
+        EXPECT_EQ(a.getNodes().size(), b.getNodes().size()) << t;
+        EXPECT_EQ(a.getNodes().at("n5").attributes, b.getNodes().at("n5").attributes) << t;
+    }
+    EXPECT_THROW(Snapshot(g, 6998), std::runtime_error);
+    EXPECT_THROW(g.diff(0, 8000), std::runtime_error);
+
+    // the journal still undoes the events after the horizon
+    EXPECT_TRUE(g.rollbackTo(100));
+    EXPECT_EQ(g.getNodes().at("n0").attributes.at("v"), "7000");
+
+    // compacting again keeps the older horizon folded in
+    g.compactEvents(g.getEventLog().size());
+    EXPECT_EQ(g.compactedEventCount(), 7100u);
+    EXPECT_EQ(g.getCheckpoints().size(), 1u);
+    EXPECT_TRUE(g.getEventLog().empty());
+    EXPECT_EQ(g.baseState().getNodes().size(), 100u);
+    EXPECT_THROW(g.compactEvents(1), std::invalid_argument);
+}
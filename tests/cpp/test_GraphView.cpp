@@ -0,0 +1,106 @@
+// tests/test_GraphView.cpp
+
+#include <gtest/gtest.h>
+#include <chronograph/graph/Graph.h>
+#include <chronograph/graph/Snapshot.h>
+#include <chronograph/graph/CsrGraph.h>
+#include <chronograph/graph/algorithms/Paths.h>
+#include <chronograph/graph/algorithms/Connectivity.h>
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace chronograph;
+using namespace chronograph::graph::algorithms;
+
+namespace {
+std::vector<std::vector<std::string>>
+normalize(std::vector<std::vector<std::string>> comps) {
+    for (auto& c : comps) std::sort(c.begin(), c.end());
+    std::sort(comps.begin(), comps.end());
+    return comps;
+}
+
+// A→B→C→A cycle, C→D, D→E, plus a late edge E→F at t=20
+Graph makeGraph() {
+    Graph g;
+    for (auto id : {"A","B","C","D","E","F"}) g.addNode(id, {}, 1);
+    g.addEdge("e1", "A", "B", {{"w","1"}}, 2);
+    g.addEdge("e2", "B", "C", {{"w","1"}}, 3);
+    g.addEdge("e3", "C", "A", {{"w","1"}}, 4);
+    g.addEdge("e4", "C", "D", {{"w","5"}}, 5);
+    g.addEdge("e5", "A", "D", {{"w","9"}}, 6);
+    g.addEdge("e6", "D", "E", {{"w","1"}}, 7);
+    g.addEdge("e7", "E", "F", {{"w","1"}}, 20);
+    return g;
+}
+}  // namespace
+
+TEST(GraphView, SnapshotRunsAlgorithmsDirectly) {
+    Graph g = makeGraph();
+    Snapshot before(g, 10);
+
+    EXPECT_TRUE(isReachable(before, "A", "E"));
+    EXPECT_FALSE(isReachable(before, "A", "F"));
+    EXPECT_EQ(shortestPath(before, "A", "E"),
+              (std::vector<std::string>{"A","D","E"}));
+    EXPECT_TRUE(hasCycle(before));
+    EXPECT_EQ(normalize(weaklyConnectedComponents(before)),
+              (std::vector<std::vector<std::string>>{{"A","B","C","D","E"},{"F"}}));
+}
+
+TEST(GraphView, CsrGraphMatchesGraph) {
+    Graph g = makeGraph();
+    CsrGraph frozen(g);
+
+    EXPECT_EQ(frozen.nodes().size(), g.getNodes().size());
+    EXPECT_EQ(frozen.edges().size(), g.getEdges().size());
+
+    for (auto s : {"A","B","C","D","E","F","Z"}) {
+        for (auto t : {"A","B","C","D","E","F","Z"}) {
+            EXPECT_EQ(isReachable(frozen, s, t), isReachable(g, s, t)) << s << "->" << t;
+            EXPECT_EQ(shortestPath(frozen, s, t), shortestPath(g, s, t)) << s << "->" << t;
+        }
+    }
+    EXPECT_EQ(normalize(stronglyConnectedComponents(frozen)),
+              normalize(stronglyConnectedComponents(g)));
+    EXPECT_EQ(normalize(weaklyConnectedComponents(frozen)),
+              normalize(weaklyConnectedComponents(g)));
+    EXPECT_EQ(hasCycle(frozen), hasCycle(g));
+    EXPECT_EQ(isTimeRespectingReachable(frozen, "A", "F"),
+              isTimeRespectingReachable(g, "A", "F"));
+}
+
+TEST(GraphView, CsrGraphFromSnapshotTopologicalSort) {
+    Graph g;
+    g.addNode("A", {}, 1);
+    g.addNode("B", {}, 1);
+    g.addNode("C", {}, 1);
+    g.addEdge("e1", "A", "B", {}, 2);
+    g.addEdge("e2", "B", "C", {}, 3);
+    g.addEdge("e3", "C", "A", {}, 4);   // closes a cycle later on
+
+    CsrGraph early(Snapshot(g, 3));
+    auto order = topologicalSort(early);
+    ASSERT_TRUE(order.has_value());
+    EXPECT_EQ(*order, (std::vector<std::string>{"A","B","C"}));
+
+    CsrGraph late(Snapshot(g, 4));
+    EXPECT_FALSE(topologicalSort(late).has_value());
+}
+
+TEST(GraphView, DijkstraPicksCheapestRouteOnEveryView) {
+    Graph g = makeGraph();
+    Snapshot snap(g, std::numeric_limits<std::int64_t>::max());
+    CsrGraph frozen(g);
+
+    const std::vector<std::string> expected = {"A","B","C","D","E"};
+    EXPECT_EQ(dijkstra(g, "A", "E", "w"), expected);
+    EXPECT_EQ(dijkstra(snap, "A", "E", "w"), expected);
+    EXPECT_EQ(dijkstra(frozen, "A", "E", "w"), expected);
+
+    EXPECT_EQ(dijkstra(g, "A", "A", "w"), (std::vector<std::string>{"A"}));
+    EXPECT_TRUE(dijkstra(g, "F", "A", "w").empty());
+    EXPECT_TRUE(dijkstra(g, "A", "E", "missing").empty());
+}
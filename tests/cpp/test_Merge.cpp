@@ -153,4 +153,174 @@ TEST(RepositoryMergeCommitParents, OnlyThreeWayGetsTwoParents) {
       EXPECT_TRUE(nodes.count("B"));
       EXPECT_TRUE(nodes.count("C"));
     }
-}
\ No newline at end of file
+}
+namespace {
+// main and dev both change X, Y, W and Z after the common ancestor
+Repository divergedRepo() {
+    auto repo = Repository::init("main");
+    repo.addNode("X", {{"a","0"},{"b","0"}}, 1);
+    repo.addNode("Y", {}, 1);
+    repo.addNode("W", {}, 1);
+    repo.commit("base");
+    repo.branch("dev");
+
+    repo.updateNode("X", {{"a","1"}}, 2);
+    repo.delNode("Y", 2);
+    repo.updateNode("W", {{"w","ours"}}, 2);
+    repo.addNode("Z", {{"k","ours"}}, 2);
+    repo.commit("ours");
+
+    repo.checkout("dev");
+    repo.updateNode("X", {{"a","2"},{"c","2"}}, 3);
+    repo.updateNode("Y", {{"v","1"}}, 3);
+    repo.delNode("W", 3);
+    repo.addNode("Z", {{"k","theirs"},{"m","1"}}, 3);
+    repo.addNode("N", {}, 3);
+    repo.commit("theirs");
+    repo.checkout("main");
+    return repo;
+}
+
+using Attrs = std::map<std::string, std::string>;
+Attrs attrsOf(const Repository& repo, const std::string& id) {
+    return repo.graph().getNodes().at(id).attributes;
+}
+}  // namespace
+
+TEST(Merge, ConflictPolicies) {
+    {
+        auto repo = divergedRepo();
+        auto r = repo.merge("dev", MergePolicy::OURS);
+        EXPECT_TRUE(r.conflicts.empty());
+        EXPECT_EQ(attrsOf(repo, "X"), (Attrs{{"a","1"},{"b","0"},{"c","2"}}));
+        EXPECT_FALSE(repo.graph().getNodes().count("Y"));
+        EXPECT_EQ(attrsOf(repo, "W"), (Attrs{{"w","ours"}}));
+        EXPECT_EQ(attrsOf(repo, "Z"), (Attrs{{"k","ours"}}));
+        EXPECT_TRUE(repo.graph().getNodes().count("N"));
+    }
+    {
+        auto repo = divergedRepo();
+        repo.merge("dev", MergePolicy::THEIRS);
+        EXPECT_EQ(attrsOf(repo, "X"), (Attrs{{"a","2"},{"b","0"},{"c","2"}}));
+        EXPECT_FALSE(repo.graph().getNodes().count("W"));
+        EXPECT_EQ(attrsOf(repo, "Z"), (Attrs{{"k","theirs"},{"m","1"}}));
+    }
+    {
+        // edges both sides added: theirs replaces ours in the adjacency lists
+        auto repo = Repository::init("main");
+        for (auto id : {"A","B","C"}) repo.addNode(id, {}, 1);
+        repo.commit("base");
+        repo.branch("dev");
+        repo.addEdge("E", "A", "B", {{"w","ours"}}, 2);
+        repo.addEdge("F", "A", "B", {{"w","ours"}}, 2);
+        repo.commit("ours");
+        repo.checkout("dev");
+        repo.addEdge("E", "A", "C", {{"w","theirs"}}, 3);
+        repo.addEdge("F", "A", "B", {{"v","1"}}, 3);
+        repo.commit("theirs");
+        repo.checkout("main");
+        repo.merge("dev", MergePolicy::THEIRS);
+
+        const Graph& g = repo.graph();
+        EXPECT_EQ(g.getEdges().at("E").to, "C");
+        EXPECT_EQ(g.getEdges().at("E").attributes, (Attrs{{"w","theirs"}}));
+        EXPECT_EQ(g.getEdges().at("F").attributes, (Attrs{{"v","1"},{"w","ours"}}));
+        EXPECT_EQ(g.getOutgoing().at("A"), (std::vector<std::string>{"F","E"}));
+        EXPECT_EQ(g.getIncoming().at("B"), std::vector<std::string>{"F"});
+        EXPECT_EQ(g.getIncoming().at("C"), std::vector<std::string>{"E"});
+    }
+    {
+        auto repo = divergedRepo();
+        repo.merge("dev", MergePolicy::ATTRIBUTE_UNION);
+        EXPECT_EQ(attrsOf(repo, "X"), (Attrs{{"a","1"},{"b","0"},{"c","2"}}));
+        EXPECT_EQ(attrsOf(repo, "W"), (Attrs{{"w","ours"}}));
+        EXPECT_EQ(attrsOf(repo, "Z"), (Attrs{{"k","ours"},{"m","1"}}));
+    }
+    {
+        auto repo = divergedRepo();
+        auto r = repo.merge("dev", MergePolicy::INTERACTIVE);
+        ASSERT_EQ(r.conflicts.size(), 4u);
+        EXPECT_EQ(r.conflicts[0].kind, Conflict::UPDATE_UPDATE);
+        EXPECT_EQ(r.conflicts[0].ours.payload.at("a"), "1");
+        EXPECT_EQ(r.conflicts[0].theirs.payload.at("a"), "2");
+        EXPECT_EQ(r.conflicts[1].kind, Conflict::DEL_UPDATE);
+        EXPECT_EQ(r.conflicts[1].ours.type, EventType::DEL_NODE);
+        EXPECT_EQ(r.conflicts[2].kind, Conflict::DEL_UPDATE);
+        EXPECT_EQ(r.conflicts[2].theirs.type, EventType::DEL_NODE);
+        EXPECT_EQ(r.conflicts[3].kind, Conflict::ADD_ADD);
+        // unresolved changes stay out; everything else is merged
+        EXPECT_EQ(attrsOf(repo, "X"), (Attrs{{"a","1"},{"b","0"},{"c","2"}}));
+        EXPECT_TRUE(repo.graph().getNodes().count("N"));
+    }
+    for (auto policy : {MergePolicy::INTERACTIVE, MergePolicy::THEIRS}) {
+        // theirs adds an edge to a node we deleted: it is left out
+        auto repo = Repository::init("main");
+        repo.addNode("X", {}, 1);
+        repo.addNode("Y", {}, 1);
+        repo.commit("base");
+        repo.branch("dev");
+        repo.delNode("Y", 2);
+        repo.commit("ours");
+        repo.checkout("dev");
+        repo.addEdge("E", "X", "Y", {}, 3);
+        repo.addEdge("G", "X", "X", {}, 3);
+        repo.commit("theirs");
+        repo.checkout("main");
+        auto r = repo.merge("dev", policy);
+
+        if (policy == MergePolicy::INTERACTIVE) {
+            ASSERT_EQ(r.conflicts.size(), 1u);
+            EXPECT_EQ(r.conflicts[0].kind, Conflict::DEL_UPDATE);
+            EXPECT_EQ(r.conflicts[0].ours.type, EventType::DEL_NODE);
+            EXPECT_EQ(r.conflicts[0].theirs.entityId, "E");
+        }
+        const Graph& g = repo.graph();
+        EXPECT_FALSE(g.getEdges().count("E"));
+        EXPECT_TRUE(g.getEdges().count("G"));
+        EXPECT_EQ(g.getOutgoing().at("X"), std::vector<std::string>{"G"});
+        EXPECT_FALSE(g.getIncoming().count("Y"));
+    }
+}
+
+TEST(Merge, PartitionedDeltasMatchSerial) {
+    // mixed adds, updates and deletes over a shared set of entities
+    auto makeDelta = [](const std::string& side, int seed) {
+        std::vector<Event> out;
+        for (int i = 0; i < 3000; ++i) {
+            int k = (i * 7 + seed) % 211;
+            Event e{side + std::to_string(i), i, EventType::UPDATE_NODE,
+                    "n" + std::to_string(k), {{"a", side + std::to_string(i % 5)}}, "", ""};
+            if (i % 11 == 0) e.type = EventType::ADD_NODE;
+            if (i % 13 == 0) { e.type = EventType::DEL_NODE; e.payload.clear(); }
+            if (i % 17 == 0) { e.type = EventType::ADD_EDGE; e.from = "n1"; e.to = "n2"; }
+            out.push_back(e);
+        }
+        return out;
+    };
+    std::vector<Event> oursEvents = makeDelta("o", 1), theirsEvents = makeDelta("t", 5);
+    std::vector<const Event*> ours, theirs;
+    for (const auto& e : oursEvents) ours.push_back(&e);
+    for (const auto& e : theirsEvents) theirs.push_back(&e);
+
+    auto run = [&](std::size_t threads) {
+        std::vector<std::string> applied;
+        auto conflicts = mergeDeltas(ours, theirs, MergePolicy::ATTRIBUTE_UNION, threads,
+            [&](const Event& e) {
+                std::string s = e.id + ":" + std::to_string(static_cast<int>(e.type));
+                for (const auto& [k, v] : e.payload) s += "," + k + "=" + v;
+                applied.push_back(s);
+            });
+        std::vector<std::string> found;
+        for (const auto& c : conflicts) {
+            found.push_back(std::to_string(c.kind) + c.ours.id + c.theirs.id);
+        }
+        return std::make_pair(applied, found);
+    };
+
+    auto serial = run(1);
+    EXPECT_FALSE(serial.second.empty());
+    EXPECT_LT(serial.first.size(), theirs.size());
+    for (std::size_t threads : {2u, 4u, 7u}) {
+        EXPECT_EQ(run(threads), serial) << threads << " threads";
+    }
+}
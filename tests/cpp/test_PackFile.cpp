@@ -0,0 +1,229 @@
+// tests/test_PackFile.cpp
+
+#include <chronograph/repo/PackFile.h>
+#include <chronograph/repo/Repository.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace chronograph;
+namespace fs = std::filesystem;
+
+namespace {
+// fresh directory in the temp directory, removed again at scope exit
+struct TempDir {
+    std::string path;
+    explicit TempDir(const std::string& name) {
+        auto seed = ::testing::UnitTest::GetInstance()->random_seed();
+        path = (fs::temp_directory_path() /
+                ("chronograph_" + name + "_" + std::to_string(seed) + ".pack")).string();
+        fs::remove_all(path);
+    }
+    ~TempDir() { fs::remove_all(path); }
+};
+
+Repository buildRepository() {
+    auto repo = Repository::init("main");
+    for (int i = 0; i < 20; ++i) {
+        repo.addNode("n" + std::to_string(i), {{"i", std::to_string(i)}}, i);
+        repo.commit("c" + std::to_string(i));
+    }
+    repo.branch("dev");
+    repo.checkout("dev");
+    repo.addEdge("e", "n1", "n2", {{"w","1"}}, 100);
+    repo.commit("edge");
+    repo.checkout("main");
+    repo.updateNode("n3", {{"x","y"}}, 101);
+    repo.commit("update");
+    repo.merge("dev");
+    return repo;
+}
+}  // namespace
+
+TEST(PackFile, RoundTripOpensLazily) {
+    TempDir dir("roundtrip");
+    Repository original = buildRepository();
+    original.writePack(dir.path);
+
+    {
+        PackFile pack(dir.path);
+        EXPECT_EQ(pack.head(), "main");
+        EXPECT_EQ(pack.branches().size(), 2u);
+        EXPECT_EQ(pack.commits().size(), original.getCommitGraph().commitIds.size());
+        EXPECT_EQ(pack.cachedCount(), 0u);
+        const Commit& edge = pack.commits()[pack.commits().size() - 3];
+        EXPECT_EQ(edge.message, "edge");
+        EXPECT_EQ(edge.eventCount, 1u);
+        EXPECT_EQ(pack.events(edge.id).front().entityId, "e");
+        EXPECT_EQ(pack.cachedCount(), 1u);
+    }
+
+    Repository repo = Repository::openPack(dir.path);
+    auto branches = repo.listBranches();
+    std::sort(branches.begin(), branches.end());
+    EXPECT_EQ(branches, (std::vector<std::string>{"dev","main"}));
+
+    // metadata needs no events
+    std::size_t walked = 0, events = 0, expected = 0;
+    for (const auto& info : repo.walkCommits("main")) {
+        EXPECT_TRUE(info.commit().events.empty());
+        events += info.eventCount();
+        ++walked;
+    }
+    for (const auto& c : original.listCommits("main")) expected += c.events.size();
+    EXPECT_EQ(walked, original.listCommits("main").size());
+    EXPECT_EQ(events, expected);
+    auto a = repo.listCommits("main"), b = original.listCommits("main");
+    ASSERT_EQ(a.size(), b.size());
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        EXPECT_EQ(a[i].id, b[i].id);
+        EXPECT_EQ(a[i].events.size(), b[i].events.size());
+        EXPECT_EQ(a[i].lastTimestamp, b[i].lastTimestamp);
+    }
+
+    // the working graph is built at HEAD on first use
+    EXPECT_EQ(repo.graph().getNodes().size(), original.graph().getNodes().size());
+    EXPECT_EQ(repo.graph().getEdges().size(), 1u);
+    EXPECT_EQ(repo.graph().getNodes().at("n3").attributes.at("x"), "y");
+    EXPECT_EQ(repo.graphAt(repo.listCommits("dev").back().id)->getEdges().size(), 1u);
+}
+
+TEST(PackFile, CheckoutBeforeFirstUseAndRewrite) {
+    TempDir dir("rewrite");
+    buildRepository().writePack(dir.path);
+
+    std::string c;
+    {
+        Repository repo = Repository::openPack(dir.path);
+        repo.checkout("dev");                 // nothing built yet
+        EXPECT_FALSE(repo.graph().getNodes().at("n3").attributes.count("x"));
+        repo.addNode("late", {}, 200);
+        c = repo.commit("late");
+        repo.checkout("main");
+        EXPECT_FALSE(repo.graph().getNodes().count("late"));
+        repo.checkout("dev");
+        repo.writePack(dir.path);             // replaces the pack it was opened from
+    }
+    Repository repo = Repository::openPack(dir.path);
+    EXPECT_EQ(repo.listCommits("dev").back().id, c);
+    EXPECT_TRUE(repo.graph().getNodes().count("late"));
+    EXPECT_EQ(repo.merge("main").conflicts.size(), 0u);
+    EXPECT_TRUE(repo.graph().getNodes().at("n3").attributes.count("x"));
+}
+
+TEST(PackFile, BoundedCacheAndChainPrefetch) {
+    TempDir dir("cache");
+    Repository original = buildRepository();
+    original.writePack(dir.path);
+
+    PackFile pack(dir.path);
+    std::vector<std::string> chain;
+    for (const auto& c : pack.commits()) {
+        if (c.message.size() >= 2 && c.message[0] == 'c') chain.push_back(c.id);
+    }
+    ASSERT_EQ(chain.size(), 20u);
+
+    // adjacent blocks of a chain are read together
+    auto chunks = pack.events(chain);
+    ASSERT_EQ(chunks.size(), chain.size());
+    EXPECT_EQ(chunks[7].front().entityId, "n7");
+    EXPECT_EQ(pack.readCount(), 1u);
+    EXPECT_EQ(pack.cachedCount(), chain.size());
+    pack.events(chain.back());
+    EXPECT_EQ(pack.readCount(), 1u);   // cached
+
+    // a small budget evicts the least recently used chunks
+    const std::size_t one = pack.cacheBytes() / chain.size();
+    pack.setCacheLimit(3 * one + one / 2);
+    EXPECT_LE(pack.cacheBytes(), pack.cacheLimit());
+    EXPECT_EQ(pack.cachedCount(), 3u);
+    EXPECT_EQ(pack.events(chain.front()).front().entityId, "n0");  // re-read
+    EXPECT_EQ(pack.readCount(), 2u);
+    EXPECT_EQ(pack.cachedCount(), 3u);
+
+    // the repository works within the same budget
+    Repository repo = Repository::openPack(dir.path);
+    repo.setEventCacheLimit(3 * one + one / 2);
+    repo.checkout("dev");
+    EXPECT_EQ(repo.graph().getNodes().size(), 20u);
+    auto commits = repo.listCommits("main");
+    EXPECT_EQ(commits.size(), original.listCommits("main").size());
+    EXPECT_EQ(commits[5].events.front().entityId, "n4");
+}
+
+TEST(PackFile, RejectsInconsistentPacks) {
+    TempDir dir("corrupt");
+    EXPECT_THROW(Repository::openPack(dir.path), std::runtime_error);   // missing
+    buildRepository().writePack(dir.path);
+
+    const std::string index = (fs::path(dir.path) / "index.1").string();
+    {
+        std::fstream f(index, std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(20);
+        f.put('\x7f');
+    }
+    EXPECT_THROW(Repository::openPack(dir.path), std::runtime_error);
+
+    buildRepository().writePack(dir.path);
+    {
+        std::ofstream refs((fs::path(dir.path) / "refs").string(), std::ios::app);
+        refs << "0123 ghost\n";
+    }
+    EXPECT_THROW(Repository::openPack(dir.path), std::runtime_error);
+}
+
+TEST(PackFile, WritesSwitchGenerationsThroughRefs) {
+    TempDir dir("generations");
+    Repository repo = buildRepository();
+    repo.writePack(dir.path);
+    // an interrupted write leaves files of the next generation behind
+    { std::ofstream(fs::path(dir.path) / "pack.2") << "torn"; }
+    { std::ofstream(fs::path(dir.path) / "index.2.tmp") << "torn"; }
+    EXPECT_EQ(Repository::openPack(dir.path).listBranches().size(), 2u);
+
+    repo.deleteBranch("dev");
+    repo.gc();
+    repo.writePack(dir.path);
+    std::vector<std::string> files;
+    for (const auto& entry : fs::directory_iterator(dir.path)) {
+        files.push_back(entry.path().filename().string());
+    }
+    std::sort(files.begin(), files.end());
+    EXPECT_EQ(files, (std::vector<std::string>{"index.2", "pack.2", "refs"}));
+    auto reopened = Repository::openPack(dir.path);
+    EXPECT_EQ(reopened.listBranches(), std::vector<std::string>{"main"});
+    EXPECT_EQ(reopened.graph().getNodes().size(), 20u);
+}
+
+TEST(PackFile, KeepsTheCompactionBase) {
+    TempDir dir("base");
+    auto repo = buildRepository();          // n0..n19 at 0..19, then 100, 101
+    const std::string base = repo.compact(10);
+    ASSERT_FALSE(base.empty());
+    repo.writePack(dir.path);
+
+    auto opened = Repository::openPack(dir.path);
+    EXPECT_EQ(opened.graph().compactedEventCount(), 10u);
+    EXPECT_EQ(opened.graph().getNodes().size(), 20u);
+    EXPECT_EQ(opened.graph().getNodes().at("n3").attributes.at("x"), "y");
+    EXPECT_EQ(opened.graph().getNodes().at("n5").attributes.at("i"), "5");   // from the base
+    EXPECT_EQ(opened.graph().getEdges().at("e").to, "n2");
+    EXPECT_EQ(opened.graphAt(base)->getNodes().size(), 10u);
+    const auto commits = opened.listCommits("main");
+    EXPECT_THROW(opened.graphAt(commits[1].id), std::runtime_error);
+    EXPECT_TRUE(commits[1].events.empty());
+    EXPECT_EQ(commits[1].eventCount, 1u);
+    EXPECT_EQ(commits[15].events.size(), 1u);
+
+    // the base stays across checkouts and a rewrite of the pack
+    opened.checkout("dev");
+    EXPECT_EQ(opened.graph().getNodes().size(), 20u);
+    opened.checkout("main");
+    opened.writePack(dir.path);
+    auto again = Repository::openPack(dir.path);
+    EXPECT_EQ(again.graph().getNodes().size(), 20u);
+    EXPECT_EQ(again.graph().getNodes().at("n5").attributes.at("i"), "5");
+    EXPECT_THROW(again.snapshotAt("main", 5), std::runtime_error);
+}
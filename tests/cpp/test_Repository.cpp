@@ -84,6 +84,41 @@ TEST(RepositoryListCommits, CommitSequence) {
     EXPECT_EQ(commits[2].id, c2);
 }
 
+TEST(RepositoryListCommits, LazyWalkNewestFirst) {
+    auto repo = Repository::init("main");
+    repo.addNode("a", {}, 5);
+    repo.addNode("b", {}, 3);
+    auto c1 = repo.commit("first");
+    repo.branch("dev");
+    repo.checkout("dev");
+    repo.addNode("d", {}, 7);
+    auto d1 = repo.commit("dev work");
+    repo.checkout("main");
+    repo.addNode("m", {}, 8);
+    auto m1 = repo.commit("main work");
+    auto merged = repo.merge("dev").mergeCommitId;
+
+    std::vector<std::string> ids;
+    for (const auto& info : repo.walkCommits("main")) ids.push_back(info.id());
+    ASSERT_EQ(ids.size(), 5u);
+    EXPECT_EQ(ids[0], merged);
+    EXPECT_EQ(ids[1], m1);   // same generation as d1, but newer
+    EXPECT_EQ(ids[2], d1);
+    EXPECT_EQ(ids[3], c1);
+
+    auto walk = repo.walkCommits(c1, /*limit=*/1);
+    auto first = walk.next();
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(first->message(), "first");
+    EXPECT_EQ(first->eventCount(), 2u);
+    EXPECT_EQ(first->firstTimestamp(), 3);
+    EXPECT_EQ(first->lastTimestamp(), 5);
+    EXPECT_EQ(first->parents().size(), 1u);
+    EXPECT_FALSE(walk.next().has_value());
+
+    EXPECT_THROW(repo.walkCommits("nope"), std::runtime_error);
+}
+
 
 TEST(RepositoryBranchIsolation, MultiBranchWithSnapshots) {
     auto repo = Repository::init("main");
@@ -336,4 +371,288 @@ TEST(RepositoryCommitGraph, ParentsAndChildren) {
   EXPECT_EQ(dag.children.at(c2), std::vector<std::string>{c4});
   EXPECT_EQ(dag.children.at(c3), std::vector<std::string>{c4});
   EXPECT_TRUE(dag.children.at(c4).empty());
-}
\ No newline at end of file
+}
+TEST(RepositoryGenerations, AncestryAndMergeGeneration) {
+  auto repo = Repository::init("main");
+  auto c0 = repo.listCommits("main").front().id;
+  repo.addNode("A", {}, 1);
+  auto c1 = repo.commit("A");
+
+  repo.branch("dev");
+  repo.checkout("dev");
+  repo.addNode("B", {}, 2);
+  auto c2 = repo.commit("B");
+  repo.addNode("C", {}, 3);
+  auto c3 = repo.commit("C");
+
+  repo.checkout("main");
+  repo.addNode("D", {}, 4);
+  auto c4 = repo.commit("D");
+  auto m = repo.merge("dev").mergeCommitId;
+
+  auto commits = repo.listCommits("main");
+  std::map<std::string, std::size_t> gen;
+  for (const auto& c : commits) gen[c.id] = c.generation;
+  EXPECT_EQ(gen[c0], 1u);
+  EXPECT_EQ(gen[c1], 2u);
+  EXPECT_EQ(gen[c4], 3u);
+  EXPECT_EQ(gen[c3], 4u);
+  EXPECT_EQ(gen[m],  5u);   // 1 + max(3, 4)
+
+  EXPECT_TRUE(repo.isAncestor(c1, m));
+  EXPECT_TRUE(repo.isAncestor(c2, m));
+  EXPECT_TRUE(repo.isAncestor(m, m));
+  EXPECT_FALSE(repo.isAncestor(c4, c3));
+  EXPECT_FALSE(repo.isAncestor(m, c1));
+  EXPECT_THROW(repo.isAncestor("nope", m), std::runtime_error);
+
+  // merging an ancestor is a no-op
+  EXPECT_EQ(repo.merge("dev").mergeCommitId, m);
+
+  // dev reaches the merge only through its second parent
+  repo.checkout("dev");
+  EXPECT_EQ(repo.merge("main").mergeCommitId, m);
+  EXPECT_EQ(repo.graph().getNodes().size(), 4u);
+  // each event replayed once: first-parent chain of m is c0, c1, c4, m
+  EXPECT_EQ(repo.graph().getEventLog().size(), 4u);
+}
+
+TEST(RepositoryGenerations, DeepHistoryDoesNotRecurse) {
+  auto repo = Repository::init("main");
+  const int depth = 100000;
+  for (int i = 0; i < depth; ++i) {
+    repo.addNode("n" + std::to_string(i), {}, i);
+    repo.commit();
+  }
+  auto commits = repo.listCommits("main");
+  ASSERT_EQ(commits.size(), static_cast<size_t>(depth + 1));
+  EXPECT_EQ(commits.back().generation, static_cast<size_t>(depth + 1));
+  EXPECT_TRUE(repo.isAncestor(commits.front().id, commits.back().id));
+  EXPECT_FALSE(repo.isAncestor(commits.back().id, commits.front().id));
+}
+
+TEST(RepositoryMergeBase, TwoColouredWalkAndBitmaps) {
+  for (bool bitmaps : {false, true}) {
+    auto repo = Repository::init("main");
+    if (bitmaps) repo.enableReachabilityBitmaps();
+    repo.addNode("A", {}, 1);
+    auto c1 = repo.commit("A");
+
+    repo.branch("dev");
+    repo.checkout("dev");
+    repo.addNode("B", {}, 2);
+    auto c2 = repo.commit("B");
+
+    repo.checkout("main");
+    repo.addNode("C", {}, 3);
+    auto c3 = repo.commit("C");
+    repo.addNode("D", {}, 4);
+    auto c4 = repo.commit("D");
+
+    EXPECT_EQ(repo.mergeBase(c4, c2), c1);
+    EXPECT_EQ(repo.mergeBase(c2, c4), c1);
+    EXPECT_EQ(repo.mergeBase(c3, c4), c3);
+    EXPECT_EQ(repo.mergeBase(c4, c4), c4);
+    EXPECT_THROW(repo.mergeBase(c4, "nope"), std::runtime_error);
+
+    // after dev is merged into main, main contains dev's tip
+    auto m = repo.merge("dev").mergeCommitId;
+    EXPECT_EQ(repo.mergeBase(m, c2), c2);
+    EXPECT_TRUE(repo.isAncestor(c2, m));
+    EXPECT_FALSE(repo.isAncestor(c3, c2));
+
+    // dev continues; the new base is the old dev tip
+    repo.checkout("dev");
+    repo.addNode("E", {}, 5);
+    auto c5 = repo.commit("E");
+    EXPECT_EQ(repo.mergeBase(m, c5), c2);
+    EXPECT_EQ(repo.reachabilityBitmapsEnabled(), bitmaps);
+
+    repo.checkout("main");
+    repo.merge("dev");
+    EXPECT_EQ(repo.graph().getNodes().size(), 5u);
+  }
+}
+
+TEST(RepositoryCheckout, SiblingSwitchRevertsToMergeBase) {
+  auto repo = Repository::init("main");
+  repo.addNode("A", {{"v","1"}}, 1);
+  repo.addNode("B", {}, 1);
+  repo.addEdge("AB", "A", "B", {}, 1);
+  repo.commit("base");
+
+  repo.branch("left");
+  repo.branch("right");
+
+  repo.checkout("left");
+  repo.updateNode("A", {{"v","left"}}, 2);
+  repo.delNode("B", 3);
+  repo.commit("left 1");
+  repo.addNode("L", {}, 4);
+  repo.commit("left 2");
+
+  repo.checkout("right");
+  // right still sees the base state
+  EXPECT_EQ(repo.graph().getNodes().at("A").attributes.at("v"), "1");
+  EXPECT_TRUE(repo.graph().getEdges().count("AB"));
+  EXPECT_EQ(repo.graph().getEventLog().size(), 3u);
+
+  repo.addEdge("BA", "B", "A", {}, 5);
+  repo.commit("right 1");
+
+  repo.checkout("left");
+  {
+    const auto& g = repo.graph();
+    EXPECT_EQ(g.getNodes().size(), 2u);
+    EXPECT_EQ(g.getNodes().at("A").attributes.at("v"), "left");
+    EXPECT_TRUE(g.getNodes().count("L"));
+    EXPECT_TRUE(g.getEdges().empty());
+    EXPECT_TRUE(g.getIncoming().at("A").empty());
+    EXPECT_EQ(g.getEventLog().size(), 3u + 4u);  // base + left (delNode cascades to AB)
+  }
+
+  repo.checkout("right");
+  {
+    const auto& g = repo.graph();
+    EXPECT_EQ(g.getNodes().size(), 2u);
+    EXPECT_EQ(g.getEdges().size(), 2u);
+    EXPECT_EQ(g.getOutgoing().at("B"), std::vector<std::string>{"BA"});
+    EXPECT_EQ(g.getIncoming().at("B"), std::vector<std::string>{"AB"});
+  }
+}
+
+TEST(RepositoryCheckout, DivergenceBeyondTheUndoJournalRebuilds) {
+  auto repo = Repository::init("main");
+  repo.addNode("A", {}, 1);
+  repo.commit("base");
+  repo.branch("old");
+  // more commits than the working graph keeps undo records for
+  for (int i = 0; i < 100; ++i) {
+    repo.addNode("n" + std::to_string(i), {}, i + 2);
+    repo.addEdge("e" + std::to_string(i), "A", "n" + std::to_string(i), {}, i + 2);
+    repo.commit("c" + std::to_string(i));
+  }
+  EXPECT_FALSE(Graph(repo.graph()).rollbackTo(2));
+
+  repo.checkout("old");
+  EXPECT_EQ(repo.graph().getNodes().size(), 1u);
+  EXPECT_TRUE(repo.graph().getOutgoing().at("A").empty());
+  repo.checkout("main");
+  EXPECT_EQ(repo.graph().getNodes().size(), 101u);
+  EXPECT_EQ(repo.graph().getOutgoing().at("A").size(), 100u);
+}
+
+TEST(RepositoryColdCommits, CompressedEventsLoadOnDemand) {
+  auto repo = Repository::init("main");
+  for (int c = 0; c < 5; ++c) {
+    for (int i = 0; i < 200; ++i) {
+      repo.addNode("n" + std::to_string(c * 200 + i),
+                   {{"status","active"},{"owner","team-" + std::to_string(i % 4)}}, c * 200 + i);
+    }
+    repo.commit("c" + std::to_string(c));
+  }
+  repo.branch("side");
+  repo.checkout("side");
+  repo.addNode("s", {}, 2000);
+  repo.commit("side");
+  auto before = repo.listCommits("main");
+
+  // main's commits are still in side's working log: nothing is cold yet
+  EXPECT_EQ(repo.compressColdCommits(), 0u);
+
+  // a graph built from scratch elsewhere leaves them to their commits only
+  repo.checkout("main");
+  repo.delNode("n0", 3000);
+  repo.commit("drop n0");
+  repo.checkout("side");
+  EXPECT_GT(repo.compressColdCommits(), 0u);   // "drop n0" is cold now
+
+  auto after = repo.listCommits("main");
+  ASSERT_EQ(after.size(), before.size() + 1);
+  EXPECT_EQ(after.back().events.size(), 1u);
+  EXPECT_EQ(after.back().eventCount, 1u);
+  repo.checkout("main");
+  EXPECT_FALSE(repo.graph().getNodes().count("n0"));
+  EXPECT_EQ(repo.graph().getNodes().size(), 999u);
+  EXPECT_EQ(repo.graphAt(after.back().id)->getNodes().size(), 999u);
+}
+
+TEST(RepositoryCompaction, FoldsCommonHistoryIntoBaseState) {
+  auto repo = Repository::init("main");
+  std::vector<std::string> ids;
+  for (int c = 0; c < 4; ++c) {
+    for (int i = 0; i < 50; ++i) {
+      repo.addNode("n" + std::to_string(c * 50 + i), {{"c", std::to_string(c)}}, c * 100 + i);
+    }
+    ids.push_back(repo.commit("c" + std::to_string(c)));
+  }
+  repo.branch("dev");            // at c3
+  repo.checkout("dev");
+  repo.addNode("d", {}, 500);
+  repo.commit("dev");
+  repo.checkout("main");
+  repo.addNode("m", {}, 600);
+  repo.commit("main");
+  repo.addNode("staged", {}, 700);
+
+  // c0..c2 end before 250; c3 does not, so c2 is the base
+  EXPECT_EQ(repo.compact(250), ids[2]);
+  EXPECT_EQ(repo.graph().compactedEventCount(), 150u);
+  EXPECT_EQ(repo.graph().getNodes().size(), 202u);
+  EXPECT_THROW(repo.graphAt(ids[1]), std::runtime_error);
+  EXPECT_EQ(repo.graphAt(ids[2])->getNodes().size(), 150u);
+  EXPECT_THROW(repo.snapshotAt("main", 100), std::runtime_error);
+  EXPECT_EQ(repo.snapshotAt("main", 320)->getNodes().size(), 171u);
+  EXPECT_TRUE(repo.listCommits("main")[1].events.empty());
+
+  // the staged event commits on top; branches still switch and merge
+  repo.commit("staged");
+  repo.checkout("dev");
+  EXPECT_EQ(repo.graph().getNodes().size(), 201u);
+  EXPECT_FALSE(repo.graph().getNodes().count("m"));
+  repo.checkout("main");
+  repo.merge("dev");
+  EXPECT_EQ(repo.graph().getNodes().size(), 203u);
+
+  // the dev branch pins c3; a later horizon cannot pass it
+  EXPECT_EQ(repo.compact(1000), ids[3]);
+  EXPECT_EQ(repo.graph().compactedEventCount(), 200u);
+  EXPECT_EQ(repo.graphAt(ids[3])->getNodes().size(), 200u);
+  EXPECT_EQ(repo.graph().getNodes().size(), 203u);
+}
+
+TEST(RepositoryGc, DeletedBranchesAreCollected) {
+  auto repo = Repository::init("main");
+  repo.enableReachabilityBitmaps();
+  repo.setStateCacheLimit(64 << 20);
+  repo.addNode("A", {}, 1);
+  const std::string base = repo.commit("base");
+
+  repo.branch("experiment");
+  repo.checkout("experiment");
+  std::vector<std::string> dead;
+  for (int c = 0; c < 3; ++c) {
+    for (int i = 0; i < 100; ++i) repo.addNode("x" + std::to_string(c * 100 + i), {}, 10 + i);
+    dead.push_back(repo.commit("x" + std::to_string(c)));
+  }
+  repo.checkout("main");          // caches experiment's state
+  EXPECT_THROW(repo.deleteBranch("main"), std::runtime_error);
+  EXPECT_THROW(repo.deleteBranch("nope"), std::runtime_error);
+  EXPECT_EQ(repo.gc().commits, 0u);
+
+  repo.deleteBranch("experiment");
+  EXPECT_EQ(repo.listBranches(), std::vector<std::string>{"main"});
+  auto freed = repo.gc();
+  EXPECT_EQ(freed.commits, 3u);
+  EXPECT_EQ(freed.cachedStates, 1u);
+  EXPECT_GT(freed.bytes, 2 * 300 * sizeof(Event));   // the events and the cached state
+  EXPECT_THROW(repo.graphAt(dead.back()), std::runtime_error);
+  EXPECT_EQ(repo.getCommitGraph().commitIds.size(), 2u);
+
+  // the surviving history is unchanged and keeps growing
+  repo.addNode("B", {}, 2);
+  const std::string next = repo.commit("next");
+  EXPECT_TRUE(repo.isAncestor(base, next));
+  EXPECT_EQ(repo.walkCommits("main").begin()->id(), next);
+  EXPECT_EQ(repo.graph().getNodes().size(), 2u);
+}
@@ -0,0 +1,105 @@
+// tests/test_ShardedGraph.cpp
+
+#include <chronograph/graph/ShardedGraph.h>
+#include <chronograph/graph/Graph.h>
+#include <chronograph/graph/Snapshot.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace chronograph;
+
+namespace {
+// the same operations on a plain graph and a sharded one
+template <class G>
+void buildRing(G& g) {
+    for (int i = 0; i < 40; ++i) g.addNode("n" + std::to_string(i), {{"i", std::to_string(i)}}, i);
+    for (int i = 0; i < 40; ++i) {
+        g.addEdge("e" + std::to_string(i), "n" + std::to_string(i),
+                  "n" + std::to_string((i + 1) % 40), {}, 100 + i);
+    }
+    g.updateNode("n3", {{"x","y"}}, 200);
+    g.updateEdge("e7", {{"w","2"}}, 201);
+    g.delEdge("e9", 202);
+    g.delNode("n20", 203);   // cascades e19 (remote source) and e20
+}
+
+template <class A, class B>
+void expectSameGraph(const A& a, const B& b) {
+    ASSERT_EQ(a.getNodes().size(), b.getNodes().size());
+    for (const auto& [id, node] : b.getNodes()) {
+        ASSERT_TRUE(a.getNodes().count(id)) << id;
+        EXPECT_EQ(a.getNodes().at(id).attributes, node.attributes) << id;
+        auto sorted = [](std::vector<std::string> v) { std::sort(v.begin(), v.end()); return v; };
+        auto adj = [&](const auto& m) {
+            auto it = m.find(id);
+            return it == m.end() ? std::vector<std::string>{} : sorted(it->second);
+        };
+        EXPECT_EQ(adj(a.getOutgoing()), adj(b.getOutgoing())) << id;
+        EXPECT_EQ(adj(a.getIncoming()), adj(b.getIncoming())) << id;
+    }
+    ASSERT_EQ(a.getEdges().size(), b.getEdges().size());
+    for (const auto& [id, edge] : b.getEdges()) {
+        ASSERT_TRUE(a.getEdges().count(id)) << id;
+        EXPECT_EQ(a.getEdges().at(id).attributes, edge.attributes) << id;
+    }
+}
+}  // namespace
+
+TEST(ShardedGraph, MatchesPlainGraph) {
+    Graph plain;
+    ShardedGraph sharded(4);
+    buildRing(plain);
+    buildRing(sharded);
+
+    // edges live with their source node
+    EXPECT_EQ(sharded.snapshotShard(sharded.shardOf("n5"), 1000).getEdges().count("e5"), 1u);
+
+    EXPECT_EQ(sharded.eventCount(), plain.getEventLog().size());
+    Graph merged = sharded.merged();
+    expectSameGraph(merged, plain);
+    EXPECT_FALSE(merged.getEdges().count("e19"));
+
+    for (std::int64_t t : {10, 120, 201, 202, 1000}) {
+        Snapshot expected(plain, t);
+        expectSameGraph(Snapshot(sharded, t), expected);
+        expectSameGraph(Snapshot(sharded, t, 1), expected);
+    }
+}
+
+TEST(ShardedGraph, ConcurrentProducersKeepTheirOrder) {
+    ShardedGraph g(8);
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 2000;
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kThreads; ++t) {
+        producers.emplace_back([&g, t] {
+            const std::string p = "t" + std::to_string(t) + "-";
+            for (int i = 0; i < kPerThread; ++i) {
+                g.addNode(p + std::to_string(i), {}, i);
+                if (i > 0) {
+                    g.addEdge(p + "e" + std::to_string(i), p + std::to_string(i - 1),
+                              p + std::to_string(i), {}, i);
+                }
+            }
+        });
+    }
+    for (auto& t : producers) t.join();
+
+    const auto events = g.events();
+    ASSERT_EQ(events.size(), static_cast<std::size_t>(kThreads * (2 * kPerThread - 1)));
+    // every producer's events come out in the order it made them
+    std::vector<int> last(kThreads, -1);
+    for (const auto& e : events) {
+        if (e.type != EventType::ADD_NODE) continue;
+        const int t = e.entityId[1] - '0';
+        const int i = std::stoi(e.entityId.substr(3));
+        EXPECT_EQ(i, last[t] + 1) << e.entityId;
+        last[t] = i;
+    }
+    Graph merged = g.merged();
+    EXPECT_EQ(merged.getNodes().size(), static_cast<std::size_t>(kThreads * kPerThread));
+    EXPECT_EQ(merged.getEdges().size(), static_cast<std::size_t>(kThreads * (kPerThread - 1)));
+}
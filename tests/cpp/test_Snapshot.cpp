@@ -1,11 +1,15 @@
 // tests/test_Snapshot.cpp
 
+#include <chronograph/graph/EventLog.h>
 #include <chronograph/graph/Graph.h>
 #include <chronograph/graph/Snapshot.h>
 #include <gtest/gtest.h>
 #include <map>
 #include <string>
 #include <cstdint>
+#include <random>
+#include <tuple>
+#include <vector>
 
 using namespace chronograph;
 
@@ -135,4 +139,87 @@ TEST(SnapshotEdgeUpdate, AttributesMergeCorrectly) {
     EXPECT_EQ(eNew.attributes.at("weight"), "15");    // updated
     EXPECT_EQ(eNew.attributes.at("type"),   "orig");  // still there
     EXPECT_EQ(eNew.attributes.at("label"),  "active");// new attr
-}
\ No newline at end of file
+}
+TEST(SnapshotParallel, MatchesSequentialReplay) {
+    // random mutations; the last two thirds are replayed raw, so their DEL_NODEs
+    // carry no DEL_EDGE events and the cascades are left to the snapshot
+    std::mt19937 rng(7);
+    auto pick = [&](std::size_t n) { return static_cast<std::size_t>(rng() % n); };
+    auto node = [&] { return "n" + std::to_string(pick(3000)); };
+    std::vector<std::pair<std::string, std::string>> endpoints;   // of edge "e<i>"
+    auto edge = [&] { return pick(endpoints.size() + 1); };
+    auto attrs = [&] { return std::map<std::string, std::string>{{"v", std::to_string(rng() % 100)}}; };
+
+    Graph g;
+    std::vector<Event> raw;
+    const std::size_t kEvents = Snapshot::kParallelMinEvents * 3;
+    for (std::int64_t ts = 0; g.getEventLog().size() + raw.size() < kEvents; ++ts) {
+        const auto op = pick(100);
+        Event e{"ev" + std::to_string(ts), ts, EventType::ADD_NODE, node(), {}, "", ""};
+        if (op < 30) {
+            e.payload = attrs();
+        } else if (op < 65) {
+            const std::string id = "e" + std::to_string(endpoints.size());
+            endpoints.emplace_back(node(), node());
+            e = Event{e.id, ts, EventType::ADD_EDGE, id, attrs(), endpoints.back().first,
+                      endpoints.back().second};
+        } else if (op < 72) {
+            e.type = EventType::DEL_NODE;
+        } else if (op < 80 && !endpoints.empty()) {
+            const std::size_t i = edge() % endpoints.size();
+            e = Event{e.id, ts, EventType::DEL_EDGE, "e" + std::to_string(i), {},
+                      endpoints[i].first, endpoints[i].second};
+        } else if (op < 90) {
+            e = Event{e.id, ts, EventType::UPDATE_NODE, e.entityId, attrs(), "", ""};
+        } else {
+            e = Event{e.id, ts, EventType::UPDATE_EDGE, "e" + std::to_string(edge()), attrs(), "", ""};
+        }
+        if (g.getEventLog().size() < kEvents / 3) {
+            switch (e.type) {
+              case EventType::ADD_NODE:    g.addNode(e.entityId, e.payload, ts); break;
+              case EventType::DEL_NODE:    g.delNode(e.entityId, ts); break;
+              case EventType::ADD_EDGE:    g.addEdge(e.entityId, e.from, e.to, e.payload, ts); break;
+              case EventType::DEL_EDGE:    g.delEdge(e.entityId, ts); break;
+              case EventType::UPDATE_NODE: g.updateNode(e.entityId, e.payload, ts); break;
+              case EventType::UPDATE_EDGE: g.updateEdge(e.entityId, e.payload, ts); break;
+            }
+        } else {
+            raw.push_back(std::move(e));
+        }
+    }
+    g.replayEvents(EventChunk(std::move(raw)));
+    ASSERT_FALSE(g.getCheckpoints().empty());
+
+    // an edge re-added under its ID stays in its first source's list, and
+    // deleting that node still removes it: the last snapshot takes the
+    // sequential path
+    const std::int64_t middle = (g.getEventLog().begin() + kEvents * 5 / 6)->timestamp;
+    const std::int64_t last = g.getEventLog().back().timestamp;
+    g.replayEvents(EventChunk(std::vector<Event>{
+        Event{"x1", last + 1, EventType::ADD_EDGE, "again", {}, "n0", "n1"},
+        Event{"x2", last + 1, EventType::ADD_EDGE, "again", {}, "n2", "n3"},
+        Event{"x3", last + 1, EventType::DEL_NODE, "n0", {}, "", ""}}));
+    EXPECT_FALSE(Snapshot(g, last + 1, 4).getEdges().count("again"));
+    for (std::int64_t t : {middle, last, last + 1}) {
+        Snapshot expected(g, t);
+        for (std::size_t threads : {4u, 1u}) {
+            Snapshot s(g, t, threads);
+            ASSERT_EQ(s.getNodes().size(), expected.getNodes().size());
+            for (const auto& [id, n] : expected.getNodes()) {
+                ASSERT_TRUE(s.getNodes().count(id)) << id;
+                EXPECT_EQ(s.getNodes().at(id).attributes, n.attributes) << id;
+            }
+            ASSERT_EQ(s.getEdges().size(), expected.getEdges().size());
+            for (const auto& [id, e] : expected.getEdges()) {
+                ASSERT_TRUE(s.getEdges().count(id)) << id;
+                const Edge& got = s.getEdges().at(id);
+                EXPECT_EQ(std::tie(got.from, got.to, got.attributes, got.createdTimestamp),
+                          std::tie(e.from, e.to, e.attributes, e.createdTimestamp)) << id;
+            }
+            for (const auto& [id, n] : expected.getNodes()) {
+                EXPECT_EQ(s.getOutgoing().at(id), expected.getOutgoing().at(id)) << id;
+                EXPECT_EQ(s.getIncoming().at(id), expected.getIncoming().at(id)) << id;
+            }
+        }
+    }
+}
@@ -0,0 +1,155 @@
+// tests/test_StateCache.cpp
+
+#include <chronograph/repo/Repository.h>
+#include <chronograph/repo/StateCache.h>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace chronograph;
+
+TEST(StateCache, EvictsByBytes) {
+    auto small = std::make_shared<Graph>();
+    small->addNode("a", {}, 1);
+    const std::size_t one = StateCache::estimateBytes(*small);
+    ASSERT_GT(one, 0u);
+
+    StateCache cache(2 * one);
+    cache.put("c1", small);
+    cache.put("c2", small);
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_EQ(cache.bytes(), 2 * one);
+
+    EXPECT_TRUE(cache.get("c1"));      // c1 is now most recently used
+    cache.put("c3", small);            // evicts c2
+    EXPECT_TRUE(cache.contains("c1"));
+    EXPECT_FALSE(cache.contains("c2"));
+    EXPECT_TRUE(cache.contains("c3"));
+    EXPECT_EQ(cache.get("c2"), nullptr);
+
+    // a state larger than the whole budget is never stored
+    auto big = std::make_shared<Graph>();
+    for (int i = 0; i < 50; ++i) big->addNode("n" + std::to_string(i), {}, i);
+    cache.put("big", big);
+    EXPECT_FALSE(cache.contains("big"));
+
+    cache.setLimit(one);
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_TRUE(cache.contains("c3"));
+    cache.setLimit(0);
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_EQ(cache.bytes(), 0u);
+}
+
+TEST(StateCache, CheckoutRestoresCachedBranchStates) {
+    auto repo = Repository::init("main");
+    repo.setStateCacheLimit(1 << 20);
+    repo.addNode("base", {}, 1);
+    repo.commit("base");
+
+    repo.branch("a");
+    repo.branch("b");
+    repo.checkout("a");
+    repo.addNode("onlyA", {{"k","a"}}, 2);
+    auto ca = repo.commit("a");
+
+    repo.checkout("b");   // leaves a: cached
+    EXPECT_TRUE(repo.stateCache().contains(ca));
+    repo.addNode("onlyB", {}, 3);
+    auto cb = repo.commit("b");
+
+    for (int flip = 0; flip < 3; ++flip) {
+        repo.checkout("a");
+        EXPECT_TRUE(repo.stateCache().contains(cb));
+        EXPECT_TRUE(repo.graph().getNodes().count("onlyA"));
+        EXPECT_FALSE(repo.graph().getNodes().count("onlyB"));
+        EXPECT_EQ(repo.graph().getEventLog().size(), 2u);
+
+        repo.checkout("b");
+        EXPECT_TRUE(repo.graph().getNodes().count("onlyB"));
+        EXPECT_FALSE(repo.graph().getNodes().count("onlyA"));
+    }
+
+    // states with uncommitted changes are not cached ...
+    repo.branch("y");
+    repo.checkout("y");
+    repo.addNode("onlyY", {}, 4);
+    auto cy = repo.commit("y");
+    repo.addNode("staged", {}, 5);
+    repo.checkout("a");
+    EXPECT_FALSE(repo.stateCache().contains(cy));
+
+    // ... so y starts from its cached parent (b) and replays only cy
+    repo.checkout("y");
+    EXPECT_TRUE(repo.graph().getNodes().count("onlyY"));
+    EXPECT_TRUE(repo.graph().getNodes().count("onlyB"));
+    EXPECT_FALSE(repo.graph().getNodes().count("staged"));
+    EXPECT_EQ(repo.graph().getEventLog().size(), 3u);
+    repo.checkout("a");
+
+    // committing on top of a restored state still works
+    repo.addNode("more", {}, 6);
+    repo.commit("more");
+    EXPECT_EQ(repo.graph().getNodes().size(), 3u);
+    EXPECT_EQ(repo.listCommits("a").size(), 4u);
+}
+
+TEST(RepositoryReadAccess, GraphAtAndSnapshotAtWithoutCheckout) {
+    auto repo = Repository::init("main");
+    repo.setStateCacheLimit(1 << 20);
+    repo.addNode("a", {}, 10);
+    auto c1 = repo.commit("a");
+    repo.branch("dev");
+    repo.addNode("b", {}, 20);
+    auto c2 = repo.commit("b");
+
+    auto g1 = repo.graphAt(c1);
+    auto g2 = repo.graphAt(c2);
+    EXPECT_EQ(g1->getNodes().size(), 1u);
+    EXPECT_EQ(g2->getNodes().size(), 2u);
+    EXPECT_EQ(repo.graphAt(c2), g2);          // served from the cache
+    EXPECT_THROW(repo.graphAt("nope"), std::runtime_error);
+
+    // HEAD and the working tree are untouched
+    EXPECT_EQ(repo.graph().getNodes().size(), 2u);
+    repo.addNode("staged", {}, 30);
+    EXPECT_EQ(repo.graphAt(c2)->getNodes().size(), 2u);
+
+    auto early = repo.snapshotAt("main", 15);
+    EXPECT_EQ(early->getNodes().size(), 1u);
+    EXPECT_EQ(repo.snapshotAt("dev", 100)->getNodes().size(), 1u);
+    EXPECT_THROW(repo.snapshotAt("nope", 0), std::runtime_error);
+}
+
+TEST(RepositoryReadAccess, ConcurrentReadersDuringIngest) {
+    auto repo = Repository::init("main");
+    repo.setStateCacheLimit(1 << 22);
+    std::vector<std::string> ids;
+    for (int i = 0; i < 20; ++i) {
+        repo.addNode("n" + std::to_string(i), {}, i);
+        ids.push_back(repo.commit());
+    }
+
+    std::atomic<bool> ok{true};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&, t] {
+            for (int round = 0; round < 50; ++round) {
+                size_t k = (t * 7 + round) % ids.size();
+                if (repo.graphAt(ids[k])->getNodes().size() != k + 1) ok = false;
+            }
+        });
+    }
+    // the working tree keeps ingesting meanwhile
+    for (int i = 20; i < 60; ++i) {
+        repo.addNode("n" + std::to_string(i), {}, i);
+        repo.commit();
+    }
+    for (auto& th : readers) th.join();
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(repo.graph().getNodes().size(), 60u);
+}
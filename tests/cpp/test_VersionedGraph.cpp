@@ -0,0 +1,125 @@
+// tests/test_VersionedGraph.cpp
+
+#include <chronograph/graph/VersionedGraph.h>
+#include <chronograph/graph/WriteAheadLog.h>
+#include <chronograph/graph/algorithms/Connectivity.h>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace chronograph;
+
+TEST(VersionedGraph, ReadersSeeOnlyPublishedVersions) {
+    VersionedGraph vg;
+    vg.addNode("A", {}, 1);
+    vg.addNode("B", {}, 2);
+    EXPECT_TRUE(vg.current()->getNodes().empty());
+    EXPECT_EQ(vg.pendingEvents(), 2u);
+
+    vg.publish();
+    auto v1 = vg.current();
+    EXPECT_EQ(v1->getNodes().size(), 2u);
+    EXPECT_EQ(vg.publishCount(), 1u);
+
+    // v1 is held: publishing again cannot recycle it and copies instead
+    vg.addEdge("AB", "A", "B", {}, 3);
+    vg.publish();
+    EXPECT_EQ(vg.copyCount(), 1u);
+    EXPECT_TRUE(v1->getEdges().empty());
+    EXPECT_EQ(vg.current()->getEdges().size(), 1u);
+
+    // nothing held: the replaced version is caught up and reused
+    v1.reset();
+    vg.delNode("B", 4);
+    vg.publish();
+    vg.updateNode("A", {{"k","v"}}, 5);
+    vg.publish();
+    EXPECT_EQ(vg.copyCount(), 1u);
+    EXPECT_EQ(vg.current()->getNodes().size(), 1u);
+    EXPECT_EQ(vg.current()->getNodes().at("A").attributes.at("k"), "v");
+    EXPECT_EQ(vg.writerGraph().getEventLog().size(), 6u);   // delNode cascaded to AB
+
+    vg.publish();   // nothing pending
+    EXPECT_EQ(vg.publishCount(), 4u);
+}
+
+TEST(VersionedGraph, RecycledVersionsKeepCheckpoints) {
+    VersionedGraph vg;
+    vg.setPublishInterval(700);
+    for (int i = 0; i < 12000; ++i) vg.addNode("n" + std::to_string(i % 50), {}, i);
+    vg.publish();
+    vg.addNode("last", {}, 12000);
+    vg.publish();
+    EXPECT_EQ(vg.copyCount(), 0u);
+    EXPECT_EQ(vg.current()->getCheckpoints().size(), 2u);
+    EXPECT_EQ(vg.writerGraph().getCheckpoints().size(), 2u);
+    EXPECT_EQ(vg.writerGraph().getNodes().size(), 51u);
+}
+
+TEST(VersionedGraph, WriterKeepsTheWalAcrossPublishes) {
+    const std::string path = (std::filesystem::temp_directory_path() /
+                              "chronograph_versioned.wal").string();
+    std::filesystem::remove(path);
+    auto wal = std::make_shared<WriteAheadLog>(path);
+    {
+        Graph initial;
+        initial.attachWal(wal);
+        initial.addNode("A", {}, 1);
+        VersionedGraph vg(std::move(initial));
+        EXPECT_FALSE(vg.current()->wal());
+        // every publish recycles the retired version, caught up by replay
+        for (int i = 0; i < 3; ++i) {
+            vg.addNode("n" + std::to_string(i), {}, 2 + i);
+            vg.publish();
+            EXPECT_EQ(vg.writerGraph().wal(), wal);
+            EXPECT_FALSE(vg.current()->wal());
+        }
+        EXPECT_EQ(vg.copyCount(), 0u);
+        EXPECT_EQ(vg.writerGraph().getEventLog().size(), 4u);
+    }
+    wal->sync();
+    EXPECT_EQ(Graph::recover(path).getEventLog().size(), 4u);
+    wal.reset();
+    std::filesystem::remove(path);
+}
+
+TEST(VersionedGraph, ConcurrentReadersDuringIngest) {
+    VersionedGraph vg;
+    constexpr int kNodes = 5000;
+    std::atomic<bool> done{false};
+    std::atomic<int> failures{0};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; ++r) {
+        readers.emplace_back([&] {
+            VersionedGraph::Reader reader(vg);
+            std::size_t last = 0;
+            while (!done.load()) {
+                const Graph& g = reader.get();
+                // a chain n0 - n1 - ... : one component, and versions only grow
+                const std::size_t n = g.getNodes().size();
+                if (n < last) ++failures;
+                if (n > 0 && graph::algorithms::weaklyConnectedComponents(g).size() != 1) ++failures;
+                last = n;
+            }
+        });
+    }
+    for (int i = 0; i < kNodes; ++i) {
+        vg.addNode("n" + std::to_string(i), {}, i);
+        if (i > 0) {
+            vg.addEdge("e" + std::to_string(i), "n" + std::to_string(i - 1),
+                       "n" + std::to_string(i), {}, i);
+        }
+        if (i % 100 == 99) vg.publish();
+    }
+    vg.publish();
+    done = true;
+    for (auto& t : readers) t.join();
+
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_EQ(vg.current()->getNodes().size(), static_cast<std::size_t>(kNodes));
+    EXPECT_EQ(vg.current()->getEdges().size(), static_cast<std::size_t>(kNodes - 1));
+}
@@ -0,0 +1,205 @@
+// tests/test_WriteAheadLog.cpp
+
+#include <chronograph/graph/Graph.h>
+#include <chronograph/graph/WriteAheadLog.h>
+#include <chronograph/repo/Repository.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace chronograph;
+namespace fs = std::filesystem;
+
+namespace {
+// fresh path in the temp directory, removed again at scope exit
+struct TempPath {
+    std::string path;
+    explicit TempPath(const std::string& name) {
+        auto seed = ::testing::UnitTest::GetInstance()->random_seed();
+        path = (fs::temp_directory_path() /
+                ("chronograph_" + name + "_" + std::to_string(seed) + ".wal")).string();
+        fs::remove(path);
+    }
+    ~TempPath() { fs::remove(path); }
+};
+}  // namespace
+
+TEST(WriteAheadLog, GraphRecoveryRebuildsStateAndCheckpoints) {
+    TempPath file("graph");
+    Graph original;
+    {
+        auto wal = std::make_shared<WriteAheadLog>(file.path, WalOptions{64, {}});
+        original.attachWal(wal);
+        for (int i = 0; i < 6000; ++i) {
+            original.addNode("n" + std::to_string(i), {{"i", std::to_string(i)}}, i);
+        }
+        original.addEdge("e", "n1", "n2", {{"w","1"}}, 6000);
+        original.updateNode("n1", {{"x","y"}}, 6001);
+        original.delNode("n2", 6002);
+
+        Graph copy = original;             // copies do not write to the WAL
+        copy.addNode("ghost", {}, 7000);
+        EXPECT_EQ(wal->recordCount(), original.getEventLog().size());
+        EXPECT_LT(wal->syncCount(), wal->recordCount());   // grouped
+        original.attachWal(nullptr);
+    }   // last reference gone: flushed and synced
+
+    Graph recovered = Graph::recover(file.path);
+    ASSERT_EQ(recovered.getEventLog().size(), original.getEventLog().size());
+    EXPECT_EQ(recovered.getEventLog().back().id, original.getEventLog().back().id);
+    EXPECT_EQ(recovered.getNodes().size(), original.getNodes().size());
+    EXPECT_FALSE(recovered.getNodes().count("ghost"));
+    EXPECT_EQ(recovered.getNodes().at("n1").attributes.at("x"), "y");
+    EXPECT_TRUE(recovered.getEdges().empty());
+    EXPECT_EQ(recovered.getCheckpoints().size(), original.getCheckpoints().size());
+}
+
+TEST(WriteAheadLog, TornTailIsCutOff) {
+    TempPath file("torn");
+    {
+        WriteAheadLog wal(file.path);
+        wal.appendEvent(Event{"a", 1, EventType::ADD_NODE, "A", {}, "", ""});
+        wal.appendEvent(Event{"b", 2, EventType::ADD_NODE, "B", {}, "", ""});
+    }
+    const auto fullSize = fs::file_size(file.path);
+    fs::resize_file(file.path, fullSize - 3);   // crash in the middle of "b"
+    {
+        auto read = WriteAheadLog::read(file.path);
+        EXPECT_TRUE(read.tornTail);
+        ASSERT_EQ(read.records.size(), 1u);
+    }
+    {
+        WriteAheadLog wal(file.path);                // truncates, then appends
+        wal.appendEvent(Event{"c", 3, EventType::ADD_NODE, "C", {}, "", ""});
+    }
+    Graph g = Graph::recover(file.path);
+    EXPECT_EQ(g.getNodes().size(), 2u);
+    EXPECT_TRUE(g.getNodes().count("A"));
+    EXPECT_TRUE(g.getNodes().count("C"));
+    EXPECT_FALSE(WriteAheadLog::read(file.path).tornTail);
+
+    // a flipped payload byte fails the checksum
+    {
+        std::fstream f(file.path, std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(-2, std::ios::end);
+        f.put('\x7f');
+    }
+    EXPECT_EQ(WriteAheadLog::read(file.path).records.size(), 1u);
+    {
+        WriteAheadLog wal(file.path);                // the scan stops at the bad record too
+        wal.appendEvent(Event{"d", 4, EventType::ADD_NODE, "D", {}, "", ""});
+    }
+    auto read = WriteAheadLog::read(file.path);
+    EXPECT_FALSE(read.tornTail);
+    ASSERT_EQ(read.records.size(), 2u);
+    EXPECT_EQ(read.validBytes, fs::file_size(file.path));
+}
+
+TEST(WriteAheadLog, IntervalSyncsWithoutFurtherAppends) {
+    TempPath file("interval");
+    WriteAheadLog wal(file.path, WalOptions{0, std::chrono::milliseconds(20)});
+    const auto synced = wal.syncCount();
+    wal.appendEvent(Event{"a", 1, EventType::ADD_NODE, "A", {}, "", ""});
+
+    // no append follows: the background flusher makes the record durable
+    for (int i = 0; i < 500 && wal.syncCount() == synced; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(wal.syncCount(), synced + 1);
+    EXPECT_EQ(WriteAheadLog::read(file.path).records.size(), 1u);
+
+    // and stays idle while nothing is pending
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(wal.syncCount(), synced + 1);
+}
+
+TEST(WriteAheadLog, RepositoryReopensWithHistoryAndStagedEvents) {
+    TempPath file("repo");
+    std::string c1, c2, merged;
+    {
+        auto repo = Repository::open(file.path, WalOptions{0, std::chrono::milliseconds(5)});
+        repo.addNode("A", {}, 1);
+        c1 = repo.commit("one");
+        repo.branch("dev");
+        repo.checkout("dev");
+        repo.addNode("B", {}, 2);
+        c2 = repo.commit("two");
+        repo.checkout("main");
+        repo.addNode("C", {}, 3);
+        repo.commit("three");
+        merged = repo.merge("dev").mergeCommitId;
+        repo.addNode("staged", {}, 4);   // durable, not committed
+    }
+
+    {
+        auto repo = Repository::open(file.path);
+        auto branches = repo.listBranches();
+        std::sort(branches.begin(), branches.end());
+        EXPECT_EQ(branches, (std::vector<std::string>{"dev","main"}));
+        auto commits = repo.listCommits("main");
+        ASSERT_EQ(commits.size(), 5u);
+        EXPECT_EQ(commits.back().id, merged);
+        EXPECT_EQ(commits[1].id, c1);
+        EXPECT_EQ(repo.listCommits("dev").back().id, c2);
+        for (auto id : {"A","B","C","staged"}) EXPECT_TRUE(repo.graph().getNodes().count(id)) << id;
+
+        // the recovered staged event commits on top of the same history
+        repo.commit("four");
+        EXPECT_EQ(repo.listCommits("main").back().parents.front(), merged);
+        repo.checkout("dev");
+    }
+    {
+        auto repo = Repository::open(file.path);
+        EXPECT_EQ(repo.graph().getNodes().size(), 2u);   // HEAD is dev
+        EXPECT_EQ(repo.listCommits("main").size(), 6u);
+        repo.branch("tmp");
+        repo.deleteBranch("tmp");
+    }
+    auto repo = Repository::open(file.path);
+    EXPECT_EQ(repo.listBranches().size(), 2u);           // deletion is durable
+}
+
+TEST(WriteAheadLog, RepositoryCompactionRewritesTheLog) {
+    TempPath file("compact");
+    std::string base;
+    std::uintmax_t before = 0;
+    {
+        auto repo = Repository::open(file.path);
+        for (int c = 0; c < 10; ++c) {
+            for (int i = 0; i < 20; ++i) {
+                repo.addNode("n" + std::to_string(c * 20 + i), {{"c", std::to_string(c)}}, c * 100 + i);
+            }
+            repo.commit("c" + std::to_string(c));
+        }
+        repo.branch("dev");
+        repo.addNode("staged", {}, 2000);
+        before = fs::file_size(file.path);
+        base = repo.compact(500);
+        ASSERT_FALSE(base.empty());
+        repo.addNode("after", {}, 2001);   // appended to the new log
+    }
+    EXPECT_LT(fs::file_size(file.path), before);
+
+    {
+        auto repo = Repository::open(file.path);
+        EXPECT_EQ(repo.graph().compactedEventCount(), 100u);
+        EXPECT_EQ(repo.graph().getNodes().size(), 202u);
+        EXPECT_EQ(repo.graphAt(base)->getNodes().size(), 100u);
+        auto commits = repo.listCommits("main");
+        ASSERT_EQ(commits.size(), 11u);
+        EXPECT_THROW(repo.graphAt(commits[2].id), std::runtime_error);
+        EXPECT_EQ(commits[2].eventCount, 20u);
+        EXPECT_EQ(commits[8].events.size(), 20u);
+        repo.commit("staged");
+        repo.checkout("dev");
+        EXPECT_EQ(repo.graph().getNodes().size(), 200u);
+    }
+    auto repo = Repository::open(file.path);
+    EXPECT_EQ(repo.graph().getNodes().size(), 200u);     // HEAD is dev
+    EXPECT_EQ(repo.listCommits("main").size(), 12u);
+    EXPECT_EQ(repo.compact(500), base);
+}